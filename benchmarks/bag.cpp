@@ -0,0 +1,22 @@
+#include <core/helper/random.hpp>
+
+#include "game/bag.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    void bag_generation(benchmark::State& state) {
+        Random random{ 42 };
+
+        for (auto _ : state) {
+            Bag bag{ random };
+            benchmark::DoNotOptimize(bag);
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<i64>(Bag::size()));
+    }
+
+} // namespace
+
+BENCHMARK(bag_generation)->Name("Bag/generation");
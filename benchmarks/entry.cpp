@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+int main(int argc, char** argv) {
+    // the simulation logs on info level, this would only disturb the measurements
+    spdlog::set_level(spdlog::level::warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
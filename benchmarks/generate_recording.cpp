@@ -0,0 +1,96 @@
+#include "recording_generator.hpp"
+
+#include <charconv>
+#include <fmt/format.h>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    constexpr std::string_view usage =
+            "usage: {} --output <file> [--records <count>] [--tetrions <count>] [--snapshot-interval <records>] "
+            "[--information-size <bytes>] [--seed <seed>]\n";
+
+    [[nodiscard]] std::optional<u64> parse_number(const std::string& value) {
+        u64 number = 0;
+        const auto [_, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+        if (error != std::errc{}) {
+            return std::nullopt;
+        }
+        return number;
+    }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+
+    const std::vector<std::string> arguments(argv, argv + argc); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    std::optional<std::filesystem::path> output = std::nullopt;
+    benchmarks::GeneratorOptions options{
+        .record_count = 100'000, .tetrion_count = 1, .snapshot_interval = 100, .information_size = 0, .seed = 42
+    };
+
+    for (usize i = 1; i < arguments.size(); ++i) {
+        const auto& argument = arguments.at(i);
+
+        if (i + 1 >= arguments.size()) {
+            std::cerr << fmt::format(usage, arguments.at(0));
+            return 1;
+        }
+        ++i;
+        const auto& value = arguments.at(i);
+
+        if (argument == "--output") {
+            output = value;
+            continue;
+        }
+
+        const auto number = parse_number(value);
+        if (not number.has_value()) {
+            std::cerr << "invalid value for " << argument << ": " << value << "\n";
+            return 1;
+        }
+
+        if (argument == "--records") {
+            options.record_count = number.value();
+        } else if (argument == "--tetrions") {
+            if (number.value() == 0 or number.value() > std::numeric_limits<u8>::max()) {
+                std::cerr << "the number of tetrions has to be between 1 and 255\n";
+                return 1;
+            }
+            options.tetrion_count = static_cast<u8>(number.value());
+        } else if (argument == "--snapshot-interval") {
+            options.snapshot_interval = number.value();
+        } else if (argument == "--information-size") {
+            options.information_size = static_cast<usize>(number.value());
+        } else if (argument == "--seed") {
+            options.seed = number.value();
+        } else {
+            std::cerr << "unknown argument: " << argument << "\n" << fmt::format(usage, arguments.at(0));
+            return 1;
+        }
+    }
+
+    if (not output.has_value()) {
+        std::cerr << fmt::format(usage, arguments.empty() ? "generate_recording" : arguments.at(0));
+        return 1;
+    }
+
+    const auto result = benchmarks::generate_recording(output.value(), options);
+    if (not result.has_value()) {
+        std::cerr << "unable to generate the recording: " << result.error() << "\n";
+        return 1;
+    }
+
+    std::cout << fmt::format(
+            "wrote {} records and {} snapshots to \"{}\" ({:.2f} MB)\n", result->record_count, result->snapshot_count,
+            output->string(), static_cast<double>(result->file_size) / 1'000'000.0
+    );
+
+    return 0;
+}
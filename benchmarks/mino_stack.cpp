@@ -0,0 +1,85 @@
+#include <core/game/grid_properties.hpp>
+#include <core/game/mino_stack.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+    using GridPoint = Mino::GridPoint;
+
+    constexpr i64 cells_per_board = static_cast<i64>(grid::width_in_tiles) * static_cast<i64>(grid::height_in_tiles);
+
+    [[nodiscard]] helper::TetrominoType type_for(u8 column, u8 row) {
+        return static_cast<helper::TetrominoType>(
+                (column + row) % (static_cast<int>(helper::TetrominoType::LastType) + 1)
+        );
+    }
+
+    // every row is filled, except one column, that differs from row to row
+    [[nodiscard]] MinoStack dense_board() {
+        MinoStack mino_stack{};
+        for (u8 row = 0; row < grid::height_in_tiles; ++row) {
+            for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                if (column != (row * 3) % grid::width_in_tiles) {
+                    mino_stack.set(GridPoint{ column, row }, type_for(column, row));
+                }
+            }
+        }
+        return mino_stack;
+    }
+
+    void set_full_board(benchmark::State& state) {
+        for (auto _ : state) {
+            MinoStack mino_stack{};
+            for (u8 row = 0; row < grid::height_in_tiles; ++row) {
+                for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                    mino_stack.set(GridPoint{ column, row }, type_for(column, row));
+                }
+            }
+            benchmark::DoNotOptimize(mino_stack);
+        }
+
+        state.SetItemsProcessed(state.iterations() * cells_per_board);
+    }
+
+    void is_empty_dense_board(benchmark::State& state) {
+        const auto mino_stack = dense_board();
+
+        u32 empty_cells = 0;
+        for (auto _ : state) {
+            for (u8 row = 0; row < grid::height_in_tiles; ++row) {
+                for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                    if (mino_stack.is_empty(GridPoint{ column, row })) {
+                        ++empty_cells;
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(empty_cells);
+
+        state.SetItemsProcessed(state.iterations() * cells_per_board);
+    }
+
+    void clear_row_dense_board(benchmark::State& state) {
+        const auto prototype = dense_board();
+        constexpr u8 rows_to_clear = 4;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto mino_stack = prototype;
+            state.ResumeTiming();
+
+            for (u8 row = 0; row < rows_to_clear; ++row) {
+                mino_stack.clear_row_and_let_sink(grid::height_in_tiles - 1);
+            }
+            benchmark::DoNotOptimize(mino_stack);
+        }
+
+        state.SetItemsProcessed(state.iterations() * rows_to_clear);
+    }
+
+} // namespace
+
+BENCHMARK(set_full_board)->Name("MinoStack/set/full_board");
+BENCHMARK(is_empty_dense_board)->Name("MinoStack/is_empty/dense_board");
+BENCHMARK(clear_row_dense_board)->Name("MinoStack/clear_row_and_let_sink/dense_board");
@@ -0,0 +1,137 @@
+#include <core/game/grid_properties.hpp>
+#include <recordings/recordings.hpp>
+
+#include "recording_generator.hpp"
+
+#include <fmt/format.h>
+#include <limits>
+#include <memory>
+
+namespace {
+
+    // every key holds a string of this size, so that the size can be controlled, without producing one huge value
+    constexpr usize information_value_size = 64;
+
+    // the pressed events come first in InputEvent, followed by the released events in the same order
+    constexpr u8 pressed_event_count = static_cast<u8>(InputEvent::RotateLeftReleased);
+
+    [[nodiscard]] recorder::AdditionalInformation synthetic_information(usize size, Random& random) {
+        recorder::AdditionalInformation information{};
+        information.add<std::string>("mode", "synthetic");
+
+        for (usize i = 0; i * information_value_size < size; ++i) {
+            std::string value(information_value_size, ' ');
+            for (auto& character : value) {
+                character = static_cast<char>('a' + random.random<u32>(26));
+            }
+            information.add(fmt::format("value_{}", i), value);
+        }
+
+        return information;
+    }
+
+    // the lower part of the board is filled, with a few random holes, similar to a game in progress
+    [[nodiscard]] MinoStack synthetic_mino_stack(Random& random) {
+        MinoStack mino_stack{};
+
+        const auto filled_rows = static_cast<u8>(random.random<u32>(grid::height_in_tiles / 2));
+        for (u8 row = grid::height_in_tiles - filled_rows; row < grid::height_in_tiles; ++row) {
+            for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                if (random.random<u32>(4) != 0) {
+                    mino_stack.set(
+                            Mino::GridPoint{ column, row },
+                            static_cast<helper::TetrominoType>(
+                                    random.random<u32>(static_cast<u32>(helper::TetrominoType::LastType) + 1)
+                            )
+                    );
+                }
+            }
+        }
+
+        return mino_stack;
+    }
+
+} // namespace
+
+
+[[nodiscard]] helper::expected<benchmarks::GeneratorResult, std::string>
+benchmarks::generate_recording(const std::filesystem::path& path, const GeneratorOptions& options) {
+
+    if (options.tetrion_count == 0) {
+        return helper::unexpected<std::string>{ "at least one tetrion is needed" };
+    }
+
+    Random random{ options.seed };
+
+    std::vector<recorder::TetrionHeader> headers{};
+    headers.reserve(options.tetrion_count);
+    for (u8 i = 0; i < options.tetrion_count; ++i) {
+        headers.emplace_back(random.random<Random::Seed>(std::numeric_limits<Random::Seed>::max()), 0);
+    }
+
+    u64 snapshot_count = 0;
+
+    {
+        auto writer_result = recorder::RecordingWriter::get_writer(
+                path, std::move(headers), synthetic_information(options.information_size, random)
+        );
+        if (not writer_result.has_value()) {
+            return helper::unexpected<std::string>{ writer_result.error() };
+        }
+
+        auto writer = std::move(writer_result.value());
+
+        u64 simulation_step_index = 0;
+        u8 tetrion_index = 0;
+        auto event = InputEvent::RotateLeftPressed;
+
+        for (u64 record = 0; record < options.record_count; ++record) {
+
+            // every key is pressed and released again, like in a real game
+            if (record % 2 == 0) {
+                simulation_step_index += random.random<u64>(20);
+                tetrion_index = static_cast<u8>(random.random<u32>(options.tetrion_count));
+                event = static_cast<InputEvent>(random.random<u32>(pressed_event_count));
+            } else {
+                simulation_step_index += 1 + random.random<u64>(10);
+                event = static_cast<InputEvent>(static_cast<u8>(event) + pressed_event_count);
+            }
+
+            auto result = writer.add_record(tetrion_index, simulation_step_index, event);
+            if (not result.has_value()) {
+                return helper::unexpected<std::string>{ result.error() };
+            }
+
+            if (options.snapshot_interval == 0 or (record + 1) % options.snapshot_interval != 0) {
+                continue;
+            }
+
+            for (u8 i = 0; i < options.tetrion_count; ++i) {
+                result = writer.add_snapshot(
+                        simulation_step_index,
+                        std::make_unique<TetrionCoreInformation>(
+                                i, random.random<u32>(30), random.random<u64>(1'000'000), random.random<u32>(300),
+                                synthetic_mino_stack(random)
+                        )
+                );
+                if (not result.has_value()) {
+                    return helper::unexpected<std::string>{ result.error() };
+                }
+                ++snapshot_count;
+            }
+        }
+        // the writer has to be destroyed here, so that everything is flushed, before the file size is read
+    }
+
+    std::error_code error_code{};
+    const auto file_size = std::filesystem::file_size(path, error_code);
+    if (error_code) {
+        return helper::unexpected<std::string>{
+            fmt::format("unable to get the size of \"{}\": {}", path.string(), error_code.message())
+        };
+    }
+
+    return GeneratorResult{ .file_size = file_size,
+                            .record_count = options.record_count,
+                            .snapshot_count = snapshot_count };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/random.hpp>
+#include <core/helper/types.hpp>
+
+#include <filesystem>
+#include <string>
+
+namespace benchmarks {
+
+    struct GeneratorOptions {
+        // the number of input records, over all tetrions
+        u64 record_count;
+        u8 tetrion_count;
+        // a snapshot of every tetrion is written after this many records, 0 disables snapshots
+        u64 snapshot_interval;
+        // the approximate size of the additional information in bytes
+        usize information_size;
+        Random::Seed seed;
+    };
+
+    struct GeneratorResult {
+        u64 file_size;
+        u64 record_count;
+        u64 snapshot_count;
+    };
+
+    // writes a synthetic recording through the RecordingWriter, the content is deterministic for the same options, but not a playable game
+    [[nodiscard]] helper::expected<GeneratorResult, std::string>
+    generate_recording(const std::filesystem::path& path, const GeneratorOptions& options);
+
+} // namespace benchmarks
@@ -0,0 +1,233 @@
+#include <core/game/grid_properties.hpp>
+#include <recordings/recordings.hpp>
+
+#include "recording_generator.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+    struct Fixture {
+        std::string_view name;
+        benchmarks::GeneratorOptions options;
+        // the JSON representation needs a multiple of the file size in memory, so it is skipped for very large files
+        bool dump_json;
+    };
+
+    // roughly the sizes of recordings, that we actually see: a single player game, a long multiplayer game and a very large file
+    constexpr std::array fixtures{
+        Fixture{ .name = "single_player",
+                .options = { .record_count = 5'000,
+                             .tetrion_count = 1,
+                             .snapshot_interval = 100,
+                             .information_size = 256,
+                             .seed = 42 },
+                .dump_json = true },
+        Fixture{ .name = "multiplayer",
+                .options = { .record_count = 200'000,
+                             .tetrion_count = 4,
+                             .snapshot_interval = 100,
+                             .information_size = 4'096,
+                             .seed = 43 },
+                .dump_json = true },
+        Fixture{ .name = "large",
+                .options = { .record_count = 5'000'000,
+                             .tetrion_count = 2,
+                             .snapshot_interval = 1'000,
+                             .information_size = 65'536,
+                             .seed = 44 },
+                .dump_json = false },
+    };
+
+    // the recordings are generated once, on first use, and deleted again, when the benchmarks exit
+    struct GeneratedRecordings {
+    private:
+        std::filesystem::path m_directory;
+        std::map<std::string_view, std::pair<std::filesystem::path, benchmarks::GeneratorResult>> m_recordings;
+
+    public:
+        GeneratedRecordings() : m_directory{ std::filesystem::temp_directory_path() / "oopetris_benchmarks" } {
+            std::filesystem::create_directories(m_directory);
+        }
+
+        GeneratedRecordings(const GeneratedRecordings&) = delete;
+        GeneratedRecordings(GeneratedRecordings&&) = delete;
+        GeneratedRecordings& operator=(const GeneratedRecordings&) = delete;
+        GeneratedRecordings& operator=(GeneratedRecordings&&) = delete;
+
+        ~GeneratedRecordings() {
+            std::error_code error_code{};
+            std::filesystem::remove_all(m_directory, error_code);
+        }
+
+        [[nodiscard]] const std::pair<std::filesystem::path, benchmarks::GeneratorResult>& get(const Fixture& fixture) {
+            if (const auto recording = m_recordings.find(fixture.name); recording != m_recordings.end()) {
+                return recording->second;
+            }
+
+            auto path = m_directory / fmt::format("{}.rec", fixture.name);
+            const auto result = benchmarks::generate_recording(path, fixture.options);
+            if (not result.has_value()) {
+                std::cerr << "unable to generate recording " << fixture.name << ": " << result.error() << "\n";
+                std::exit(1); //NOLINT(concurrency-mt-unsafe)
+            }
+
+            return m_recordings.emplace(fixture.name, std::make_pair(std::move(path), result.value())).first->second;
+        }
+    };
+
+    [[nodiscard]] GeneratedRecordings& generated_recordings() {
+        static GeneratedRecordings recordings{};
+        return recordings;
+    }
+
+    // generating happens before the measured loop, so that the first measured run isn't slowed down by it
+    [[nodiscard]] const std::pair<std::filesystem::path, benchmarks::GeneratorResult>&
+    recording_for(const Fixture& fixture) {
+        return generated_recordings().get(fixture);
+    }
+
+    [[nodiscard]] recorder::RecordingReader read_recording(const std::filesystem::path& path) {
+        auto result = recorder::RecordingReader::from_path(path);
+        if (not result.has_value()) {
+            std::cerr << "unable to read recording " << path << ": " << result.error() << "\n";
+            std::exit(1); //NOLINT(concurrency-mt-unsafe)
+        }
+        return std::move(result.value());
+    }
+
+    void from_path(benchmark::State& state, const Fixture& fixture) {
+        const auto& [path, generated] = recording_for(fixture);
+
+        for (auto _ : state) {
+            const auto reader = read_recording(path);
+            benchmark::DoNotOptimize(reader.num_records());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<i64>(generated.record_count));
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(generated.file_size));
+    }
+
+    void is_header_valid(benchmark::State& state, const Fixture& fixture) {
+        const auto& [path, generated] = recording_for(fixture);
+
+        for (auto _ : state) {
+            const auto result = recorder::RecordingReader::is_header_valid(path);
+            benchmark::DoNotOptimize(result.has_value());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // this includes generating the synthetic content, which is cheap compared to the file output
+    void write(benchmark::State& state, const Fixture& fixture) {
+        const auto& [path, generated] = recording_for(fixture);
+        const auto output_path = std::filesystem::path{ path }.replace_extension("written.rec");
+
+        for (auto _ : state) {
+            const auto result = benchmarks::generate_recording(output_path, fixture.options);
+            benchmark::DoNotOptimize(result.has_value());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<i64>(generated.record_count));
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(generated.file_size));
+    }
+
+    void json_dump(benchmark::State& state, const Fixture& fixture) {
+        const auto& [path, generated] = recording_for(fixture);
+
+        const auto reader = read_recording(path);
+
+        i64 bytes = 0;
+        for (auto _ : state) {
+            const auto json_value = json::try_convert_to_json<recorder::RecordingReader>(reader);
+            if (not json_value.has_value()) {
+                std::cerr << "unable to convert recording to json: " << json_value.error() << "\n";
+                std::exit(1); //NOLINT(concurrency-mt-unsafe)
+            }
+            bytes += static_cast<i64>(json_value->dump().size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<i64>(generated.record_count));
+        state.SetBytesProcessed(bytes);
+    }
+
+    // the lower half of the board is filled, except one column per row
+    [[nodiscard]] TetrionSnapshot dense_snapshot() {
+        MinoStack mino_stack{};
+        for (u8 row = grid::height_in_tiles / 2; row < grid::height_in_tiles; ++row) {
+            for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                if (column != row % grid::width_in_tiles) {
+                    mino_stack.set(Mino::GridPoint{ column, row }, helper::TetrominoType::L);
+                }
+            }
+        }
+
+        return TetrionSnapshot{ 0, 10, 123'456, 100, 10'000, std::move(mino_stack) };
+    }
+
+    void snapshot_to_bytes(benchmark::State& state) {
+        const auto snapshot = dense_snapshot();
+
+        i64 bytes = 0;
+        for (auto _ : state) {
+            const auto result = snapshot.to_bytes();
+            bytes += static_cast<i64>(result.size());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(bytes);
+    }
+
+    void snapshot_from_istream(benchmark::State& state) {
+        const auto bytes = dense_snapshot().to_bytes();
+        const std::string content{ bytes.begin(), bytes.end() };
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::istringstream stream{ content };
+            state.ResumeTiming();
+
+            const auto result = TetrionSnapshot::from_istream(stream);
+            benchmark::DoNotOptimize(result.has_value());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(content.size()));
+    }
+
+    [[maybe_unused]] const bool registered = [] {
+        for (const auto& fixture : fixtures) {
+            benchmark::RegisterBenchmark(
+                    fmt::format("RecordingReader/from_path/{}", fixture.name).c_str(),
+                    [&fixture](benchmark::State& state) { from_path(state, fixture); }
+            );
+            benchmark::RegisterBenchmark(
+                    fmt::format("RecordingReader/is_header_valid/{}", fixture.name).c_str(),
+                    [&fixture](benchmark::State& state) { is_header_valid(state, fixture); }
+            );
+            benchmark::RegisterBenchmark(
+                    fmt::format("RecordingWriter/write/{}", fixture.name).c_str(),
+                    [&fixture](benchmark::State& state) { write(state, fixture); }
+            );
+            if (fixture.dump_json) {
+                benchmark::RegisterBenchmark(
+                        fmt::format("RecordingReader/json_dump/{}", fixture.name).c_str(),
+                        [&fixture](benchmark::State& state) { json_dump(state, fixture); }
+                );
+            }
+        }
+
+        return true;
+    }();
+
+} // namespace
+
+BENCHMARK(snapshot_to_bytes)->Name("TetrionSnapshot/to_bytes/dense_board");
+BENCHMARK(snapshot_from_istream)->Name("TetrionSnapshot/from_istream/dense_board");
@@ -0,0 +1,122 @@
+#include <core/game/grid_properties.hpp>
+
+#include "game/simulated_tetrion.hpp"
+#include "game/simulation.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fmt/format.h>
+#include <memory>
+
+namespace {
+
+    constexpr Random::Seed seed = 42;
+
+    [[nodiscard]] std::unique_ptr<SimulatedTetrion> started_tetrion() {
+        auto tetrion = std::make_unique<SimulatedTetrion>(0, seed, 0, nullptr, std::nullopt);
+        tetrion->spawn_next_tetromino(0);
+        return tetrion;
+    }
+
+    // a tetrion, whose playing field is filled with a synthetic board, the bottom rows are fully occupied and the rows above them have one gap each
+    struct DenseBoardTetrion : public SimulatedTetrion {
+        static constexpr u8 full_rows = 4;
+        static constexpr u8 rows_with_gap = 8;
+
+        DenseBoardTetrion() : SimulatedTetrion{ 0, seed, 0, nullptr, std::nullopt } {
+            for (u8 row = grid::height_in_tiles - full_rows - rows_with_gap; row < grid::height_in_tiles; ++row) {
+                const bool is_full = row >= grid::height_in_tiles - full_rows;
+                for (u8 column = 0; column < grid::width_in_tiles; ++column) {
+                    if (is_full or column != (row * 3) % grid::width_in_tiles) {
+                        m_mino_stack.set(Mino::GridPoint{ column, row }, helper::TetrominoType::T);
+                    }
+                }
+            }
+
+            spawn_next_tetromino(helper::TetrominoType::O, 0);
+        }
+    };
+
+    void update_step(benchmark::State& state) {
+        auto tetrion = started_tetrion();
+        SimulationStep step = 0;
+
+        for (auto _ : state) {
+            if (tetrion->is_game_over()) {
+                state.PauseTiming();
+                tetrion = started_tetrion();
+                step = 0;
+                state.ResumeTiming();
+            }
+
+            ++step;
+            tetrion->update_step(step);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void handle_input_command(benchmark::State& state) {
+        auto tetrion = started_tetrion();
+
+        // none of these commands lock the tetromino, so the tetrion stays in the same state
+        constexpr std::array commands{ input::GameInputCommand::MoveLeft, input::GameInputCommand::RotateRight,
+                                       input::GameInputCommand::MoveRight, input::GameInputCommand::RotateLeft };
+
+        usize index = 0;
+        for (auto _ : state) {
+            auto result = tetrion->handle_input_command(commands.at(index % commands.size()), 1);
+            benchmark::DoNotOptimize(result);
+            ++index;
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // clear_fully_occupied_lines is private, so this drops a tetromino onto the dense board, which locks it and clears the full rows
+    void clear_lines_dense_board(benchmark::State& state) {
+        const DenseBoardTetrion prototype{};
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto tetrion = prototype;
+            state.ResumeTiming();
+
+            tetrion.drop_tetromino(1);
+            benchmark::DoNotOptimize(tetrion.lines_cleared());
+        }
+
+        state.SetItemsProcessed(state.iterations() * DenseBoardTetrion::full_rows);
+    }
+
+    void replay_recording(benchmark::State& state) {
+        std::filesystem::path path = "./test_rec_valid.rec";
+
+        i64 simulated_steps = 0;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto maybe_simulation = Simulation::get_replay_simulation(path);
+            if (not maybe_simulation.has_value()) {
+                state.SkipWithError(fmt::format("unable to load recording: {}", maybe_simulation.error()).c_str());
+                break;
+            }
+            auto simulation = std::move(maybe_simulation.value());
+            state.ResumeTiming();
+
+            while (not simulation.is_game_finished()) {
+                simulation.update();
+                ++simulated_steps;
+            }
+        }
+
+        state.SetItemsProcessed(simulated_steps);
+    }
+
+} // namespace
+
+BENCHMARK(update_step)->Name("SimulatedTetrion/update_step");
+BENCHMARK(handle_input_command)->Name("SimulatedTetrion/handle_input_command");
+BENCHMARK(clear_lines_dense_board)->Name("SimulatedTetrion/clear_fully_occupied_lines/dense_board");
+BENCHMARK(replay_recording)->Name("Simulation/replay/test_rec_valid");
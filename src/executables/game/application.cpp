@@ -1,12 +1,17 @@
 #include <core/helper/errors.hpp>
 #include <core/helper/magic_enum_wrapper.hpp>
-#include <core/helper/sleep.hpp>
+#include <core/helper/metrics.hpp>
 
 #include "application.hpp"
+#include "helper/asset_archive.hpp"
+#include "helper/frame_pacer.hpp"
 #include "helper/graphic_utils.hpp"
 #include "helper/message_box.hpp"
+#include "helper/profiler.hpp"
+#include "helper/startup_timer.hpp"
 #include "input/input.hpp"
 #include "manager/music_manager.hpp"
+#include "manager/resource_loader.hpp"
 #include "scenes/loading_screen/loading_screen.hpp"
 #include "scenes/scene.hpp"
 #include "ui/layout.hpp"
@@ -14,6 +19,7 @@
 #include <chrono>
 #include <fmt/chrono.h>
 #include <future>
+#include <iostream>
 #include <memory>
 #include <ranges>
 #include <stdexcept>
@@ -40,9 +46,27 @@ namespace {
 Application::Application(std::shared_ptr<Window>&& window, CommandLineArguments&& arguments) try
     : m_command_line_arguments{ std::move(arguments) },
       m_window{ std::move(window) },
-      m_renderer{ *m_window, m_command_line_arguments.target_fps.has_value() ? Renderer::VSync::Disabled
-                                                                             : Renderer::VSync::Enabled },
+      m_renderer{ *m_window,
+                  m_command_line_arguments.target_fps.has_value() ? Renderer::VSync::Disabled
+                                                                  : Renderer::VSync::Enabled,
+                  m_command_line_arguments.batch_rendering ? Renderer::Batching::Enabled
+                                                           : Renderer::Batching::Disabled },
       m_target_framerate{ m_command_line_arguments.target_fps } {
+    if (m_command_line_arguments.profile) {
+        helper::profiler::enable(utils::get_root_folder() / "logs" / "profile_trace.json");
+    }
+
+    if (m_command_line_arguments.metrics_path.has_value()) {
+        metrics::install_dump_signal_handler();
+    }
+
+    helper::assets::initialize();
+
+    // before initialize(), since the input thread has to be started before the joystick subsystem is initialized
+    if (m_command_line_arguments.input_thread) {
+        m_event_dispatcher.start_input_thread();
+    }
+
     initialize();
 } catch (const helper::GeneralError& general_error) {
     const auto severity = general_error.severity();
@@ -66,12 +90,12 @@ void Application::run() {
     const auto count_per_s = static_cast<double>(SDL_GetPerformanceFrequency());
     u64 frame_counter = 0;
 #endif
-    using namespace std::chrono_literals;
 
-    const auto sleep_time = m_target_framerate.has_value() ? std::chrono::duration_cast<std::chrono::nanoseconds>(1s)
-                                                                     / m_target_framerate.value()
-                                                           : 0s;
-    auto start_execution_time = std::chrono::steady_clock::now();
+    auto frame_pacer = helper::FramePacer{ m_target_framerate };
+
+    auto overlay_update_time = helper::profiler::Clock::now();
+
+    bool is_first_frame = true;
 
     while (m_is_running
 
@@ -81,10 +105,48 @@ void Application::run() {
 
     ) {
 
-        m_event_dispatcher.dispatch_pending_events();
-        update();
-        render();
-        m_renderer.present();
+        {
+            const helper::profiler::Zone zone{ "EventDispatcher::dispatch_pending_events" };
+            m_input_manager->clear_pointer_event_cache();
+            m_event_dispatcher.dispatch_pending_events();
+        }
+
+        {
+            const helper::profiler::Zone zone{ "Application::update" };
+            update();
+        }
+
+        {
+            const helper::profiler::Zone zone{ "Application::render" };
+            render();
+        }
+
+        {
+            const helper::profiler::Zone zone{ "Renderer::present" };
+            m_renderer.present();
+        }
+
+        helper::profiler::end_frame();
+
+        if (is_first_frame) {
+            is_first_frame = false;
+            helper::startup::mark_first_frame();
+
+            if (m_command_line_arguments.startup_benchmark) {
+                std::cout << helper::startup::report();
+                m_is_running = false;
+            }
+        }
+
+        if (not m_profiler_overlay.empty()
+            and helper::profiler::Clock::now() - overlay_update_time >= std::chrono::milliseconds{ 500 }) {
+            update_profiler_overlay();
+            overlay_update_time = helper::profiler::Clock::now();
+        }
+
+        if (metrics::take_dump_request()) {
+            write_metrics();
+        }
 
 #if !defined(NDEBUG)
         ++frame_counter;
@@ -93,25 +155,33 @@ void Application::run() {
 
         if (current_time - start_time >= update_time) {
             const double elapsed = static_cast<double>(current_time - start_time) / count_per_s;
-            m_fps_text->set_text(*this, fmt::format("FPS: {:.2f}", static_cast<double>(frame_counter) / elapsed));
+            const auto jitter = std::chrono::duration<double, std::milli>(frame_pacer.statistics().jitter);
+            m_fps_text->set_text(
+                    *this, fmt::format(
+                                   "FPS: {:.2f} jitter: {:.2f} ms", static_cast<double>(frame_counter) / elapsed,
+                                   jitter.count()
+                           )
+            );
             start_time = current_time;
             frame_counter = 0;
+            frame_pacer.reset_statistics();
         }
 #endif
 
-        if (m_target_framerate.has_value()) {
-
-            const auto now = std::chrono::steady_clock::now();
-            const auto runtime = (now - start_execution_time);
-            if (runtime < sleep_time) {
-                //TODO(totto): use SDL_DelayNS in sdl >= 3.0
-                helper::sleep_nanoseconds(sleep_time - runtime);
-                start_execution_time = std::chrono::steady_clock::now();
-            } else {
-                start_execution_time = now;
-            }
-        }
+        frame_pacer.wait_for_next_frame();
     }
+
+    const auto statistics = frame_pacer.statistics();
+    spdlog::info(
+            "frame pacing over the last {} frames: average frame time {}, jitter {}, max deviation {}, sleep "
+            "overshoot {}",
+            statistics.frame_count, statistics.average_frame_time, statistics.jitter, statistics.max_deviation,
+            statistics.sleep_overshoot
+    );
+
+    helper::profiler::write_trace();
+
+    write_metrics();
 }
 
 void Application::handle_event(const SDL_Event& event) {
@@ -126,6 +196,9 @@ void Application::handle_event(const SDL_Event& event) {
 
     auto handled = false;
 
+    // converted once, the scenes get the cached result, when they ask for it again
+    const auto pointer_event = m_input_manager->get_pointer_event(event);
+
     for (const auto& scene : std::ranges::views::reverse(m_scene_stack)) {
         if (not handled and scene->handle_event(m_input_manager, event)) {
             handled = true;
@@ -138,10 +211,8 @@ void Application::handle_event(const SDL_Event& event) {
         }
 
         // if the scene is not covering the whole screen, it should give scenes in the background mouse events, but keyboard events are still only captured by the scene in focus, we also detect unhovers for whole scenes here
-        if (const auto result = m_input_manager->get_pointer_event(event); result.has_value()) {
-            if (not result->is_in(scene->get_layout().get_rect())) {
-                scene->on_unhover();
-            }
+        if (pointer_event.has_value() and not pointer_event->is_in(scene->get_layout().get_rect())) {
+            scene->on_unhover();
         }
     }
 
@@ -178,7 +249,11 @@ void Application::update() {
     for (usize i = 0; i < num_scenes; ++i) {
         const auto index = num_scenes - i - 1;
         try {
-            auto [scene_update, scene_change] = m_scene_stack.at(index)->update();
+            auto [scene_update, scene_change] = [this, index]() {
+                auto& scene = *m_scene_stack.at(index);
+                const helper::profiler::Zone zone{ typeid(scene), "::update" };
+                return scene.update();
+            }();
 
             if (scene_change) {
 
@@ -249,11 +324,17 @@ void Application::update() {
 void Application::render() const {
     renderer().clear();
     for (const auto& scene : m_scene_stack) {
+        const auto& current_scene = *scene;
+        const helper::profiler::Zone zone{ typeid(current_scene), "::render" };
         scene->render(*this);
     }
 #if !defined(NDEBUG)
     m_fps_text->render(*this);
 #endif
+
+    for (const auto& line : m_profiler_overlay) {
+        line->render(*this);
+    }
 }
 
 void Application::initialize() {
@@ -263,15 +344,38 @@ void Application::initialize() {
     const auto start_time = SDL_GetTicks64();
 
     const std::future<void> load_everything = std::async(std::launch::async, [this] {
-        this->m_music_manager = std::make_unique<MusicManager>(this, num_audio_channels);
+        const helper::startup::Phase phase{ "resource loading" };
 
-        this->m_input_manager = std::make_shared<input::InputManager>(this->m_window);
+        // the managers don't depend on each other, so they are loaded in parallel
+        ResourceLoader loader{ max_loading_threads };
 
-        this->m_settings_manager = std::make_unique<SettingsManager>(this);
-
-        this->m_font_manager = std::make_unique<FontManager>();
+        // SDL subsystems must not be initialized concurrently, so audio and input are one task
+        loader.add("audio and input", [this] {
+            {
+                const helper::startup::Phase phase{ "MusicManager" };
+                this->m_music_manager = std::make_unique<MusicManager>(this, num_audio_channels);
+            }
 
-        this->load_resources();
+            const helper::startup::Phase phase{ "InputManager" };
+            this->m_input_manager = std::make_shared<input::InputManager>(this->m_window);
+        });
+
+        loader.add("settings", [this] {
+            const helper::startup::Phase phase{ "SettingsManager" };
+            this->m_settings_manager = std::make_unique<SettingsManager>(this);
+        });
+
+        loader.add("fonts", [this] {
+            const helper::startup::Phase phase{ "FontManager" };
+            this->m_font_manager = std::make_unique<FontManager>();
+            this->load_resources();
+        });
+
+        for (const auto& [name, duration] : loader.run()) {
+            spdlog::debug(
+                    "loading {} took {}", name, std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            );
+        }
 
 #if !defined(NDEBUG)
         m_fps_text = std::make_unique<ui::Label>(
@@ -282,6 +386,20 @@ void Application::initialize() {
         );
 #endif
 
+        if (helper::profiler::is_enabled()) {
+            constexpr auto line_height = 0.025;
+            for (usize i = 0; i < profiler_overlay_lines; ++i) {
+                m_profiler_overlay.push_back(std::make_unique<ui::Label>(
+                        this, " ", font_manager().get(FontId::Default), Color::white(),
+                        std::pair<double, double>{ 1.0, 0.9 },
+                        ui::Alignment{ ui::AlignmentHorizontal::Left, ui::AlignmentVertical::Center },
+                        ui::RelativeLayout{ window(), 0.01, 0.06 + (static_cast<double>(i) * line_height), 0.5,
+                                            line_height },
+                        false
+                ));
+            }
+        }
+
 #if defined(_HAVE_DISCORD_SDK)
         if (m_settings_manager->settings().discord) {
             auto discord_instance = DiscordInstance::initialize();
@@ -299,12 +417,7 @@ void Application::initialize() {
     });
 
 
-    using namespace std::chrono_literals;
-
-    const auto sleep_time = m_target_framerate.has_value() ? std::chrono::duration_cast<std::chrono::nanoseconds>(1s)
-                                                                     / m_target_framerate.value()
-                                                           : 0s;
-    auto start_execution_time = std::chrono::steady_clock::now();
+    auto frame_pacer = helper::FramePacer{ m_target_framerate };
 
     bool finished_loading = false;
 
@@ -346,18 +459,7 @@ void Application::initialize() {
         // present and  wait (depending if vsync is on or not, this has to be done manually)
         m_renderer.present();
 
-        if (m_target_framerate.has_value()) {
-
-            const auto now = std::chrono::steady_clock::now();
-            const auto runtime = (now - start_execution_time);
-            if (runtime < sleep_time) {
-                //TODO(totto): use SDL_DelayNS in sdl >= 3.0
-                helper::sleep_nanoseconds(sleep_time - runtime);
-                start_execution_time = std::chrono::steady_clock::now();
-            } else {
-                start_execution_time = now;
-            }
-        }
+        frame_pacer.wait_for_next_frame();
         // end waiting
 
         // wait until is faster, since it just compares two time_points instead of getting now() and than adding the wait-for argument
@@ -381,25 +483,68 @@ void Application::initialize() {
 
     spdlog::debug("Took {} to load", duration);
 
+    const helper::startup::Phase phase{ "main menu creation" };
+
     push_scene(scenes::create_scene(*this, SceneId::MainMenu, ui::FullScreenLayout{ *m_window }));
 }
 
 void Application::load_resources() {
     constexpr auto fonts_size = 128;
-    const std::vector<std::tuple<FontId, std::string>> fonts{
+
+    // only the default font is needed for the main menu, the others are large and only used by a few scenes, so they are loaded on first use
+    const std::vector<std::tuple<FontId, std::string, bool>> fonts{
 #if defined(__3DS__)
         //TODO(Totto): debug why the other font crashed, not on loading, but on trying to render text!
-        {        FontId::Default, "LeroyLetteringLightBeta01.ttf" },
+        {        FontId::Default, "LeroyLetteringLightBeta01.ttf", false },
 #else
-        { FontId::Default, "PressStart2P.ttf" },
+        {        FontId::Default,              "PressStart2P.ttf", false },
 #endif
-        {          FontId::Arial,                     "arial.ttf" },
-        { FontId::NotoColorEmoji,            "NotoColorEmoji.ttf" },
-        {        FontId::Symbola,                   "Symbola.ttf" }
+        {          FontId::Arial,                     "arial.ttf",  true },
+        { FontId::NotoColorEmoji,            "NotoColorEmoji.ttf",  true },
+        {        FontId::Symbola,                   "Symbola.ttf",  true }
     };
-    for (const auto& [font_id, path] : fonts) {
+    for (const auto& [font_id, path, is_lazy] : fonts) {
         const auto font_path = utils::get_assets_folder() / "fonts" / path;
-        m_font_manager->load(font_id, font_path, fonts_size);
+        if (is_lazy) {
+            m_font_manager->load_lazily(font_id, font_path, fonts_size);
+        } else {
+            m_font_manager->load(font_id, font_path, fonts_size);
+        }
+    }
+}
+
+void Application::write_metrics() const {
+    if (not m_command_line_arguments.metrics_path.has_value()) {
+        return;
+    }
+
+    const auto result = metrics::Registry::global().write_to_file(m_command_line_arguments.metrics_path.value());
+    if (not result.has_value()) {
+        spdlog::error("unable to write metrics: {}", result.error());
+    }
+}
+
+void Application::update_profiler_overlay() {
+    const auto statistics = helper::profiler::take_statistics(m_profiler_overlay.size() - 1);
+
+    m_profiler_overlay.front()->set_text(*this, "zone: avg / max ms per frame (calls)");
+
+    for (usize i = 1; i < m_profiler_overlay.size(); ++i) {
+        if (i - 1 >= statistics.size()) {
+            // empty texts can't be rendered
+            m_profiler_overlay.at(i)->set_text(*this, " ");
+            continue;
+        }
+
+        const auto& zone = statistics.at(i - 1);
+        m_profiler_overlay.at(i)->set_text(
+                *this, fmt::format(
+                               "{}: {:.2f} / {:.2f} ({:.1f})", zone.name,
+                               std::chrono::duration<double, std::milli>(zone.average_per_frame).count(),
+                               std::chrono::duration<double, std::milli>(zone.max_per_frame).count(),
+                               zone.calls_per_frame
+                       )
+        );
     }
 }
 
@@ -20,6 +20,8 @@
 struct Application final : public EventListener, public ServiceProvider {
 private:
     static constexpr auto num_audio_channels = u8{ 2 };
+    static constexpr auto profiler_overlay_lines = usize{ 12 };
+    static constexpr auto max_loading_threads = usize{ 3 };
 
     bool m_is_running{ true };
     CommandLineArguments m_command_line_arguments;
@@ -38,6 +40,9 @@ private:
     std::unique_ptr<ui::Label> m_fps_text{ nullptr };
 #endif
 
+    // only filled, if the profiler is enabled
+    std::vector<std::unique_ptr<ui::Label>> m_profiler_overlay;
+
 #if defined(_HAVE_DISCORD_SDK)
     std::optional<DiscordInstance> m_discord_instance{ std::nullopt };
 #endif
@@ -140,4 +145,6 @@ public:
 private:
     void initialize();
     void load_resources();
+    void update_profiler_overlay();
+    void write_metrics() const;
 };
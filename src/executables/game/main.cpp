@@ -9,6 +9,7 @@
 #include "helper/constants.hpp"
 #include "helper/graphic_utils.hpp"
 #include "helper/message_box.hpp"
+#include "helper/startup_timer.hpp"
 
 #include <exception>
 #include <filesystem>
@@ -62,6 +63,8 @@ namespace {
 
     int main_no_sdl_replace(int argc, char** argv) noexcept {
 
+        helper::startup::mark_process_start();
+
         std::shared_ptr<Window> window{ nullptr };
 
         try {
@@ -92,6 +95,7 @@ namespace {
 
 
             try {
+                const helper::startup::Phase phase{ "window creation" };
 #if defined(__ANDROID__) or defined(__CONSOLE__) or defined(__SERENITY__)
                 window = std::make_shared<Window>(window_name, WindowPosition::Centered);
 #else
@@ -22,6 +22,41 @@ helper::expected<CommandLineArguments, std::string> helper::parse_args(const std
             .scan<'i', CommandLineArguments::Level>()
             .default_value(CommandLineArguments::default_starting_level);
     parser.add_argument("-s", "--silent").help("disable audio output").default_value(false).implicit_value(true);
+    parser.add_argument("--threaded-simulation")
+            .help("run the game simulation and input handling on a separate thread, independent of rendering")
+            .default_value(CommandLineArguments::default_threaded_simulation)
+            .implicit_value(true);
+    parser.add_argument("--batch-rendering")
+            .help("record draw calls and submit them in batches, grouped by color, at the end of every frame")
+            .default_value(CommandLineArguments::default_batch_rendering)
+            .implicit_value(true);
+    parser.add_argument("--profile")
+            .help("show per frame timings in an overlay and write a chrome trace to the logs folder on exit")
+            .default_value(CommandLineArguments::default_profile)
+            .implicit_value(true);
+    parser.add_argument("--metrics-file")
+            .help("write performance metrics in the prometheus text format to this file on exit and on SIGUSR1");
+    parser.add_argument("--replay-speed")
+            .help("the speed of replays, relative to real time, e.g. 0.5 for half speed")
+            .scan<'g', double>()
+            .default_value(CommandLineArguments::default_replay_speed);
+    parser.add_argument("--max-catch-up-steps")
+            .help("the maximum number of simulation steps per update, after the game fell behind, 0 means no limit")
+            .scan<'i', u32>()
+            .default_value(CommandLineArguments::default_max_catch_up_steps);
+    parser.add_argument("--catch-up-policy")
+            .help("what happens with the steps over the catch up limit: 'spread' simulates them in later updates, "
+                  "'shift' drops them, like a pause")
+            .default_value(std::string{ "spread" });
+    parser.add_argument("--input-thread")
+            .help("collect keyboard, controller and touch input on a separate thread, best used with "
+                  "--threaded-simulation")
+            .default_value(CommandLineArguments::default_input_thread)
+            .implicit_value(true);
+    parser.add_argument("--startup-benchmark")
+            .help("exit after the first frame of the main menu and print how long every startup phase took")
+            .default_value(CommandLineArguments::default_startup_benchmark)
+            .implicit_value(true);
     try {
         parser.parse_args(arguments);
 
@@ -62,6 +97,45 @@ helper::expected<CommandLineArguments, std::string> helper::parse_args(const std
 
         result.silent = parser.get<bool>("--silent");
 
+        result.threaded_simulation = parser.get<bool>("--threaded-simulation");
+
+        result.batch_rendering = parser.get<bool>("--batch-rendering");
+
+        result.profile = parser.get<bool>("--profile");
+
+        if (auto path = parser.present("--metrics-file")) {
+            result.metrics_path = *path;
+        }
+
+        result.startup_benchmark = parser.get<bool>("--startup-benchmark");
+
+        const auto replay_speed = parser.get<double>("--replay-speed");
+        if (replay_speed > 0.0) {
+            result.replay_speed = replay_speed;
+        } else {
+            spdlog::error(
+                    "invalid value for replay speed ({}), using default value instead ({})", replay_speed,
+                    CommandLineArguments::default_replay_speed
+            );
+            result.replay_speed = CommandLineArguments::default_replay_speed;
+        }
+
+        result.max_catch_up_steps = parser.get<u32>("--max-catch-up-steps");
+
+        const auto catch_up_policy = parser.get<std::string>("--catch-up-policy");
+        if (catch_up_policy == "spread") {
+            result.catch_up_policy = CatchUpPolicy::Spread;
+        } else if (catch_up_policy == "shift") {
+            result.catch_up_policy = CatchUpPolicy::Shift;
+        } else {
+            spdlog::error(
+                    "invalid value for catch up policy ({}), using default value instead (spread)", catch_up_policy
+            );
+            result.catch_up_policy = CommandLineArguments::default_catch_up_policy;
+        }
+
+        result.input_thread = parser.get<bool>("--input-thread");
+
         return result;
     } catch (const std::exception& error) {
         return helper::unexpected<std::string>{ error.what() };
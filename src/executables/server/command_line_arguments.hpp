@@ -0,0 +1,79 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/random.hpp>
+#include <core/helper/types.hpp>
+
+#include "network/game_server.hpp"
+#include "network/udp_socket.hpp"
+
+#include <argparse/argparse.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fmt/format.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+
+struct CommandLineArguments final {
+    static constexpr u8 max_players = 8;
+
+    network::Address address;
+    network::GameServer::Options options;
+    std::optional<std::filesystem::path> metrics_path{ std::nullopt };
+
+    [[nodiscard]] static helper::expected<CommandLineArguments, std::string> from_args(int argc, char** argv) noexcept {
+        argparse::ArgumentParser parser{ argc >= 1 ? argv[0] //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                                   : "oopetris_game_server",
+                                         "0.0.1", argparse::default_arguments::all };
+
+        parser.add_argument("-b", "--bind")
+                .help("the IPv4 address and port to listen on")
+                .default_value(std::string{ "0.0.0.0:7777" });
+        parser.add_argument("-p", "--players").help("the number of players").scan<'i', u32>().default_value(2U);
+        parser.add_argument("-s", "--seed").help("the seed of the game, random if not given").scan<'u', Random::Seed>();
+        parser.add_argument("-l", "--level").help("the starting level of the game").scan<'i', u32>().default_value(0U);
+        parser.add_argument("-t", "--timeout")
+                .help("the seconds without packets, after which a player is considered gone")
+                .scan<'i', u32>()
+                .default_value(10U);
+        parser.add_argument("-m", "--metrics-file")
+                .help("write performance metrics in the prometheus text format to this file on exit");
+
+        try {
+            parser.parse_args(argc, argv);
+
+            const auto address = network::Address::from_string(parser.get("--bind"));
+            if (not address.has_value()) {
+                return helper::unexpected<std::string>{ address.error() };
+            }
+
+            const auto num_players = parser.get<u32>("--players");
+            if (num_players < 1 or num_players > max_players) {
+                return helper::unexpected<std::string>{ fmt::format(
+                        "the number of players has to be between 1 and {}, but was {}", max_players, num_players
+                ) };
+            }
+
+            CommandLineArguments result{
+                .address = address.value(),
+                .options = network::GameServer::Options{
+                        .num_players = static_cast<u8>(num_players),
+                        .seed = parser.present<Random::Seed>("--seed").value_or(Random::generate_seed()),
+                        .starting_level = parser.get<u32>("--level"),
+                        .client_timeout = std::chrono::seconds{ parser.get<u32>("--timeout") },
+                },
+            };
+
+            if (auto path = parser.present("--metrics-file")) {
+                result.metrics_path = *path;
+            }
+
+            return result;
+
+        } catch (const std::exception& error) {
+            return helper::unexpected<std::string>{ error.what() };
+        }
+    }
+};
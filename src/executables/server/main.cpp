@@ -0,0 +1,86 @@
+#include "./command_line_arguments.hpp"
+
+#include <core/helper/metrics.hpp>
+
+#include "network/game_server.hpp"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+
+int main(int argc, char** argv) noexcept {
+
+    try {
+
+        auto arguments_result = CommandLineArguments::from_args(argc, argv);
+
+        if (not arguments_result.has_value()) {
+            std::cerr << arguments_result.error();
+            return 1;
+        }
+
+        const auto arguments = std::move(arguments_result.value());
+
+        auto server = network::GameServer::create(arguments.address, arguments.options);
+        if (not server.has_value()) {
+            std::cerr << fmt::format("An error occurred during starting the server: {}\n", server.error());
+            return 1;
+        }
+
+        spdlog::info(
+                "waiting for {} players on {} (seed {})", arguments.options.num_players,
+                arguments.address.to_string(), arguments.options.seed
+        );
+
+        // the server has no timing of its own, the clients determine, how fast the steps are simulated
+        while (not server.value()->is_finished()) {
+            server.value()->poll();
+
+            if (server.value()->has_timed_out_clients()) {
+                spdlog::warn(
+                        "a player didn't send anything for {} ms, stopping the game",
+                        arguments.options.client_timeout.count()
+                );
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+
+        // the last acknowledgements and frames still have to reach the clients
+        const auto shutdown_time = std::chrono::steady_clock::now() + std::chrono::seconds{ 1 };
+        while (std::chrono::steady_clock::now() < shutdown_time) {
+            server.value()->poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+
+        for (u8 tetrion_index = 0; tetrion_index < arguments.options.num_players; ++tetrion_index) {
+            const auto information = server.value()->tetrion(tetrion_index).core_information();
+            std::cout << fmt::format(
+                    "player {}: score {}, level {}, lines {}\n", tetrion_index, information->score, information->level,
+                    information->lines_cleared
+            );
+        }
+
+        if (server.value()->num_rejected_frames() > 0) {
+            spdlog::warn("rejected {} input frames", server.value()->num_rejected_frames());
+        }
+
+        if (arguments.metrics_path.has_value()) {
+            const auto result = metrics::Registry::global().write_to_file(arguments.metrics_path.value());
+            if (not result.has_value()) {
+                std::cerr << fmt::format("An error occurred during writing the metrics: {}\n", result.error());
+                return 1;
+            }
+        }
+
+    } catch (const std::exception& error) {
+        std::cerr << error.what();
+        return 1;
+    }
+
+    return 0;
+}
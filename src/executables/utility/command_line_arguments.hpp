@@ -5,6 +5,7 @@
 #include <argparse/argparse.hpp>
 #include <filesystem>
 #include <fmt/format.h>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -22,6 +23,7 @@ private:
 public:
     std::filesystem::path recording_path;
     std::variant<Dump, Info> value;
+    std::optional<std::filesystem::path> metrics_path{ std::nullopt };
 
 
     template<typename T>
@@ -42,6 +44,8 @@ public:
 
 
         parser.add_argument("-r", "--recording").help("the path of a recorded game file").required();
+        parser.add_argument("-m", "--metrics-file")
+                .help("write performance metrics in the prometheus text format to this file on exit");
 
 
         // git add subparser
@@ -65,21 +69,30 @@ public:
 
             auto recording_path = parser.get("--recording");
 
+            std::optional<std::filesystem::path> metrics_path = std::nullopt;
+            if (auto path = parser.present("--metrics-file")) {
+                metrics_path = *path;
+            }
+
             if (parser.is_subcommand_used(dump_parser)) {
                 const auto ensure_ascii = dump_parser.get<bool>("--ensure-ascii");
                 const auto pretty_print = dump_parser.get<bool>("--pretty-print");
 
 
-                return CommandLineArguments{
+                CommandLineArguments result{
                     std::move(recording_path), Dump{ .ensure_ascii = ensure_ascii, .pretty_print = pretty_print }
                 };
+                result.metrics_path = std::move(metrics_path);
+                return result;
             }
 
             if (parser.is_subcommand_used(info_parser)) {
-                return CommandLineArguments{
+                CommandLineArguments result{
                     std::move(recording_path),
                     Info{},
                 };
+                result.metrics_path = std::move(metrics_path);
+                return result;
             }
 
 
@@ -1,6 +1,7 @@
 
 #include "./command_line_arguments.hpp"
 
+#include <core/helper/metrics.hpp>
 #include <recordings/recordings.hpp>
 
 #include <exception>
@@ -87,6 +88,14 @@ int main(int argc, char** argv) noexcept {
                 arguments.value
         );
 
+        if (arguments.metrics_path.has_value()) {
+            const auto result = metrics::Registry::global().write_to_file(arguments.metrics_path.value());
+            if (not result.has_value()) {
+                std::cerr << fmt::format("An error occurred during writing the metrics: {}\n", result.error());
+                return 1;
+            }
+        }
+
     } catch (const std::exception& error) {
         std::cerr << error.what();
         return 1;
@@ -0,0 +1,74 @@
+#include <core/helper/metrics.hpp>
+#include <core/helper/utils.hpp>
+
+#include "catch_up_limiter.hpp"
+#include "helper/profiler.hpp"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+
+CatchUpLimiter::CatchUpLimiter(const u32 max_steps, const CatchUpPolicy policy)
+    : m_max_steps{ max_steps },
+      m_policy{ policy } { }
+
+[[nodiscard]] SimulationStep CatchUpLimiter::target_step_index(const SimulationStep clock_step_index) const {
+    return clock_step_index > m_offset ? clock_step_index - m_offset : 0;
+}
+
+[[nodiscard]] CatchUpLimiter::Result
+CatchUpLimiter::limit(const SimulationStep simulation_step_index, const SimulationStep clock_step_index) {
+    const auto target = target_step_index(clock_step_index);
+    if (simulation_step_index >= target) {
+        return Result{ .steps = 0, .late = 0, .dropped = 0 };
+    }
+
+    const auto pending = target - simulation_step_index;
+    if (m_max_steps == 0 or pending <= m_max_steps) {
+        return Result{ .steps = pending, .late = 0, .dropped = 0 };
+    }
+
+    const auto over_budget = pending - m_max_steps;
+
+    switch (m_policy) {
+        case CatchUpPolicy::Spread: {
+            const auto already_late = std::max(m_last_target, simulation_step_index + m_max_steps);
+            const auto late = target > already_late ? target - already_late : 0;
+            m_last_target = target;
+            return Result{ .steps = m_max_steps, .late = late, .dropped = 0 };
+        }
+        case CatchUpPolicy::Shift:
+            m_offset += over_budget;
+            return Result{ .steps = m_max_steps, .late = 0, .dropped = over_budget };
+        default:
+            utils::unreachable();
+    }
+}
+
+[[nodiscard]] u32 CatchUpLimiter::max_steps() const {
+    return m_max_steps;
+}
+
+[[nodiscard]] CatchUpPolicy CatchUpLimiter::policy() const {
+    return m_policy;
+}
+
+void CatchUpLimiter::report(const Result& result) {
+    static auto& late_steps = metrics::Registry::global().counter(
+            "oopetris_simulation_steps_late_total", "simulation steps, that were deferred to a later update"
+    );
+    static auto& dropped_steps = metrics::Registry::global().counter(
+            "oopetris_simulation_steps_dropped_total", "simulation steps, that were dropped after a stall"
+    );
+
+    if (result.late > 0) {
+        late_steps.add(result.late);
+    }
+
+    if (result.dropped > 0) {
+        dropped_steps.add(result.dropped);
+        spdlog::warn("dropped {} simulation steps, since the game fell behind", result.dropped);
+    }
+
+    helper::profiler::counter("catch up late steps", static_cast<i64>(result.late));
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+// what happens with the steps, that are over the catch up budget of one update
+enum class CatchUpPolicy : u8 {
+    // simulate them in the following updates, the game runs faster than real time, until it caught up
+    Spread,
+    // drop them, the clock is shifted, like after a pause, so the game continues at real time, where it stalled
+    Shift,
+};
+
+// limits the number of simulation steps per update, so that a long stall (e.g. dragging the window or a breakpoint) doesn't lead to one very long update, which would stall the next frame even further
+struct CatchUpLimiter final {
+    struct Result {
+        // the steps to simulate now
+        SimulationStep steps;
+        // the steps, that were deferred to later updates for the first time (only with CatchUpPolicy::Spread), so every late step is only counted once
+        SimulationStep late;
+        // the steps, that are over the budget and were dropped (only with CatchUpPolicy::Shift)
+        SimulationStep dropped;
+    };
+
+private:
+    u32 m_max_steps;
+    CatchUpPolicy m_policy;
+    // the sum of all dropped steps, the clock is shifted by this
+    SimulationStep m_offset{ 0 };
+    // the target of the last update, the steps up to this were already counted, if they were late
+    SimulationStep m_last_target{ 0 };
+
+public:
+    // 0 means no limit
+    CatchUpLimiter(u32 max_steps, CatchUpPolicy policy);
+
+    // the clock step index without the dropped steps
+    [[nodiscard]] SimulationStep target_step_index(SimulationStep clock_step_index) const;
+
+    // computes the steps for one update, dropped steps are removed from all following target step indices
+    [[nodiscard]] Result limit(SimulationStep simulation_step_index, SimulationStep clock_step_index);
+
+    [[nodiscard]] u32 max_steps() const;
+    [[nodiscard]] CatchUpPolicy policy() const;
+
+    // records the result in the global metrics
+    static void report(const Result& result);
+};
@@ -8,9 +8,27 @@ CommandLineArguments::CommandLineArguments(
         std::optional<std::filesystem::path> recording_path,
         std::optional<u32> target_fps,
         Level starting_level,
-        bool silent
+        bool silent,
+        bool threaded_simulation,
+        bool batch_rendering,
+        bool profile,
+        std::optional<std::filesystem::path> metrics_path,
+        bool startup_benchmark,
+        double replay_speed,
+        u32 max_catch_up_steps,
+        CatchUpPolicy catch_up_policy,
+        bool input_thread
 )
     : recording_path{ std::move(recording_path) },
       target_fps{ target_fps },
       starting_level{ starting_level },
-      silent{ silent } { }
+      silent{ silent },
+      threaded_simulation{ threaded_simulation },
+      batch_rendering{ batch_rendering },
+      profile{ profile },
+      metrics_path{ std::move(metrics_path) },
+      startup_benchmark{ startup_benchmark },
+      replay_speed{ replay_speed },
+      max_catch_up_steps{ max_catch_up_steps },
+      catch_up_policy{ catch_up_policy },
+      input_thread{ input_thread } { }
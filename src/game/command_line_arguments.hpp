@@ -6,6 +6,8 @@
 #include <core/helper/types.hpp>
 #include <core/helper/utils.hpp>
 
+#include "catch_up_limiter.hpp"
+
 #include <filesystem>
 #include <optional>
 
@@ -13,17 +15,43 @@ struct CommandLineArguments final {
 
     static const constexpr auto default_starting_level = u32{ 0 };
     static const constexpr auto default_silent = true;
+    static const constexpr auto default_threaded_simulation = false;
+    static const constexpr auto default_batch_rendering = false;
+    static const constexpr auto default_profile = false;
+    static const constexpr auto default_startup_benchmark = false;
+    static const constexpr auto default_replay_speed = 1.0;
+    static const constexpr auto default_max_catch_up_steps = u32{ 8 };
+    static const constexpr auto default_catch_up_policy = CatchUpPolicy::Spread;
+    static const constexpr auto default_input_thread = false;
 
     std::optional<std::filesystem::path> recording_path;
     std::optional<u32> target_fps;
     using Level = std::remove_cvref_t<decltype(default_starting_level)>;
     Level starting_level;
     bool silent;
+    bool threaded_simulation;
+    bool batch_rendering;
+    bool profile;
+    std::optional<std::filesystem::path> metrics_path;
+    bool startup_benchmark;
+    double replay_speed;
+    u32 max_catch_up_steps;
+    CatchUpPolicy catch_up_policy;
+    bool input_thread;
 
     CommandLineArguments(
             std::optional<std::filesystem::path> recording_path,
             std::optional<u32> target_fps,
             Level starting_level = default_starting_level,
-            bool silent = default_silent
+            bool silent = default_silent,
+            bool threaded_simulation = default_threaded_simulation,
+            bool batch_rendering = default_batch_rendering,
+            bool profile = default_profile,
+            std::optional<std::filesystem::path> metrics_path = std::nullopt,
+            bool startup_benchmark = default_startup_benchmark,
+            double replay_speed = default_replay_speed,
+            u32 max_catch_up_steps = default_max_catch_up_steps,
+            CatchUpPolicy catch_up_policy = default_catch_up_policy,
+            bool input_thread = default_input_thread
     );
 };
@@ -1,33 +1,73 @@
 
 #include <core/helper/magic_enum_wrapper.hpp>
+#include <core/helper/metrics.hpp>
 #include <core/helper/utils.hpp>
 
 #include "game.hpp"
+#include "game/command_line_arguments.hpp"
+#include "helper/profiler.hpp"
 #include "input/replay_input.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    // faster clocks (e.g. fast forwarded replays) advance more steps per frame, so the budget has to grow with them
+    [[nodiscard]] CatchUpLimiter
+    create_catch_up_limiter(const CommandLineArguments& arguments, const ClockSource& clock_source) {
+        const auto max_steps = static_cast<u32>(
+                std::ceil(static_cast<double>(arguments.max_catch_up_steps) * std::max(clock_source.speed(), 1.0))
+        );
+        return CatchUpLimiter{ max_steps, arguments.catch_up_policy };
+    }
+
+} // namespace
+
 Game::Game(
         ServiceProvider* const service_provider,
         const std::shared_ptr<input::GameInput>& input,
         const tetrion::StartingParameters& starting_parameters,
         u32 simulation_frequency,
         const ui::Layout& layout,
-        bool is_top_level
+        bool is_top_level,
+        std::unique_ptr<ClockSource> clock_source
 )
     : ui::Widget{ layout, ui::WidgetType::Component, is_top_level },
-      m_clock_source{ std::make_unique<LocalClock>(simulation_frequency) },
+      m_clock_source{ clock_source == nullptr ? std::make_unique<HighResolutionClock>(simulation_frequency)
+                                              : std::move(clock_source) },
+      m_catch_up_limiter{ create_catch_up_limiter(service_provider->command_line_arguments(), *m_clock_source) },
       m_input{ input } {
 
 
     spdlog::info("starting level for tetrion {}", starting_parameters.starting_level);
 
+    const auto threaded_simulation = service_provider->command_line_arguments().threaded_simulation;
+
+    // in threaded mode, the tetrion of this widget only displays the snapshots of the simulated one, so it must not record anything
     m_tetrion = std::make_unique<Tetrion>(
             starting_parameters.tetrion_index, starting_parameters.seed, starting_parameters.starting_level,
-            service_provider, starting_parameters.recording_writer, layout, false
+            service_provider, threaded_simulation ? std::nullopt : starting_parameters.recording_writer, layout, false
     );
 
     m_tetrion->spawn_next_tetromino(0);
 
-    m_input->set_target_tetrion(m_tetrion.get());
+    std::unique_ptr<SimulatedTetrion> simulated_tetrion{ nullptr };
+    if (threaded_simulation) {
+        simulated_tetrion = std::make_unique<SimulatedTetrion>(
+                starting_parameters.tetrion_index, starting_parameters.seed, starting_parameters.starting_level,
+                nullptr, starting_parameters.recording_writer
+        );
+
+        simulated_tetrion->spawn_next_tetromino(0);
+
+        m_input->set_target_tetrion(simulated_tetrion.get());
+    } else {
+        m_input->set_target_tetrion(m_tetrion.get());
+        m_input->set_timestamp_mapper([this](std::chrono::nanoseconds age) {
+            return m_catch_up_limiter.target_step_index(m_clock_source->simulation_step_index_before(age));
+        });
+    }
     if (starting_parameters.recording_writer.has_value()) {
         const auto recording_writer = starting_parameters.recording_writer.value();
         const auto tetrion_index = starting_parameters.tetrion_index;
@@ -39,6 +79,20 @@ Game::Game(
             std::ignore = recording_writer->add_record(tetrion_index, simulation_step_index, event);
         });
     }
+
+    // start this at the end, so that the input is fully set up, before the simulation thread uses it
+    if (threaded_simulation) {
+        m_simulation_thread = std::make_unique<SimulationThread>(
+                m_clock_source.get(), std::move(simulated_tetrion), m_input, simulation_frequency, m_catch_up_limiter
+        );
+    }
+}
+
+Game::~Game() {
+    // the input may outlive this game, the simulation thread resets its own mapper
+    if (m_simulation_thread == nullptr) {
+        m_input->set_timestamp_mapper(nullptr);
+    }
 }
 
 void Game::update() {
@@ -46,18 +100,37 @@ void Game::update() {
         return;
     }
 
+    const helper::profiler::Zone zone{ "Game::update" };
+
     if (m_is_paused) {
         // if we would still be in pause mode, update() wouldn't have been called in the first place => we
         // must resume from pause
         set_paused(false);
     }
 
-    while (m_simulation_step_index < m_clock_source->simulation_step_index()) {
+    if (m_simulation_thread != nullptr) {
+        m_simulation_thread->update(*m_tetrion);
+        return;
+    }
+
+    const auto catch_up = m_catch_up_limiter.limit(m_simulation_step_index, m_clock_source->simulation_step_index());
+    CatchUpLimiter::report(catch_up);
+
+    const auto steps = static_cast<i64>(catch_up.steps);
+    for (SimulationStep i = 0; i < catch_up.steps; ++i) {
         ++m_simulation_step_index;
         m_input->update(m_simulation_step_index);
         m_tetrion->update_step(m_simulation_step_index);
         m_input->late_update(m_simulation_step_index);
     }
+
+    helper::profiler::counter("Game::update steps", steps);
+
+    static auto& steps_per_frame = metrics::Registry::global().histogram(
+            "oopetris_simulation_steps_per_frame", "simulation steps executed in one Game::update",
+            { 0, 1, 2, 3, 4, 8, 16, 32 }
+    );
+    steps_per_frame.observe(static_cast<double>(steps));
 }
 
 void Game::render(const ServiceProvider& service_provider) const {
@@ -72,11 +145,15 @@ Game::handle_event(const std::shared_ptr<input::InputManager>& /*input_manager*/
 void Game::set_paused(bool paused) {
     m_is_paused = paused;
 
-    assert(m_clock_source->can_be_paused());
-    if (paused) {
-        m_clock_source->pause();
+    if (m_simulation_thread != nullptr) {
+        m_simulation_thread->set_paused(paused);
     } else {
-        m_clock_source->resume();
+        assert(m_clock_source->can_be_paused());
+        if (paused) {
+            m_clock_source->pause();
+        } else {
+            m_clock_source->resume();
+        }
     }
 
     auto listener = utils::is_child_class<EventListener>(m_input);
@@ -92,6 +169,10 @@ void Game::set_paused(bool paused) {
 
 
 [[nodiscard]] bool Game::is_game_finished() const {
+    if (m_simulation_thread != nullptr) {
+        return m_simulation_thread->is_game_finished();
+    }
+
     if (m_tetrion->is_game_over()) {
         return true;
     };
@@ -2,8 +2,10 @@
 
 #include <recordings/utility/recording.hpp>
 
+#include "catch_up_limiter.hpp"
 #include "helper/clock_source.hpp"
 #include "input/input_creator.hpp"
+#include "simulation_thread.hpp"
 #include "tetrion.hpp"
 #include "ui/widget.hpp"
 
@@ -13,10 +15,14 @@ private:
 
     std::unique_ptr<ClockSource> m_clock_source;
     SimulationStep m_simulation_step_index{ 0 };
+    CatchUpLimiter m_catch_up_limiter;
     std::unique_ptr<Tetrion> m_tetrion;
     std::shared_ptr<input::GameInput> m_input;
     bool m_is_paused{ false };
 
+    // only set, if the simulation runs on its own thread, m_tetrion is than only used for rendering
+    std::unique_ptr<SimulationThread> m_simulation_thread;
+
 public:
     explicit Game(
             ServiceProvider* service_provider,
@@ -24,9 +30,17 @@ public:
             const tetrion::StartingParameters& starting_parameters,
             u32 simulation_frequency,
             const ui::Layout& layout,
-            bool is_top_level
+            bool is_top_level,
+            std::unique_ptr<ClockSource> clock_source = nullptr
     );
 
+    Game(const Game&) = delete;
+    Game& operator=(const Game&) = delete;
+    Game(Game&&) = delete;
+    Game& operator=(Game&&) = delete;
+
+    ~Game() override;
+
     void update() override;
 
     void render(const ServiceProvider& service_provider) const override;
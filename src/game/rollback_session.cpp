@@ -0,0 +1,278 @@
+#include <core/helper/metrics.hpp>
+#include <core/helper/utils.hpp>
+
+#include "helper/profiler.hpp"
+#include "rollback_session.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <fmt/format.h>
+#include <stdexcept>
+
+
+rollback::FrameInput::FrameInput() : GameInput{ input::GameInputType::Recording } { }
+
+void rollback::FrameInput::apply(const InputEvent event, const SimulationStep simulation_step_index) {
+    GameInput::handle_event(event, simulation_step_index);
+}
+
+[[nodiscard]] std::optional<input::MenuEvent> rollback::FrameInput::get_menu_event(const SDL_Event& /*event*/) const {
+    return std::nullopt;
+}
+
+[[nodiscard]] std::string rollback::FrameInput::describe_menu_event(input::MenuEvent /*event*/) const {
+    throw std::runtime_error("not supported");
+}
+
+[[nodiscard]] const input::Input* rollback::FrameInput::underlying_input() const {
+    return nullptr;
+}
+
+
+rollback::RollbackSession::RollbackSession(
+        const std::vector<PlayerParameters>& players,
+        const u8 local_index,
+        const u32 history_length
+)
+    : m_local_index{ local_index },
+      m_history_length{ history_length },
+      m_snapshots(history_length, Snapshot{ .simulation_step_index = 0, .players = {} }) {
+
+    if (local_index >= players.size()) {
+        throw std::invalid_argument(fmt::format("local index out of bounds: {} >= {}", local_index, players.size()));
+    }
+
+    if (history_length == 0) {
+        throw std::invalid_argument("the history length has to be at least 1");
+    }
+
+    m_players.reserve(players.size());
+
+    for (u8 tetrion_index = 0; tetrion_index < static_cast<u8>(players.size()); ++tetrion_index) {
+        const auto& parameters = players.at(tetrion_index);
+
+        // without a recording writer, since steps are simulated more than once
+        auto tetrion = std::make_unique<SimulatedTetrion>(
+                tetrion_index, parameters.seed, parameters.starting_level, nullptr, std::nullopt
+        );
+        tetrion->spawn_next_tetromino(0);
+
+        auto input = std::make_unique<FrameInput>();
+        input->set_auto_shift_timings(parameters.auto_shift_timings);
+        input->set_target_tetrion(tetrion.get());
+
+        m_players.push_back(Player{
+                .tetrion = std::move(tetrion),
+                .input = std::move(input),
+                .frames = std::vector<FrameSlot>(
+                        static_cast<usize>(history_length) * 2,
+                        FrameSlot{ .simulation_step_index = 0, .is_confirmed = false, .events = {} }
+                ),
+                .next_unconfirmed_step = 1,
+        });
+    }
+}
+
+void rollback::RollbackSession::add_local_event(const InputEvent event) {
+    auto& slot = frame_slot(m_players.at(m_local_index), m_simulation_step_index + 1);
+    slot.events.push_back(event);
+}
+
+[[nodiscard]] helper::expected<void, std::string> rollback::RollbackSession::add_remote_frame(const InputFrame& frame) {
+    if (frame.tetrion_index >= m_players.size() or frame.tetrion_index == m_local_index) {
+        return helper::unexpected<std::string>{ fmt::format("invalid tetrion index: {}", frame.tetrion_index) };
+    }
+
+    auto& player = m_players.at(frame.tetrion_index);
+
+    if (frame.simulation_step_index == 0 or frame.simulation_step_index < player.next_unconfirmed_step) {
+        // a duplicate of an already confirmed frame
+        return {};
+    }
+
+    if (frame.simulation_step_index > m_simulation_step_index + m_history_length) {
+        return helper::unexpected<std::string>{ fmt::format(
+                "frame of tetrion {} is too far ahead: step {}, while at step {}", frame.tetrion_index,
+                frame.simulation_step_index, m_simulation_step_index
+        ) };
+    }
+
+    auto& slot = frame_slot(player, frame.simulation_step_index);
+    if (slot.is_confirmed) {
+        return {};
+    }
+
+    slot.is_confirmed = true;
+    slot.events.assign(frame.events.begin(), frame.events.end());
+
+    // the step was already simulated without any events
+    if (frame.simulation_step_index <= m_simulation_step_index and not frame.events.empty()) {
+        m_rollback_step = std::min(m_rollback_step.value_or(frame.simulation_step_index), frame.simulation_step_index);
+    }
+
+    while (player.next_unconfirmed_step <= m_simulation_step_index + m_history_length) {
+        const auto& next_slot = frame_slot(player, player.next_unconfirmed_step);
+        if (not next_slot.is_confirmed) {
+            break;
+        }
+        ++player.next_unconfirmed_step;
+    }
+
+    return {};
+}
+
+[[nodiscard]] std::optional<rollback::InputFrame> rollback::RollbackSession::advance() {
+    if (not can_advance()) {
+        return std::nullopt;
+    }
+
+    const helper::profiler::Zone zone{ "RollbackSession::advance" };
+
+    apply_pending_rollback();
+
+    const auto simulation_step_index = m_simulation_step_index + 1;
+
+    auto& local_slot = frame_slot(m_players.at(m_local_index), simulation_step_index);
+    local_slot.is_confirmed = true;
+
+    simulate_step(simulation_step_index);
+    m_simulation_step_index = simulation_step_index;
+
+    return InputFrame{ .tetrion_index = m_local_index,
+                       .simulation_step_index = simulation_step_index,
+                       .events = local_slot.events };
+}
+
+void rollback::RollbackSession::apply_pending_rollback() {
+    if (not m_rollback_step.has_value()) {
+        return;
+    }
+
+    const auto rollback_step = m_rollback_step.value();
+    m_rollback_step = std::nullopt;
+
+    // can_advance() guarantees, that the snapshot of every unconfirmed step is still in the history
+    assert(rollback_step + m_history_length > m_simulation_step_index and "rollback step is not in the history");
+
+    static auto& rollbacks_counter =
+            metrics::Registry::global().counter("oopetris_rollbacks_total", "rollbacks of the simulation state");
+    static auto& resimulated_steps_counter = metrics::Registry::global().counter(
+            "oopetris_rollback_resimulated_steps_total", "simulation steps, that were simulated again after a rollback"
+    );
+
+    const auto resimulated_steps = m_simulation_step_index - rollback_step + 1;
+    rollbacks_counter.add();
+    resimulated_steps_counter.add(resimulated_steps);
+    helper::profiler::counter("rollback resimulated steps", static_cast<i64>(resimulated_steps));
+    ++m_num_rollbacks;
+
+    restore_snapshot(rollback_step);
+
+    for (auto simulation_step_index = rollback_step; simulation_step_index <= m_simulation_step_index;
+         ++simulation_step_index) {
+        simulate_step(simulation_step_index);
+    }
+}
+
+[[nodiscard]] bool rollback::RollbackSession::can_advance() const {
+    // the snapshot of the oldest unconfirmed step has to stay in the history, after the next step was simulated
+    return m_simulation_step_index + 1 - confirmed_simulation_step_index() <= m_history_length;
+}
+
+[[nodiscard]] SimulationStep rollback::RollbackSession::simulation_step_index() const {
+    return m_simulation_step_index;
+}
+
+[[nodiscard]] SimulationStep rollback::RollbackSession::confirmed_simulation_step_index() const {
+    auto result = m_simulation_step_index;
+
+    for (u8 tetrion_index = 0; tetrion_index < static_cast<u8>(m_players.size()); ++tetrion_index) {
+        if (tetrion_index == m_local_index) {
+            continue;
+        }
+
+        result = std::min(result, m_players.at(tetrion_index).next_unconfirmed_step - 1);
+    }
+
+    return result;
+}
+
+[[nodiscard]] u64 rollback::RollbackSession::num_rollbacks() const {
+    return m_num_rollbacks;
+}
+
+[[nodiscard]] u8 rollback::RollbackSession::local_index() const {
+    return m_local_index;
+}
+
+[[nodiscard]] usize rollback::RollbackSession::num_players() const {
+    return m_players.size();
+}
+
+[[nodiscard]] const SimulatedTetrion& rollback::RollbackSession::tetrion(const u8 tetrion_index) const {
+    return *m_players.at(tetrion_index).tetrion;
+}
+
+[[nodiscard]] rollback::RollbackSession::FrameSlot&
+rollback::RollbackSession::frame_slot(Player& player, const SimulationStep simulation_step_index) {
+    auto& slot = player.frames.at(simulation_step_index % player.frames.size());
+
+    // the slot still contains a frame of an older step, so it is reused
+    if (slot.simulation_step_index != simulation_step_index) {
+        slot.simulation_step_index = simulation_step_index;
+        slot.is_confirmed = false;
+        slot.events.clear();
+    }
+
+    return slot;
+}
+
+void rollback::RollbackSession::save_snapshot(const SimulationStep simulation_step_index) {
+    auto& snapshot = m_snapshots.at(simulation_step_index % m_history_length);
+    snapshot.simulation_step_index = simulation_step_index;
+
+    for (usize index = 0; index < m_players.size(); ++index) {
+        const auto& player = m_players.at(index);
+
+        // the allocations of the existing states are reused
+        if (index < snapshot.players.size()) {
+            auto& state = snapshot.players.at(index);
+            player.tetrion->write_state(state.tetrion);
+            state.held_keys = player.input->held_keys();
+        } else {
+            snapshot.players.push_back(
+                    PlayerState{ .tetrion = player.tetrion->state(), .held_keys = player.input->held_keys() }
+            );
+        }
+    }
+}
+
+void rollback::RollbackSession::restore_snapshot(const SimulationStep simulation_step_index) {
+    const auto& snapshot = m_snapshots.at(simulation_step_index % m_history_length);
+    assert(snapshot.simulation_step_index == simulation_step_index and "snapshot was overwritten");
+
+    for (usize index = 0; index < m_players.size(); ++index) {
+        const auto& state = snapshot.players.at(index);
+        auto& player = m_players.at(index);
+        player.tetrion->apply_state(state.tetrion);
+        player.input->set_held_keys(state.held_keys);
+    }
+}
+
+void rollback::RollbackSession::simulate_step(const SimulationStep simulation_step_index) {
+    save_snapshot(simulation_step_index);
+
+    for (auto& player : m_players) {
+        // unconfirmed frames are predicted to have no events
+        const auto& slot = frame_slot(player, simulation_step_index);
+        if (slot.is_confirmed) {
+            for (const auto event : slot.events) {
+                player.input->apply(event, simulation_step_index);
+            }
+        }
+
+        player.input->update(simulation_step_index);
+        player.tetrion->update_step(simulation_step_index);
+        player.input->late_update(simulation_step_index);
+    }
+}
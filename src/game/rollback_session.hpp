@@ -0,0 +1,130 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/input_event.hpp>
+#include <core/helper/random.hpp>
+#include <core/helper/types.hpp>
+
+#include "input/game_input.hpp"
+#include "simulated_tetrion.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rollback {
+
+    // all input events of one tetrion in one simulation step, a frame is sent for every step, even without events, since it confirms, that there were none
+    struct InputFrame {
+        u8 tetrion_index;
+        SimulationStep simulation_step_index;
+        std::vector<InputEvent> events;
+
+        [[nodiscard]] bool operator==(const InputFrame& other) const = default;
+    };
+
+    struct PlayerParameters {
+        Random::Seed seed;
+        u32 starting_level;
+        input::AutoShiftTimings auto_shift_timings;
+
+        [[nodiscard]] bool operator==(const PlayerParameters& other) const = default;
+    };
+
+    // applies the events of the input frames, so that the auto shift handling is the same as for every other input
+    struct FrameInput final : public input::GameInput {
+        FrameInput();
+
+        void apply(InputEvent event, SimulationStep simulation_step_index);
+
+        [[nodiscard]] std::optional<input::MenuEvent> get_menu_event(const SDL_Event& event) const override;
+
+        [[nodiscard]] std::string describe_menu_event(input::MenuEvent event) const override;
+
+        [[nodiscard]] const input::Input* underlying_input() const override;
+    };
+
+    // simulates the tetrions of all players, the local one with its confirmed inputs and the remote ones with predicted inputs, until their frames arrive
+    // the prediction is, that a remote player didn't press or release anything, if a confirmed frame contradicts that, the state is restored to the step of that frame and all steps up to the present are simulated again
+    struct RollbackSession final {
+    public:
+        static constexpr u32 default_history_length = 64;
+
+    private:
+        struct FrameSlot {
+            SimulationStep simulation_step_index;
+            bool is_confirmed;
+            std::vector<InputEvent> events;
+        };
+
+        struct Player {
+            std::unique_ptr<SimulatedTetrion> tetrion;
+            std::unique_ptr<FrameInput> input;
+            // indexed by simulation step modulo its size, it has space for the history and the same amount of frames ahead of the present
+            std::vector<FrameSlot> frames;
+            // all frames before this were confirmed
+            SimulationStep next_unconfirmed_step;
+        };
+
+        struct PlayerState {
+            SimulatedTetrion::State tetrion;
+            input::GameInput::HeldKeys held_keys;
+        };
+
+        // the state before the given step was simulated
+        struct Snapshot {
+            SimulationStep simulation_step_index;
+            std::vector<PlayerState> players;
+        };
+
+        u8 m_local_index;
+        u32 m_history_length;
+        // the last simulated step, the tetrions spawn their first tetromino at step 0
+        SimulationStep m_simulation_step_index{ 0 };
+        std::vector<Player> m_players;
+        // indexed by simulation step modulo the history length
+        std::vector<Snapshot> m_snapshots;
+        // the earliest step, where a confirmed frame contradicted the prediction
+        std::optional<SimulationStep> m_rollback_step;
+        u64 m_num_rollbacks{ 0 };
+
+    public:
+        RollbackSession(
+                const std::vector<PlayerParameters>& players,
+                u8 local_index,
+                u32 history_length = default_history_length
+        );
+
+        // the event happens in the next simulated step
+        void add_local_event(InputEvent event);
+
+        // frames may arrive out of order and more than once, but not further ahead than the history length
+        [[nodiscard]] helper::expected<void, std::string> add_remote_frame(const InputFrame& frame);
+
+        // simulates the next step and returns the local frame of it, which has to be sent to the other players
+        // nullopt, if the oldest unconfirmed remote frame is so old, that it couldn't be rolled back anymore, the session has to wait for it to arrive
+        [[nodiscard]] std::optional<InputFrame> advance();
+
+        // this is done by advance(), but can be used to apply the frames that arrived last, without simulating a new step
+        void apply_pending_rollback();
+
+        [[nodiscard]] bool can_advance() const;
+
+        [[nodiscard]] SimulationStep simulation_step_index() const;
+        // all frames up to this step were confirmed, so the state up to it is final
+        [[nodiscard]] SimulationStep confirmed_simulation_step_index() const;
+        [[nodiscard]] u64 num_rollbacks() const;
+
+        [[nodiscard]] u8 local_index() const;
+        [[nodiscard]] usize num_players() const;
+        [[nodiscard]] const SimulatedTetrion& tetrion(u8 tetrion_index) const;
+
+    private:
+        [[nodiscard]] FrameSlot& frame_slot(Player& player, SimulationStep simulation_step_index);
+        void save_snapshot(SimulationStep simulation_step_index);
+        void restore_snapshot(SimulationStep simulation_step_index);
+        void simulate_step(SimulationStep simulation_step_index);
+    };
+
+} // namespace rollback
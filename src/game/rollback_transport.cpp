@@ -0,0 +1,54 @@
+#include "rollback_transport.hpp"
+
+
+rollback::LoopbackLink::Endpoint::Endpoint(LoopbackLink* link, Channel* incoming, Channel* outgoing)
+    : m_link{ link },
+      m_incoming{ incoming },
+      m_outgoing{ outgoing } { }
+
+void rollback::LoopbackLink::Endpoint::send(const InputFrame& frame) {
+    m_outgoing->in_flight.emplace(m_link->arrival_tick(), frame);
+}
+
+[[nodiscard]] std::optional<rollback::InputFrame> rollback::LoopbackLink::Endpoint::receive() {
+    const auto first = m_incoming->in_flight.begin();
+    if (first == m_incoming->in_flight.end() or first->first > m_link->current_tick()) {
+        return std::nullopt;
+    }
+
+    auto frame = std::move(first->second);
+    m_incoming->in_flight.erase(first);
+    return frame;
+}
+
+
+rollback::LoopbackLink::LoopbackLink(const Options& options)
+    : m_options{ options },
+      m_random{ options.seed },
+      m_first_to_second{ std::make_unique<Channel>() },
+      m_second_to_first{ std::make_unique<Channel>() },
+      m_first{ std::make_unique<Endpoint>(this, m_second_to_first.get(), m_first_to_second.get()) },
+      m_second{ std::make_unique<Endpoint>(this, m_first_to_second.get(), m_second_to_first.get()) } { }
+
+rollback::LoopbackLink::~LoopbackLink() = default;
+
+[[nodiscard]] rollback::Transport& rollback::LoopbackLink::first() {
+    return *m_first;
+}
+
+[[nodiscard]] rollback::Transport& rollback::LoopbackLink::second() {
+    return *m_second;
+}
+
+void rollback::LoopbackLink::tick() {
+    ++m_tick;
+}
+
+[[nodiscard]] u64 rollback::LoopbackLink::current_tick() const {
+    return m_tick;
+}
+
+[[nodiscard]] u64 rollback::LoopbackLink::arrival_tick() {
+    const auto jitter = m_options.jitter_ticks == 0 ? 0 : m_random.random<u32>(m_options.jitter_ticks + 1);
+    return m_tick + m_options.latency_ticks + jitter;
+}
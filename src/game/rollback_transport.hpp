@@ -0,0 +1,92 @@
+#pragma once
+
+#include <core/helper/random.hpp>
+#include <core/helper/types.hpp>
+
+#include "rollback_session.hpp"
+
+#include <map>
+#include <memory>
+#include <optional>
+
+namespace rollback {
+
+    // delivers the input frames between the rollback sessions of the players, frames may arrive late and out of order
+    struct Transport {
+        Transport() = default;
+
+        Transport(const Transport&) = delete;
+        Transport& operator=(const Transport&) = delete;
+
+        Transport(Transport&&) = delete;
+        Transport& operator=(Transport&&) = delete;
+
+        virtual ~Transport() = default;
+
+        virtual void send(const InputFrame& frame) = 0;
+
+        // nullopt, if no frame arrived yet
+        [[nodiscard]] virtual std::optional<InputFrame> receive() = 0;
+    };
+
+    // connects two sessions in the same process with a simulated latency, so that rollbacks can be tested locally
+    // the time is measured in ticks, that are advanced by the owner, e.g. once per simulation step
+    struct LoopbackLink final {
+    public:
+        struct Options {
+            u32 latency_ticks;
+            // every frame is delayed by a random amount of ticks up to this in addition, so frames can be reordered
+            u32 jitter_ticks;
+            Random::Seed seed;
+        };
+
+    private:
+        struct Channel {
+            // ordered by the tick, at which the frame arrives, frames with the same tick stay in the order they were sent
+            std::multimap<u64, InputFrame> in_flight;
+        };
+
+        struct Endpoint final : public Transport {
+        private:
+            LoopbackLink* m_link;
+            Channel* m_incoming;
+            Channel* m_outgoing;
+
+        public:
+            Endpoint(LoopbackLink* link, Channel* incoming, Channel* outgoing);
+
+            void send(const InputFrame& frame) override;
+            [[nodiscard]] std::optional<InputFrame> receive() override;
+        };
+
+        Options m_options;
+        Random m_random;
+        u64 m_tick{ 0 };
+        std::unique_ptr<Channel> m_first_to_second;
+        std::unique_ptr<Channel> m_second_to_first;
+        std::unique_ptr<Endpoint> m_first;
+        std::unique_ptr<Endpoint> m_second;
+
+    public:
+        explicit LoopbackLink(const Options& options);
+
+        LoopbackLink(const LoopbackLink&) = delete;
+        LoopbackLink& operator=(const LoopbackLink&) = delete;
+
+        LoopbackLink(LoopbackLink&&) = delete;
+        LoopbackLink& operator=(LoopbackLink&&) = delete;
+
+        ~LoopbackLink();
+
+        [[nodiscard]] Transport& first();
+        [[nodiscard]] Transport& second();
+
+        void tick();
+
+        [[nodiscard]] u64 current_tick() const;
+
+    private:
+        [[nodiscard]] u64 arrival_tick();
+    };
+
+} // namespace rollback
@@ -1,4 +1,5 @@
 #include <core/helper/magic_enum_wrapper.hpp>
+#include <core/helper/metrics.hpp>
 #include <core/helper/utils.hpp>
 #include <recordings/utility/recording_writer.hpp>
 
@@ -8,6 +9,7 @@
 #include "manager/music_manager.hpp"
 #include "simulated_tetrion.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <spdlog/spdlog.h>
 
@@ -91,6 +93,18 @@ bool SimulatedTetrion::handle_input_command(
                 return true;
             }
             return false;
+        case input::GameInputCommand::MoveLeftToWall:
+            if (move_tetromino_to_wall_left()) {
+                reset_lock_delay(simulation_step_index);
+                return true;
+            }
+            return false;
+        case input::GameInputCommand::MoveRightToWall:
+            if (move_tetromino_to_wall_right()) {
+                reset_lock_delay(simulation_step_index);
+                return true;
+            }
+            return false;
         case input::GameInputCommand::MoveDown:
             //TODO(Totto): use input_type() != InputType:Touch
 #if not defined(__ANDROID__)
@@ -219,6 +233,14 @@ bool SimulatedTetrion::move_tetromino_right() {
     return with_lock_delay([&]() { return move(MoveDirection::Right); });
 }
 
+bool SimulatedTetrion::move_tetromino_to_wall_left() {
+    return with_lock_delay([&]() { return move_to_wall(MoveDirection::Left); });
+}
+
+bool SimulatedTetrion::move_tetromino_to_wall_right() {
+    return with_lock_delay([&]() { return move_to_wall(MoveDirection::Right); });
+}
+
 bool SimulatedTetrion::drop_tetromino(const SimulationStep simulation_step_index) {
     if (not m_active_tetromino.has_value()) {
         return false;
@@ -278,12 +300,122 @@ void SimulatedTetrion::hold_tetromino(const SimulationStep simulation_step_index
     return m_game_state == GameState::GameOver;
 }
 
+void SimulatedTetrion::write_render_snapshot(RenderSnapshot& snapshot) const {
+    snapshot.mino_stack = m_mino_stack;
+    snapshot.level = m_level;
+    snapshot.lines_cleared = m_lines_cleared;
+    snapshot.score = m_score;
+    snapshot.active_tetromino = m_active_tetromino;
+    snapshot.ghost_tetromino = m_ghost_tetromino;
+    snapshot.tetromino_on_hold = m_tetromino_on_hold;
+    snapshot.preview_tetrominos = m_preview_tetrominos;
+}
+
+void SimulatedTetrion::apply_render_snapshot(const RenderSnapshot& snapshot) {
+    const auto texts_changed = snapshot.level != m_level or snapshot.lines_cleared != m_lines_cleared
+                               or snapshot.score != m_score;
+
+    // the simulation that produced the snapshot doesn't have access to the service provider, so the side effects of reaching a new level have to be triggered here
+    for (auto level = m_level + 1; level <= snapshot.level; ++level) {
+        on_level_reached(level);
+    }
+
+    m_mino_stack = snapshot.mino_stack;
+    m_level = snapshot.level;
+    m_lines_cleared = snapshot.lines_cleared;
+    m_score = snapshot.score;
+    m_active_tetromino = snapshot.active_tetromino;
+    m_ghost_tetromino = snapshot.ghost_tetromino;
+    m_tetromino_on_hold = snapshot.tetromino_on_hold;
+    m_preview_tetrominos = snapshot.preview_tetrominos;
+
+    if (texts_changed) {
+        refresh_texts();
+    }
+}
+
+[[nodiscard]] SimulatedTetrion::State SimulatedTetrion::state() const {
+    State result{ .render = {},
+                  .is_accelerated_down_movement = m_is_accelerated_down_movement,
+                  .down_key_pressed = m_down_key_pressed,
+                  .allowed_to_hold = m_allowed_to_hold,
+                  .is_in_lock_delay = m_is_in_lock_delay,
+                  .num_executed_lock_delays = m_num_executed_lock_delays,
+                  .lock_delay_step_index = m_lock_delay_step_index,
+                  .random = m_random,
+                  .game_state = m_game_state,
+                  .sequence_index = m_sequence_index,
+                  .sequence_bags = m_sequence_bags,
+                  .next_gravity_simulation_step_index = m_next_gravity_simulation_step_index };
+    write_render_snapshot(result.render);
+    return result;
+}
+
+void SimulatedTetrion::write_state(State& state) const {
+    write_render_snapshot(state.render);
+    state.is_accelerated_down_movement = m_is_accelerated_down_movement;
+    state.down_key_pressed = m_down_key_pressed;
+    state.allowed_to_hold = m_allowed_to_hold;
+    state.is_in_lock_delay = m_is_in_lock_delay;
+    state.num_executed_lock_delays = m_num_executed_lock_delays;
+    state.lock_delay_step_index = m_lock_delay_step_index;
+    state.random = m_random;
+    state.game_state = m_game_state;
+    state.sequence_index = m_sequence_index;
+    state.sequence_bags = m_sequence_bags;
+    state.next_gravity_simulation_step_index = m_next_gravity_simulation_step_index;
+}
+
+void SimulatedTetrion::apply_state(const State& state) {
+    const auto texts_changed = state.render.level != m_level or state.render.lines_cleared != m_lines_cleared
+                               or state.render.score != m_score;
+
+    // this doesn't go through apply_render_snapshot, since rewinding must not trigger the side effects of reaching a level
+    m_mino_stack = state.render.mino_stack;
+    m_level = state.render.level;
+    m_lines_cleared = state.render.lines_cleared;
+    m_score = state.render.score;
+    m_active_tetromino = state.render.active_tetromino;
+    m_ghost_tetromino = state.render.ghost_tetromino;
+    m_tetromino_on_hold = state.render.tetromino_on_hold;
+    m_preview_tetrominos = state.render.preview_tetrominos;
+
+    m_is_accelerated_down_movement = state.is_accelerated_down_movement;
+    m_down_key_pressed = state.down_key_pressed;
+    m_allowed_to_hold = state.allowed_to_hold;
+    m_is_in_lock_delay = state.is_in_lock_delay;
+    m_num_executed_lock_delays = state.num_executed_lock_delays;
+    m_lock_delay_step_index = state.lock_delay_step_index;
+    m_random = state.random;
+    m_game_state = state.game_state;
+    m_sequence_index = state.sequence_index;
+    m_sequence_bags = state.sequence_bags;
+    m_next_gravity_simulation_step_index = state.next_gravity_simulation_step_index;
+
+    if (texts_changed) {
+        refresh_texts();
+    }
+}
+
 void SimulatedTetrion::reset_lock_delay(const SimulationStep simulation_step_index) {
     m_lock_delay_step_index = simulation_step_index + lock_delay;
 }
 
 void SimulatedTetrion::refresh_texts() { }
 
+void SimulatedTetrion::on_level_reached(const u32 level) {
+    if (level != constants::music_change_level or m_service_provider == nullptr) {
+        return;
+    }
+
+    m_service_provider->music_manager()
+            .load_and_play_music(
+                    utils::get_assets_folder() / "music"
+                    / utils::get_supported_music_extension("03. Game Theme (50 Left)")
+            )
+            .and_then(utils::log_error);
+}
+
 void SimulatedTetrion::clear_fully_occupied_lines() {
     bool cleared = false;
     const u32 lines_cleared_before = m_lines_cleared;
@@ -304,16 +436,7 @@ void SimulatedTetrion::clear_fully_occupied_lines() {
                 if (level > m_level) {
                     m_level = level;
                     spdlog::info("new level: {}", m_level);
-                    if (level == constants::music_change_level) {
-                        if (m_service_provider != nullptr) {
-                            m_service_provider->music_manager()
-                                    .load_and_play_music(
-                                            utils::get_assets_folder() / "music"
-                                            / utils::get_supported_music_extension("03. Game Theme (50 Left)")
-                                    )
-                                    .and_then(utils::log_error);
-                        }
-                    }
+                    on_level_reached(level);
                 }
                 m_mino_stack.clear_row_and_let_sink(static_cast<int>(row));
                 cleared = true;
@@ -322,6 +445,17 @@ void SimulatedTetrion::clear_fully_occupied_lines() {
         }
     } while (cleared);
     const u32 num_lines_cleared = m_lines_cleared - lines_cleared_before;
+
+    static auto& lines_cleared_counter =
+            metrics::Registry::global().counter("oopetris_lines_cleared_total", "lines cleared in all tetrions");
+    static auto& line_clears_counter = metrics::Registry::global().counter(
+            "oopetris_line_clears_total", "locks, that cleared at least one line, in all tetrions"
+    );
+    if (num_lines_cleared > 0) {
+        lines_cleared_counter.add(num_lines_cleared);
+        line_clears_counter.add();
+    }
+
     static constexpr std::array<u32, 5> score_per_line_multiplier{ 0, 40, 100, 300, 1200 };
     m_score += static_cast<u64>(score_per_line_multiplier.at(num_lines_cleared)) * static_cast<u64>(m_level + 1);
 }
@@ -331,6 +465,11 @@ void SimulatedTetrion::lock_active_tetromino(const SimulationStep simulation_ste
     for (const Mino& mino : m_active_tetromino->minos()) { // NOLINT(bugprone-unchecked-optional-access)
         m_mino_stack.set(mino.position(), mino.type());
     }
+
+    static auto& locks_counter =
+            metrics::Registry::global().counter("oopetris_tetromino_locks_total", "locked tetrominos in all tetrions");
+    locks_counter.add();
+
     m_allowed_to_hold = true;
     m_is_in_lock_delay = false;
     m_num_executed_lock_delays = 0;
@@ -519,6 +658,38 @@ bool SimulatedTetrion::move(const SimulatedTetrion::MoveDirection move_direction
     UNREACHABLE();
 }
 
+bool SimulatedTetrion::move_to_wall(const SimulatedTetrion::MoveDirection move_direction) {
+    if (not m_active_tetromino) {
+        return false;
+    }
+
+    const int direction = move_direction == MoveDirection::Left ? -1 : 1;
+
+    // every mino can only move along its own row, so the tetromino can move as far as the most blocked mino
+    int distance = grid::width_in_tiles;
+    for (const auto& mino : m_active_tetromino->minos()) {
+        const auto position = mino.position();
+
+        int mino_distance = 0;
+        for (int x = static_cast<int>(position.x) + direction; x >= 0 and x < static_cast<int>(grid::width_in_tiles);
+             x += direction) {
+            if (not is_valid_mino_position(GridPoint{ static_cast<u8>(x), position.y })) {
+                break;
+            }
+            ++mino_distance;
+        }
+
+        distance = std::min(distance, mino_distance);
+    }
+
+    if (distance == 0) {
+        return false;
+    }
+
+    m_active_tetromino->move(shapes::AbstractPoint<i8>{ static_cast<i8>(direction * distance), 0 });
+    return true;
+}
+
 std::optional<const SimulatedTetrion::WallKickTable*> SimulatedTetrion::get_wall_kick_table() const {
     assert(m_active_tetromino.has_value() and "no active tetromino");
     const auto type = m_active_tetromino->type(); // NOLINT(bugprone-unchecked-optional-access)
@@ -90,6 +90,34 @@ protected:
             m_service_provider; // NOLINT(misc-non-private-member-variables-in-classes,cppcoreguidelines-non-private-member-variables-in-classes)
 
 public:
+    // everything that is needed to render a tetrion, this is used to hand the state from the simulation thread to the render thread
+    struct RenderSnapshot {
+        MinoStack mino_stack;
+        u32 level{ 0 };
+        u32 lines_cleared{ 0 };
+        u64 score{ 0 };
+        std::optional<Tetromino> active_tetromino;
+        std::optional<Tetromino> ghost_tetromino;
+        std::optional<Tetromino> tetromino_on_hold;
+        std::array<std::optional<Tetromino>, num_preview_tetrominos> preview_tetrominos{};
+    };
+
+    // the complete simulation state, this is used to rewind a tetrion, e.g. for rollback netcode
+    struct State {
+        RenderSnapshot render;
+        bool is_accelerated_down_movement;
+        bool down_key_pressed;
+        bool allowed_to_hold;
+        bool is_in_lock_delay;
+        u32 num_executed_lock_delays;
+        u64 lock_delay_step_index;
+        Random random;
+        GameState game_state;
+        int sequence_index;
+        std::array<Bag, 2> sequence_bags;
+        u64 next_gravity_simulation_step_index;
+    };
+
     SimulatedTetrion(
             u8 tetrion_index,
             Random::Seed random_seed,
@@ -117,6 +145,8 @@ public:
     bool move_tetromino_down(MovementType movement_type, SimulationStep simulation_step_index);
     bool move_tetromino_left();
     bool move_tetromino_right();
+    bool move_tetromino_to_wall_left();
+    bool move_tetromino_to_wall_right();
     bool drop_tetromino(SimulationStep simulation_step_index);
     void hold_tetromino(SimulationStep simulation_step_index);
 
@@ -129,6 +159,16 @@ public:
 
     [[nodiscard]] bool is_game_over() const;
 
+    // writes into an existing snapshot, so that the allocations of it can be reused
+    void write_render_snapshot(RenderSnapshot& snapshot) const;
+    void apply_render_snapshot(const RenderSnapshot& snapshot);
+
+    [[nodiscard]] State state() const;
+    // writes into an existing state, so that the allocations of it can be reused
+    void write_state(State& state) const;
+    // the recording writer isn't rewound, so tetrions that are rewound shouldn't record anything
+    void apply_state(const State& state);
+
 private:
     template<typename Callable>
     bool with_lock_delay(Callable movement) {
@@ -141,9 +181,12 @@ private:
 
     bool rotate(RotationDirection rotation_direction);
     bool move(MoveDirection move_direction);
+    // moves as far as possible in one go, instead of one tile per call
+    bool move_to_wall(MoveDirection move_direction);
     [[nodiscard]] std::optional<const WallKickTable*> get_wall_kick_table() const;
     void reset_lock_delay(SimulationStep simulation_step_index);
     virtual void refresh_texts();
+    void on_level_reached(u32 level);
     void clear_fully_occupied_lines();
     void lock_active_tetromino(SimulationStep simulation_step_index);
     [[nodiscard]] bool is_active_tetromino_position_valid() const;
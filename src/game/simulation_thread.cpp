@@ -0,0 +1,158 @@
+#include <core/helper/utils.hpp>
+
+#include "input/replay_input.hpp"
+#include "simulation_thread.hpp"
+
+#include <cassert>
+#include <spdlog/spdlog.h>
+
+SimulationThread::SimulationThread(
+        ClockSource* const clock_source,
+        std::unique_ptr<SimulatedTetrion> tetrion,
+        std::shared_ptr<input::GameInput> input,
+        const u32 simulation_frequency,
+        CatchUpLimiter catch_up_limiter
+)
+    : m_clock_source{ clock_source },
+      m_tetrion{ std::move(tetrion) },
+      m_input{ std::move(input) },
+      m_step_duration{ std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds{ 1 })
+                       / simulation_frequency },
+      m_catch_up_limiter{ catch_up_limiter } {
+
+    assert(simulation_frequency >= 1);
+
+    // the render thread should be able to display the initial state, before the first step was simulated
+    m_tetrion->write_render_snapshot(m_frames.back().snapshot);
+    m_frames.publish();
+
+    // only called from the update of the input, which runs on the simulation thread, while the mutex is held
+    m_input->set_timestamp_mapper([this](std::chrono::nanoseconds age) {
+        return m_catch_up_limiter.target_step_index(m_clock_source->simulation_step_index_before(age));
+    });
+
+    m_thread = std::thread{ [this] { run(); } };
+}
+
+SimulationThread::~SimulationThread() {
+    m_is_running.store(false, std::memory_order_release);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    m_input->set_timestamp_mapper(nullptr);
+}
+
+void SimulationThread::update(SimulatedTetrion& render_tetrion) {
+    if (m_has_error.load(std::memory_order_acquire)) {
+        m_has_error.store(false, std::memory_order_relaxed);
+        m_is_game_finished = true;
+        std::rethrow_exception(m_error);
+    }
+
+    if (not m_frames.consume()) {
+        return;
+    }
+
+    const auto& frame = m_frames.front();
+    render_tetrion.apply_render_snapshot(frame.snapshot);
+    m_is_game_finished = frame.is_game_finished;
+}
+
+void SimulationThread::set_paused(const bool paused) {
+    const std::lock_guard lock{ m_mutex };
+
+    if (paused == m_is_paused) {
+        return;
+    }
+
+    m_is_paused = paused;
+
+    assert(m_clock_source->can_be_paused());
+    if (paused) {
+        m_clock_source->pause();
+    } else {
+        m_clock_source->resume();
+    }
+}
+
+[[nodiscard]] bool SimulationThread::is_game_finished() const {
+    return m_is_game_finished;
+}
+
+void SimulationThread::run() {
+    spdlog::debug("starting simulation thread");
+
+    // schedule against absolute deadlines, so that the time spent simulating doesn't add up
+    auto next_deadline = std::chrono::steady_clock::now();
+
+    while (m_is_running.load(std::memory_order_acquire)) {
+        try {
+            simulate_pending_steps();
+        } catch (...) {
+            m_error = std::current_exception();
+            m_has_error.store(true, std::memory_order_release);
+            break;
+        }
+
+        if (is_simulation_finished()) {
+            break;
+        }
+
+        next_deadline += m_step_duration;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (next_deadline < now) {
+            // we fell behind (e.g. a breakpoint), don't try to catch up on wake ups, the clock takes care of catching up on steps
+            next_deadline = now;
+        }
+
+        std::this_thread::sleep_until(next_deadline);
+    }
+
+    spdlog::debug("stopping simulation thread");
+}
+
+void SimulationThread::simulate_pending_steps() {
+    {
+        const std::lock_guard lock{ m_mutex };
+
+        if (m_is_paused) {
+            return;
+        }
+
+        const auto catch_up =
+                m_catch_up_limiter.limit(m_simulation_step_index, m_clock_source->simulation_step_index());
+        CatchUpLimiter::report(catch_up);
+
+        if (catch_up.steps == 0) {
+            return;
+        }
+
+        const auto target_step_index = m_simulation_step_index + catch_up.steps;
+        while (m_simulation_step_index < target_step_index and not is_simulation_finished()) {
+            ++m_simulation_step_index;
+            m_input->update(m_simulation_step_index);
+            m_tetrion->update_step(m_simulation_step_index);
+            m_input->late_update(m_simulation_step_index);
+        }
+    }
+
+    auto& frame = m_frames.back();
+    m_tetrion->write_render_snapshot(frame.snapshot);
+    frame.is_game_finished = is_simulation_finished();
+    m_frames.publish();
+}
+
+[[nodiscard]] bool SimulationThread::is_simulation_finished() const {
+    if (m_tetrion->is_game_over()) {
+        return true;
+    }
+
+    const auto input_as_replay = utils::is_child_class<input::ReplayGameInput>(m_input);
+    if (input_as_replay.has_value()) {
+        return input_as_replay.value()->is_end_of_recording();
+    }
+
+    return false;
+}
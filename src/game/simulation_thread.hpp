@@ -0,0 +1,75 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "catch_up_limiter.hpp"
+#include "helper/clock_source.hpp"
+#include "helper/triple_buffer.hpp"
+#include "input/game_input.hpp"
+#include "simulated_tetrion.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// runs the simulation and input handling of one tetrion at a fixed rate on its own thread
+// the render thread only ever sees immutable snapshots of the simulated tetrion, so rendering (and blocking in present with VSync) doesn't delay the simulation
+struct SimulationThread final {
+private:
+    struct Frame {
+        SimulatedTetrion::RenderSnapshot snapshot;
+        bool is_game_finished{ false };
+    };
+
+    ClockSource* m_clock_source;
+    std::unique_ptr<SimulatedTetrion> m_tetrion;
+    std::shared_ptr<input::GameInput> m_input;
+    std::chrono::nanoseconds m_step_duration;
+
+    // guards the clock source and the paused state, everything else is only accessed by the simulation thread
+    std::mutex m_mutex;
+    SimulationStep m_simulation_step_index{ 0 };
+    CatchUpLimiter m_catch_up_limiter;
+    bool m_is_paused{ false };
+
+    helper::TripleBuffer<Frame> m_frames;
+    std::atomic<bool> m_is_running{ true };
+    std::atomic<bool> m_has_error{ false };
+    std::exception_ptr m_error;
+
+    // only accessed by the render thread
+    bool m_is_game_finished{ false };
+
+    std::thread m_thread;
+
+public:
+    SimulationThread(
+            ClockSource* clock_source,
+            std::unique_ptr<SimulatedTetrion> tetrion,
+            std::shared_ptr<input::GameInput> input,
+            u32 simulation_frequency,
+            CatchUpLimiter catch_up_limiter
+    );
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    SimulationThread(SimulationThread&&) = delete;
+    SimulationThread& operator=(SimulationThread&&) = delete;
+
+    ~SimulationThread();
+
+    // render thread: applies the most recent snapshot to the tetrion, that is used for rendering
+    void update(SimulatedTetrion& render_tetrion);
+
+    void set_paused(bool paused);
+
+    [[nodiscard]] bool is_game_finished() const;
+
+private:
+    void run();
+    void simulate_pending_steps();
+    [[nodiscard]] bool is_simulation_finished() const;
+};
@@ -0,0 +1,222 @@
+#include "render_command_buffer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+
+namespace {
+
+    // SDL draws rects with a negative size mirrored, so the bounds have to be normalized for the overlap test
+    [[nodiscard]] SDL_Rect normalized(const SDL_Rect& rect) {
+        SDL_Rect result = rect;
+        if (result.w < 0) {
+            result.x += result.w;
+            result.w = -result.w;
+        }
+        if (result.h < 0) {
+            result.y += result.h;
+            result.h = -result.h;
+        }
+        return result;
+    }
+
+    [[nodiscard]] u32 batch_key(const Color& color) {
+        return (static_cast<u32>(color.r) << 24) | (static_cast<u32>(color.g) << 16) | (static_cast<u32>(color.b) << 8)
+               | static_cast<u32>(color.a);
+    }
+
+    // the rect covering all pixels from start to end
+    [[nodiscard]] SDL_Rect span(const SDL_Point& start, const SDL_Point& end) {
+        const auto min_x = std::min(start.x, end.x);
+        const auto min_y = std::min(start.y, end.y);
+        return SDL_Rect{ min_x, min_y, std::max(start.x, end.x) - min_x + 1, std::max(start.y, end.y) - min_y + 1 };
+    }
+
+} // namespace
+
+
+RenderCommandBuffer::RenderCommandBuffer(SDL_Renderer* renderer) : m_renderer{ renderer } {
+    reset_grid();
+}
+
+void RenderCommandBuffer::fill_rect(const SDL_Rect& rect, const Color& color) {
+    batch_for(color, normalized(rect)).rects.push_back(rect);
+}
+
+[[nodiscard]] bool RenderCommandBuffer::draw_rect_outline(const SDL_Rect& rect, const Color& color) {
+    if (rect.w <= 0 or rect.h <= 0) {
+        return false;
+    }
+
+    // the same pixels as SDL_RenderDrawRect, but every pixel is only covered once
+    fill_rect(SDL_Rect{ rect.x, rect.y, rect.w, 1 }, color);
+
+    if (rect.h > 1) {
+        fill_rect(SDL_Rect{ rect.x, rect.y + rect.h - 1, rect.w, 1 }, color);
+    }
+
+    if (rect.h > 2) {
+        fill_rect(SDL_Rect{ rect.x, rect.y + 1, 1, rect.h - 2 }, color);
+
+        if (rect.w > 1) {
+            fill_rect(SDL_Rect{ rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2 }, color);
+        }
+    }
+
+    return true;
+}
+
+void RenderCommandBuffer::draw_line(const SDL_Point& start, const SDL_Point& end, const Color& color) {
+
+    const auto delta_x = std::abs(end.x - start.x);
+    const auto delta_y = std::abs(end.y - start.y);
+    const auto step_x = end.x < start.x ? -1 : 1;
+    const auto step_y = end.y < start.y ? -1 : 1;
+
+    // the major axis advances every pixel, the minor axis only, when the error gets too big
+    const auto is_x_major = delta_x >= delta_y;
+    const auto major_delta = is_x_major ? delta_x : delta_y;
+    const auto minor_delta = is_x_major ? delta_y : delta_x;
+
+    // axis aligned lines never advance along the minor axis, so they are a single rect
+    auto span_start = start;
+    auto point = start;
+    auto error = (2 * minor_delta) - major_delta;
+
+    for (i32 i = 0; i < major_delta; ++i) {
+        if (error < 0) {
+            error += 2 * minor_delta;
+            if (is_x_major) {
+                point.x += step_x;
+            } else {
+                point.y += step_y;
+            }
+            continue;
+        }
+
+        fill_rect(span(span_start, point), color);
+
+        error += 2 * (minor_delta - major_delta);
+        point.x += step_x;
+        point.y += step_y;
+        span_start = point;
+    }
+
+    fill_rect(span(span_start, point), color);
+}
+
+void RenderCommandBuffer::draw_point(const SDL_Point& point, const Color& color) {
+    fill_rect(SDL_Rect{ point.x, point.y, 1, 1 }, color);
+}
+
+void RenderCommandBuffer::flush() {
+
+    if (m_used_batches == 0) {
+        return;
+    }
+
+    for (usize i = 0; i < m_used_batches; ++i) {
+        const auto& batch = m_batches.at(i);
+
+        SDL_SetRenderDrawColor(m_renderer, batch.color.r, batch.color.g, batch.color.b, batch.color.a);
+        SDL_RenderFillRects(m_renderer, batch.rects.data(), static_cast<int>(batch.rects.size()));
+    }
+
+    m_used_batches = 0;
+    m_last_batch_index.clear();
+    reset_grid();
+}
+
+[[nodiscard]] RenderCommandBuffer::Batch&
+RenderCommandBuffer::batch_for(const Color& color, const SDL_Rect& bounds) {
+
+    const auto has_area = bounds.w > 0 and bounds.h > 0;
+    const auto [first_cell, last_cell] = cell_range(bounds);
+
+    // the last batch, that contains a command overlapping this one, the command can't be moved in front of it
+    std::optional<usize> barrier = std::nullopt;
+
+    if (has_area) {
+        for (auto row = first_cell.y; row <= last_cell.y; ++row) {
+            for (auto column = first_cell.x; column <= last_cell.x; ++column) {
+                for (const auto& entry : m_grid.at(static_cast<usize>((row * m_grid_columns) + column))) {
+                    if (barrier.has_value() and entry.batch_index <= barrier.value()) {
+                        continue;
+                    }
+
+                    if (SDL_HasIntersection(&entry.bounds, &bounds) == SDL_TRUE) {
+                        barrier = entry.batch_index;
+                    }
+                }
+            }
+        }
+    }
+
+    const auto key = batch_key(color);
+
+    usize batch_index = 0;
+
+    if (const auto last_batch = m_last_batch_index.find(key);
+        last_batch != m_last_batch_index.end()
+        and (not barrier.has_value() or last_batch->second >= barrier.value())) {
+        batch_index = last_batch->second;
+    } else {
+        // reuse the allocations of previous frames
+        if (m_used_batches == m_batches.size()) {
+            m_batches.push_back(Batch{ .color = color, .rects = {} });
+        } else {
+            auto& batch = m_batches.at(m_used_batches);
+            batch.color = color;
+            batch.rects.clear();
+        }
+
+        batch_index = m_used_batches;
+        ++m_used_batches;
+        m_last_batch_index.insert_or_assign(key, batch_index);
+    }
+
+    if (has_area) {
+        for (auto row = first_cell.y; row <= last_cell.y; ++row) {
+            for (auto column = first_cell.x; column <= last_cell.x; ++column) {
+                m_grid.at(static_cast<usize>((row * m_grid_columns) + column))
+                        .push_back(GridEntry{ .bounds = bounds, .batch_index = batch_index });
+            }
+        }
+    }
+
+    return m_batches.at(batch_index);
+}
+
+[[nodiscard]] std::pair<SDL_Point, SDL_Point> RenderCommandBuffer::cell_range(const SDL_Rect& bounds) const {
+    // commands outside of the grid are clamped to the border cells, this keeps the overlap test correct, it only gets more conservative
+    const auto to_cell = [](i32 value, i32 cells) { return std::clamp(value / cell_size, 0, cells - 1); };
+
+    return {
+        SDL_Point{ to_cell(bounds.x, m_grid_columns), to_cell(bounds.y, m_grid_rows) },
+        SDL_Point{ to_cell(bounds.x + bounds.w - 1, m_grid_columns), to_cell(bounds.y + bounds.h - 1, m_grid_rows) }
+    };
+}
+
+void RenderCommandBuffer::reset_grid() {
+
+    int width = 0;
+    int height = 0;
+    if (SDL_GetRendererOutputSize(m_renderer, &width, &height) < 0) {
+        width = 0;
+        height = 0;
+    }
+
+    const auto columns = std::max<i32>((width + cell_size - 1) / cell_size, 1);
+    const auto rows = std::max<i32>((height + cell_size - 1) / cell_size, 1);
+
+    if (columns != m_grid_columns or rows != m_grid_rows) {
+        m_grid_columns = columns;
+        m_grid_rows = rows;
+        m_grid.assign(static_cast<usize>(columns) * static_cast<usize>(rows), {});
+        return;
+    }
+
+    for (auto& cell : m_grid) {
+        cell.clear();
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <core/helper/color.hpp>
+#include <core/helper/types.hpp>
+
+#include <SDL.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// records untextured draw commands and submits them in as few SDL calls as possible
+// commands with the same color are grouped into one batch, a command may be moved in front of earlier commands, if it doesn't overlap any of them, so the result is the same as drawing everything in order
+// lines, points and rect outlines are recorded as filled rects, so they end up in the same SDL_RenderFillRects call as the rects with the same color
+struct RenderCommandBuffer final {
+private:
+    struct Batch {
+        Color color;
+        std::vector<SDL_Rect> rects;
+    };
+
+    // an already recorded command in a cell of the overlap grid
+    struct GridEntry {
+        SDL_Rect bounds;
+        usize batch_index;
+    };
+
+    // the size of a cell in the overlap grid in pixels, every command is inserted into all cells, it touches, so that only commands in the same cells have to be checked for overlap
+    static constexpr i32 cell_size = 64;
+
+    SDL_Renderer* m_renderer;
+    // batches are reused between flushes, to keep their allocations, only the first m_used_batches are in use
+    std::vector<Batch> m_batches;
+    usize m_used_batches{ 0 };
+    // the index of the last batch of every color
+    std::unordered_map<u32, usize> m_last_batch_index;
+
+    i32 m_grid_columns{ 0 };
+    i32 m_grid_rows{ 0 };
+    std::vector<std::vector<GridEntry>> m_grid;
+
+public:
+    explicit RenderCommandBuffer(SDL_Renderer* renderer);
+
+    void fill_rect(const SDL_Rect& rect, const Color& color);
+
+    // returns false, if the outline can't be recorded, since it has no positive size, in that case nothing was recorded
+    [[nodiscard]] bool draw_rect_outline(const SDL_Rect& rect, const Color& color);
+
+    // SDL draws lines with Bresenham's algorithm, so the same pixels are recorded, merged into spans along the longer axis
+    void draw_line(const SDL_Point& start, const SDL_Point& end, const Color& color);
+
+    void draw_point(const SDL_Point& point, const Color& color);
+
+    // submits all recorded commands to SDL, this has to be called before anything else is drawn and before the render target changes
+    void flush();
+
+private:
+    [[nodiscard]] Batch& batch_for(const Color& color, const SDL_Rect& bounds);
+    [[nodiscard]] std::pair<SDL_Point, SDL_Point> cell_range(const SDL_Rect& bounds) const;
+    void reset_grid();
+};
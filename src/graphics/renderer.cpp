@@ -1,21 +1,23 @@
 #include <core/helper/errors.hpp>
 
+#include "helper/startup_timer.hpp"
 #include "renderer.hpp"
 
 
 //TODO(Totto):  assert return values of all sdl functions
 
-Renderer::Renderer(const Window& window, const VSync v_sync)
-    : m_renderer{ SDL_CreateRenderer(
-              window.get_sdl_window(),
-              -1,
-              (v_sync == VSync::Enabled ? SDL_RENDERER_PRESENTVSYNC : 0) | SDL_RENDERER_TARGETTEXTURE
+Renderer::Renderer(const Window& window, const VSync v_sync, const Batching batching) : m_renderer{ nullptr } {
+    const helper::startup::Phase phase{ "renderer creation" };
+
+    m_renderer = SDL_CreateRenderer(
+            window.get_sdl_window(), -1,
+            (v_sync == VSync::Enabled ? SDL_RENDERER_PRESENTVSYNC : 0) | SDL_RENDERER_TARGETTEXTURE
 #if defined(__3DS__) || defined(__SERENITY__)
-                      | SDL_RENDERER_SOFTWARE
+                    | SDL_RENDERER_SOFTWARE
 #else
-                      | SDL_RENDERER_ACCELERATED
+                    | SDL_RENDERER_ACCELERATED
 #endif
-      ) } {
+    );
 
     if (m_renderer == nullptr) {
         throw helper::InitializationError{ fmt::format("Failed creating a SDL Renderer: {}", SDL_GetError()) };
@@ -25,6 +27,10 @@ Renderer::Renderer(const Window& window, const VSync v_sync)
     if (result < 0) {
         throw helper::InitializationError{ fmt::format("Failed in setting BlendMode on Renderer: {}", SDL_GetError()) };
     }
+
+    if (batching == Batching::Enabled) {
+        m_command_buffer = std::make_unique<RenderCommandBuffer>(m_renderer);
+    }
 }
 
 Renderer::~Renderer() {
@@ -36,15 +42,65 @@ void Renderer::set_draw_color(const Color& color) const {
 }
 
 void Renderer::clear(const Color& clear_color) const {
+    flush();
     set_draw_color(clear_color);
     const int result = SDL_RenderClear(m_renderer);
     ASSERT(result == 0 && "render clear was executed without error");
 }
 
 void Renderer::present() const {
+    flush();
     SDL_RenderPresent(m_renderer);
 }
 
+void Renderer::flush() const {
+    if (m_command_buffer != nullptr) {
+        m_command_buffer->flush();
+    }
+}
+
+void Renderer::draw_rect_filled_impl(const SDL_Rect& rect, const Color& color) const {
+    if (m_command_buffer != nullptr) {
+        m_command_buffer->fill_rect(rect, color);
+        return;
+    }
+
+    set_draw_color(color);
+    SDL_RenderFillRect(m_renderer, &rect);
+}
+
+void Renderer::draw_rect_outline_impl(const SDL_Rect& rect, const Color& color) const {
+    if (m_command_buffer != nullptr) {
+        if (m_command_buffer->draw_rect_outline(rect, color)) {
+            return;
+        }
+        flush();
+    }
+
+    set_draw_color(color);
+    SDL_RenderDrawRect(m_renderer, &rect);
+}
+
+void Renderer::draw_line_impl(const SDL_Point& start, const SDL_Point& end, const Color& color) const {
+    if (m_command_buffer != nullptr) {
+        m_command_buffer->draw_line(start, end, color);
+        return;
+    }
+
+    set_draw_color(color);
+    SDL_RenderDrawLine(m_renderer, start.x, start.y, end.x, end.y);
+}
+
+void Renderer::draw_pixel_impl(const SDL_Point& location, const Color& color) const {
+    if (m_command_buffer != nullptr) {
+        m_command_buffer->draw_point(location, color);
+        return;
+    }
+
+    set_draw_color(color);
+    SDL_RenderDrawPoint(m_renderer, location.x, location.y);
+}
+
 Texture Renderer::load_image(const std::filesystem::path& image_path) const {
     return Texture::from_image(m_renderer, image_path);
 }
@@ -61,6 +117,8 @@ Texture Renderer::prerender_text(
 
 Texture Renderer::get_texture_for_render_target(const shapes::UPoint& size) const {
 
+    // this sets the new texture as render target
+    flush();
 
     const auto supported = SDL_RenderTargetSupported(m_renderer);
 
@@ -71,18 +129,40 @@ Texture Renderer::get_texture_for_render_target(const shapes::UPoint& size) cons
     return Texture::get_for_render_target(m_renderer, size);
 }
 
+Texture Renderer::get_texture_for_pixels(const shapes::UPoint& size) const {
+    return Texture::get_for_pixels(m_renderer, size);
+}
 
 void Renderer::set_render_target(const Texture& texture) const {
+    flush();
     texture.set_as_render_target(m_renderer);
 }
 
 void Renderer::reset_render_target() const {
+    flush();
     const auto result = SDL_SetRenderTarget(m_renderer, nullptr);
     if (result < 0) {
         throw helper::FatalError{ fmt::format("Failed to set render texture target with error: {}", SDL_GetError()) };
     }
 }
 
+void Renderer::set_viewport(const shapes::IRect& viewport) const {
+    flush();
+    const SDL_Rect viewport_sdl = viewport.to_sdl_rect();
+    const auto result = SDL_RenderSetViewport(m_renderer, &viewport_sdl);
+    if (result < 0) {
+        throw helper::FatalError{ fmt::format("Failed to set the viewport with error: {}", SDL_GetError()) };
+    }
+}
+
+void Renderer::reset_viewport() const {
+    flush();
+    const auto result = SDL_RenderSetViewport(m_renderer, nullptr);
+    if (result < 0) {
+        throw helper::FatalError{ fmt::format("Failed to reset the viewport with error: {}", SDL_GetError()) };
+    }
+}
+
 void Renderer::draw_self_computed_circle_impl(const shapes::IPoint& center, i32 diameter) const {
 
     //taken from: https://stackoverflow.com/questions/38334081/how-to-draw-circles-arcs-and-vector-graphics-in-sdl
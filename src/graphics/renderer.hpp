@@ -4,11 +4,13 @@
 
 #include "manager/font.hpp"
 #include "rect.hpp"
+#include "render_command_buffer.hpp"
 #include "texture.hpp"
 #include "window.hpp"
 
 #include <SDL.h>
 #include <filesystem>
+#include <memory>
 #include <string>
 
 struct Renderer final {
@@ -18,11 +20,18 @@ public:
         Disabled,
     };
 
+    // in the batched mode untextured draw calls are recorded and submitted together, see RenderCommandBuffer
+    enum class Batching : u8 {
+        Enabled,
+        Disabled,
+    };
+
 private:
     SDL_Renderer* m_renderer;
+    std::unique_ptr<RenderCommandBuffer> m_command_buffer;
 
 public:
-    explicit Renderer(const Window& window, VSync v_sync);
+    explicit Renderer(const Window& window, VSync v_sync, Batching batching = Batching::Disabled);
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
     ~Renderer();
@@ -32,48 +41,46 @@ public:
 
     template<typename T>
     void draw_rect_filled(const shapes::AbstractRect<T>& rect, const Color& color) const {
-        set_draw_color(color);
-        const SDL_Rect sdl_rect = rect.to_sdl_rect();
-        SDL_RenderFillRect(m_renderer, &sdl_rect);
+        draw_rect_filled_impl(rect.to_sdl_rect(), color);
     }
 
     template<typename T>
     void draw_rect_outline(const shapes::AbstractRect<T>& rect, const Color& color) const {
-        set_draw_color(color);
-        const SDL_Rect sdl_rect = rect.to_sdl_rect();
-        SDL_RenderDrawRect(m_renderer, &sdl_rect);
+        draw_rect_outline_impl(rect.to_sdl_rect(), color);
     }
 
     template<typename S, typename T>
     void draw_line(const shapes::AbstractPoint<S>& start, const shapes::AbstractPoint<T>& end, const Color& color)
             const {
-        set_draw_color(color);
-        SDL_RenderDrawLine(
-                m_renderer, static_cast<int>(start.x), static_cast<int>(start.y), static_cast<int>(end.x),
-                static_cast<int>(end.y)
+        draw_line_impl(
+                SDL_Point{ static_cast<int>(start.x), static_cast<int>(start.y) },
+                SDL_Point{ static_cast<int>(end.x), static_cast<int>(end.y) }, color
         );
     }
 
     template<typename S>
     void draw_pixel(const shapes::AbstractPoint<S>& location, const Color& color) const {
-        set_draw_color(color);
-        SDL_RenderDrawPoint(m_renderer, static_cast<int>(location.x), static_cast<int>(location.y));
+        draw_pixel_impl(SDL_Point{ static_cast<int>(location.x), static_cast<int>(location.y) }, color);
     }
 
     template<typename S>
     void draw_self_computed_circle(const shapes::AbstractPoint<S>& center, S diameter, const Color& color) const {
+        flush();
         set_draw_color(color);
         draw_self_computed_circle_impl(center.template cast<i32>(), static_cast<i32>(diameter));
     }
 
+    // textures are always drawn immediately, since their lifetime isn't bound to the frame, so everything recorded before has to be submitted first
     template<typename T>
     void draw_texture(const Texture& texture, const shapes::AbstractRect<T>& rect) const {
+        flush();
         texture.render(m_renderer, rect);
     }
 
     template<typename S, typename T>
     void draw_texture(const Texture& texture, const shapes::AbstractRect<S>& from, const shapes::AbstractRect<T>& to)
             const {
+        flush();
         texture.render(m_renderer, from, to);
     }
 
@@ -86,13 +93,25 @@ public:
             const Color& background_color = Color::black()
     ) const;
     [[nodiscard]] Texture get_texture_for_render_target(const shapes::UPoint& size) const;
+    [[nodiscard]] Texture get_texture_for_pixels(const shapes::UPoint& size) const;
 
     void set_render_target(const Texture& texture) const;
     void reset_render_target() const;
 
+    // everything drawn afterwards is moved to the top left of the viewport and clipped by it, until it is reset
+    void set_viewport(const shapes::IRect& viewport) const;
+    void reset_viewport() const;
+
 
     void present() const;
 
+    // submits all recorded draw calls, this is only needed, if something is drawn with SDL directly
+    void flush() const;
+
 private:
+    void draw_rect_filled_impl(const SDL_Rect& rect, const Color& color) const;
+    void draw_rect_outline_impl(const SDL_Rect& rect, const Color& color) const;
+    void draw_line_impl(const SDL_Point& start, const SDL_Point& end, const Color& color) const;
+    void draw_pixel_impl(const SDL_Point& location, const Color& color) const;
     void draw_self_computed_circle_impl(const shapes::IPoint& center, i32 diameter) const;
 };
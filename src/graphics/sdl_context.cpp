@@ -1,6 +1,7 @@
 #include <core/helper/errors.hpp>
 
 #include "graphics/sdl_context.hpp"
+#include "helper/startup_timer.hpp"
 
 #include <SDL.h>
 #include <SDL_ttf.h>
@@ -17,6 +18,8 @@
 #endif
 
 SdlContext::SdlContext() {
+    const helper::startup::Phase phase{ "SDL init" };
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         throw helper::InitializationError{ fmt::format("Failed in initializing sdl: {}", SDL_GetError()) };
     }
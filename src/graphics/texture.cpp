@@ -1,13 +1,17 @@
+#include <core/helper/metrics.hpp>
 #include <core/helper/point.hpp>
 
+#include "helper/asset_archive.hpp"
 #include "helper/graphic_utils.hpp"
 #include "texture.hpp"
 
+#include <cassert>
+
 
 Texture::Texture(SDL_Texture* raw_texture) : m_raw_texture{ raw_texture } { }
 
 Texture Texture::from_image(SDL_Renderer* renderer, const std::filesystem::path& image_path) {
-    SDL_Texture* image = IMG_LoadTexture(renderer, image_path.string().c_str());
+    SDL_Texture* image = IMG_LoadTexture_RW(renderer, helper::assets::open(image_path), 1);
 
     if (image == nullptr) {
         throw std::runtime_error(
@@ -49,6 +53,10 @@ Texture Texture::prerender_text(
         throw std::runtime_error(fmt::format("Failed to pre-render text into texture with error: {}", SDL_GetError()));
     }
 
+    static auto& text_textures_counter = metrics::Registry::global().counter(
+            "oopetris_text_textures_created_total", "textures created by Texture::prerender_text"
+    );
+    text_textures_counter.add();
 
     return Texture{ texture };
 }
@@ -77,6 +85,18 @@ Texture Texture::get_for_render_target(SDL_Renderer* renderer, const shapes::UPo
     return Texture{ texture };
 }
 
+Texture Texture::get_for_pixels(SDL_Renderer* renderer, const shapes::UPoint& size) {
+
+    auto* const texture = SDL_CreateTexture(
+            renderer, pixel_format, SDL_TEXTUREACCESS_STATIC, static_cast<int>(size.x), static_cast<int>(size.y)
+    );
+    if (texture == nullptr) {
+        throw std::runtime_error(fmt::format("Failed to create texture with error: {}", SDL_GetError()));
+    }
+
+    return Texture{ texture };
+}
+
 Texture::Texture(Texture&& old) noexcept : m_raw_texture{ old.m_raw_texture } {
     old.m_raw_texture = nullptr;
 };
@@ -110,6 +130,18 @@ Texture::~Texture() {
     return size.cast<u32>();
 }
 
+void Texture::update_pixels(std::span<const u32> pixels) {
+    const auto texture_size = size();
+    assert(pixels.size() == static_cast<usize>(texture_size.x) * static_cast<usize>(texture_size.y));
+
+    const auto result = SDL_UpdateTexture(
+            m_raw_texture, nullptr, pixels.data(), static_cast<int>(texture_size.x * sizeof(u32))
+    );
+    if (result < 0) {
+        throw std::runtime_error(fmt::format("Failed to update texture pixels with error: {}", SDL_GetError()));
+    }
+}
+
 void Texture::set_as_render_target(SDL_Renderer* renderer) const {
     const auto result = SDL_SetRenderTarget(renderer, m_raw_texture);
     if (result < 0) {
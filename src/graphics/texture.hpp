@@ -13,6 +13,7 @@
 #include <SDL_image.h>
 #include <filesystem>
 #include <fmt/format.h>
+#include <span>
 #include <spdlog/spdlog.h>
 #include <string>
 
@@ -25,6 +26,14 @@ private:
     explicit Texture(SDL_Texture* raw_texture);
 
 public:
+    // the format of textures created by get_for_pixels, every pixel is one u32 in native endianness
+    static constexpr u32 pixel_format = SDL_PIXELFORMAT_ARGB8888;
+
+    [[nodiscard]] static constexpr u32 to_pixel(const Color& color) {
+        return (static_cast<u32>(color.a) << 24) | (static_cast<u32>(color.r) << 16)
+               | (static_cast<u32>(color.g) << 8) | static_cast<u32>(color.b);
+    }
+
     static Texture from_image(SDL_Renderer* renderer, const std::filesystem::path& image_path);
 
     static Texture prerender_text(
@@ -38,6 +47,8 @@ public:
 
     static Texture get_for_render_target(SDL_Renderer* renderer, const shapes::UPoint& size);
 
+    static Texture get_for_pixels(SDL_Renderer* renderer, const shapes::UPoint& size);
+
     Texture(const Texture&) = delete;
     Texture& operator=(const Texture&) = delete;
 
@@ -63,4 +74,7 @@ public:
     [[nodiscard]] shapes::UPoint size() const;
 
     void set_as_render_target(SDL_Renderer* renderer) const;
+
+    // uploads all pixels at once, the rows have to be tightly packed in the format of pixel_format
+    void update_pixels(std::span<const u32> pixels);
 };
@@ -0,0 +1,397 @@
+#include <core/helper/expected.hpp>
+#include <core/helper/utils.hpp>
+
+#include "helper/asset_archive.hpp"
+#include "helper/asset_archive_format.hpp"
+#include "helper/asset_archive_index.hpp"
+#include "helper/graphic_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fmt/format.h>
+#include <memory>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#if defined(__CONSOLE__)
+#include <fstream>
+#include <mutex>
+#elif defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    using asset_archive::Entry;
+
+#if !defined(__CONSOLE__)
+
+    // the whole archive mapped read-only into memory, the pages are only read from disk, when they are accessed
+    struct MappedFile final {
+    private:
+        const std::byte* m_data{ nullptr };
+        usize m_size{ 0 };
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+#endif
+
+        MappedFile() = default;
+
+    public:
+        [[nodiscard]] static helper::expected<std::shared_ptr<const MappedFile>, std::string> map(
+                const std::filesystem::path& path
+        ) {
+            auto result = std::shared_ptr<MappedFile>{ new MappedFile{} };
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+            result->m_file = CreateFileW(
+                    path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+            );
+            if (result->m_file == INVALID_HANDLE_VALUE) {
+                return helper::unexpected<std::string>{ fmt::format("unable to open: error {}", GetLastError()) };
+            }
+
+            LARGE_INTEGER size{};
+            if (GetFileSizeEx(result->m_file, &size) == 0) {
+                return helper::unexpected<std::string>{ fmt::format("unable to get the size: error {}", GetLastError())
+                };
+            }
+            result->m_size = static_cast<usize>(size.QuadPart);
+
+            result->m_mapping = CreateFileMappingW(result->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (result->m_mapping == nullptr) {
+                return helper::unexpected<std::string>{ fmt::format("unable to map: error {}", GetLastError()) };
+            }
+
+            const auto* const data = MapViewOfFile(result->m_mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data == nullptr) {
+                return helper::unexpected<std::string>{ fmt::format("unable to map: error {}", GetLastError()) };
+            }
+            result->m_data = static_cast<const std::byte*>(data);
+#else
+            const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); //NOLINT(cppcoreguidelines-pro-type-vararg)
+            if (file < 0) {
+                return helper::unexpected<std::string>{ fmt::format("unable to open: {}", std::strerror(errno)) };
+            }
+
+            struct stat file_stat { };
+            if (fstat(file, &file_stat) != 0) {
+                ::close(file);
+                return helper::unexpected<std::string>{ fmt::format("unable to get the size: {}", std::strerror(errno))
+                };
+            }
+            result->m_size = static_cast<usize>(file_stat.st_size);
+
+            // the mapping stays valid after closing the file descriptor
+            void* const data = mmap(nullptr, result->m_size, PROT_READ, MAP_PRIVATE, file, 0);
+            ::close(file);
+
+            if (data == MAP_FAILED) { //NOLINT(cppcoreguidelines-pro-type-cstyle-cast,performance-no-int-to-ptr)
+                return helper::unexpected<std::string>{ fmt::format("unable to map: {}", std::strerror(errno)) };
+            }
+            result->m_data = static_cast<const std::byte*>(data);
+#endif
+
+            return result;
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        ~MappedFile() {
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+            if (m_data != nullptr) {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping != nullptr) {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_file);
+            }
+#else
+            if (m_data != nullptr) {
+                munmap(const_cast<std::byte*>(m_data), m_size); //NOLINT(cppcoreguidelines-pro-type-const-cast)
+            }
+#endif
+        }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const {
+            return { m_data, m_size };
+        }
+    };
+
+#endif
+
+    struct Archive {
+        std::filesystem::path path;
+        asset_archive::Index entries;
+#if defined(__CONSOLE__)
+        // there is no mmap, so every entry is read on open, the file is kept open, so that it isn't searched in the file system every time
+        std::mutex file_mutex;
+        std::ifstream file;
+#else
+        std::shared_ptr<const MappedFile> mapping;
+#endif
+    };
+
+    [[nodiscard]] std::unique_ptr<Archive>& global_archive() {
+        static std::unique_ptr<Archive> instance{ nullptr };
+        return instance;
+    }
+
+    [[nodiscard]] helper::expected<std::unique_ptr<Archive>, std::string> load_archive(const std::filesystem::path& path
+    ) {
+        auto archive = std::make_unique<Archive>();
+        archive->path = path;
+
+#if defined(__CONSOLE__)
+        archive->file.open(path, std::ios::in | std::ios::binary);
+        if (not archive->file) {
+            return helper::unexpected<std::string>{ "unable to open" };
+        }
+
+        const auto file_size = std::filesystem::file_size(path);
+
+        std::vector<std::byte> bytes(asset_archive::header_size);
+        archive->file.read(
+                reinterpret_cast<char*>(bytes.data()), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                static_cast<std::streamsize>(bytes.size())
+        );
+
+        const auto index_size = asset_archive::parse_header(bytes);
+        if (not index_size.has_value()) {
+            return helper::unexpected<std::string>{ index_size.error() };
+        }
+
+        bytes.resize(asset_archive::header_size + index_size.value());
+        archive->file.read(
+                reinterpret_cast<char*>(bytes.data() + asset_archive::header_size), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                static_cast<std::streamsize>(index_size.value())
+        );
+        if (not archive->file) {
+            return helper::unexpected<std::string>{ "index is truncated" };
+        }
+        const std::span<const std::byte> index_bytes{ bytes };
+#else
+        auto mapping = MappedFile::map(path);
+        if (not mapping.has_value()) {
+            return helper::unexpected<std::string>{ mapping.error() };
+        }
+        archive->mapping = std::move(mapping.value());
+
+        const auto bytes = archive->mapping->bytes();
+        const auto file_size = bytes.size();
+
+        const auto index_size = asset_archive::parse_header(bytes);
+        if (not index_size.has_value()) {
+            return helper::unexpected<std::string>{ index_size.error() };
+        }
+
+        // the whole file is mapped, but only the header and the index may be parsed as index
+        const auto index_end = asset_archive::header_size + index_size.value();
+        if (index_end > file_size) {
+            return helper::unexpected<std::string>{ "index is truncated" };
+        }
+        const auto index_bytes = bytes.first(index_end);
+#endif
+
+        auto entries = asset_archive::parse_index(index_bytes, file_size);
+        if (not entries.has_value()) {
+            return helper::unexpected<std::string>{ entries.error() };
+        }
+        archive->entries = std::move(entries.value());
+
+        return archive;
+    }
+
+    [[nodiscard]] std::optional<Entry> find_entry(const std::filesystem::path& path) {
+        const auto& archive = global_archive();
+        if (archive == nullptr) {
+            return std::nullopt;
+        }
+
+        // the callers use paths, that start with the assets folder, the archive index is relative to it
+        const auto relative = path.lexically_normal().lexically_relative(utils::get_assets_folder().lexically_normal());
+        if (relative.empty() or *relative.begin() == "..") {
+            return std::nullopt;
+        }
+
+        const auto entry = archive->entries.find(relative.generic_string());
+        if (entry == archive->entries.end()) {
+            return std::nullopt;
+        }
+
+        return entry->second;
+    }
+
+
+    // a read-only SDL stream over memory, that keeps its owner (the mapping or a buffer) alive, until it is closed
+    // SDL_RWFromConstMem can't be used, since fonts and music read from the stream as long as they exist, which may be longer than the archive
+    struct MemoryStream {
+        std::shared_ptr<const void> owner;
+        const std::byte* data;
+        Sint64 size;
+        Sint64 position;
+    };
+
+    [[nodiscard]] MemoryStream& get_stream(SDL_RWops* context) {
+        return *static_cast<MemoryStream*>(context->hidden.unknown.data1);
+    }
+
+    Sint64 SDLCALL stream_size(SDL_RWops* context) {
+        return get_stream(context).size;
+    }
+
+    Sint64 SDLCALL stream_seek(SDL_RWops* context, Sint64 offset, int whence) {
+        auto& stream = get_stream(context);
+
+        Sint64 base = 0;
+        switch (whence) {
+            case RW_SEEK_SET:
+                base = 0;
+                break;
+            case RW_SEEK_CUR:
+                base = stream.position;
+                break;
+            case RW_SEEK_END:
+                base = stream.size;
+                break;
+            default:
+                return SDL_SetError("unknown value for 'whence'");
+        }
+
+        const auto position = base + offset;
+        if (position < 0 or position > stream.size) {
+            return SDL_SetError("seek out of bounds");
+        }
+
+        stream.position = position;
+        return position;
+    }
+
+    size_t SDLCALL stream_read(SDL_RWops* context, void* destination, size_t size, size_t max_amount) {
+        auto& stream = get_stream(context);
+
+        if (size == 0 or max_amount == 0) {
+            return 0;
+        }
+
+        const auto available = static_cast<size_t>(stream.size - stream.position);
+        const auto amount = std::min(max_amount, available / size);
+
+        std::memcpy(destination, stream.data + stream.position, amount * size);
+        stream.position += static_cast<Sint64>(amount * size);
+
+        return amount;
+    }
+
+    size_t SDLCALL
+    stream_write(SDL_RWops* /* context */, const void* /* source */, size_t /* size */, size_t /* amount */) {
+        SDL_SetError("assets are read-only");
+        return 0;
+    }
+
+    int SDLCALL stream_close(SDL_RWops* context) {
+        delete &get_stream(context); //NOLINT(cppcoreguidelines-owning-memory)
+        SDL_FreeRW(context);
+        return 0;
+    }
+
+    [[nodiscard]] SDL_RWops* open_stream(std::shared_ptr<const void> owner, std::span<const std::byte> bytes) {
+        SDL_RWops* const result = SDL_AllocRW();
+        if (result == nullptr) {
+            return nullptr;
+        }
+
+        result->size = stream_size;
+        result->seek = stream_seek;
+        result->read = stream_read;
+        result->write = stream_write;
+        result->close = stream_close;
+        result->type = SDL_RWOPS_UNKNOWN;
+        result->hidden.unknown.data1 = new MemoryStream{ //NOLINT(cppcoreguidelines-owning-memory)
+            .owner = std::move(owner),
+            .data = bytes.data(),
+            .size = static_cast<Sint64>(bytes.size()),
+            .position = 0,
+        };
+
+        return result;
+    }
+
+} // namespace
+
+
+void helper::assets::initialize() {
+    auto assets_folder = utils::get_assets_folder();
+    if (not assets_folder.has_filename()) {
+        assets_folder = assets_folder.parent_path();
+    }
+
+    auto archive_path = assets_folder;
+    archive_path += asset_archive::file_extension;
+
+    if (not std::filesystem::exists(archive_path)) {
+        spdlog::debug("no asset archive at \"{}\", using the loose files", archive_path.string());
+        return;
+    }
+
+    auto archive = load_archive(archive_path);
+    if (not archive.has_value()) {
+        spdlog::warn(
+                "unable to load asset archive \"{}\", using the loose files: {}", archive_path.string(), archive.error()
+        );
+        return;
+    }
+
+    spdlog::info("using asset archive \"{}\" with {} files", archive_path.string(), archive.value()->entries.size());
+    global_archive() = std::move(archive.value());
+}
+
+[[nodiscard]] bool helper::assets::exists(const std::filesystem::path& path) {
+    return find_entry(path).has_value() or std::filesystem::exists(path);
+}
+
+[[nodiscard]] SDL_RWops* helper::assets::open(const std::filesystem::path& path) {
+    const auto entry = find_entry(path);
+    if (not entry.has_value()) {
+        return SDL_RWFromFile(path.string().c_str(), "rb");
+    }
+
+    auto& archive = *global_archive();
+
+#if defined(__CONSOLE__)
+    auto buffer = std::make_shared<std::vector<std::byte>>(entry->size);
+    {
+        const std::lock_guard lock{ archive.file_mutex };
+        archive.file.clear();
+        archive.file.seekg(static_cast<std::streamoff>(entry->offset));
+        archive.file.read(
+                reinterpret_cast<char*>(buffer->data()), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                static_cast<std::streamsize>(buffer->size())
+        );
+        if (not archive.file) {
+            SDL_SetError("unable to read \"%s\" from the asset archive", path.string().c_str());
+            return nullptr;
+        }
+    }
+
+    const std::span<const std::byte> bytes{ *buffer };
+    return open_stream(std::move(buffer), bytes);
+#else
+    return open_stream(archive.mapping, archive.mapping->bytes().subspan(entry->offset, entry->size));
+#endif
+}
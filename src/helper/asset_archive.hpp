@@ -0,0 +1,20 @@
+#pragma once
+
+#include <SDL.h>
+#include <filesystem>
+
+// assets can optionally be packed into a single archive (see the 'asset_archive' build option), which is memory mapped, instead of opening every file separately
+// all functions fall back to the loose files in the assets folder, if there is no archive or the file isn't in it
+namespace helper::assets {
+
+    // opens the archive next to the assets folder, if it exists
+    // this has to be called once, before any asset is loaded, afterwards the archive is read-only, so the other functions are thread safe
+    void initialize();
+
+    [[nodiscard]] bool exists(const std::filesystem::path& path);
+
+    // returns nullptr and sets the SDL error on failure, like SDL_RWFromFile
+    // the returned stream stays valid, until it is closed, so it can be passed with freesrc = 1 to all *_RW functions
+    [[nodiscard]] SDL_RWops* open(const std::filesystem::path& path);
+
+} // namespace helper::assets
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+#include <core/helper/utils.hpp>
+
+#include <array>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// the layout of the packed asset archive, this is shared by the packer (a native build tool) and the loader, so it may only depend on header only core files
+// all integers are little endian
+//
+// header:  magic (4 bytes), version (u32), entry count (u32), index size in bytes (u32)
+// index:   per entry: offset (u64, from the start of the file), size (u64), path length (u16), path (utf-8, '/' separated, relative to the assets folder)
+// data:    the file contents, every entry starts at a multiple of data_alignment
+namespace asset_archive {
+
+    constexpr std::array<char, 4> magic{ 'O', 'P', 'A', 'K' };
+
+    constexpr u32 version = 1;
+
+    constexpr usize header_size = magic.size() + (3 * sizeof(u32));
+
+    constexpr usize data_alignment = 16;
+
+    // the archive is placed next to the assets folder and named like it, with this extension
+    constexpr auto file_extension = ".pak";
+
+    struct IndexEntry {
+        std::string path;
+        u64 size;
+        u64 offset;
+    };
+
+    template<utils::integral T>
+    void write_integer(std::ostream& stream, T value) {
+        const auto little_endian = utils::to_little_endian(value);
+        stream.write(
+                reinterpret_cast<const char*>(&little_endian), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                sizeof(T)
+        );
+    }
+
+    [[nodiscard]] constexpr u64 align(u64 value) {
+        return (value + data_alignment - 1) / data_alignment * data_alignment;
+    }
+
+    // assigns the offsets of the entries and writes the header and the index, the data of every entry has to be written at its offset afterwards
+    // throws a std::runtime_error, if the entries don't fit into one archive
+    inline void write_index(std::ostream& stream, std::vector<IndexEntry>& entries) {
+        usize index_size = 0;
+        for (const auto& entry : entries) {
+            if (entry.path.size() > std::numeric_limits<u16>::max()) {
+                throw std::runtime_error("path is too long: " + entry.path);
+            }
+            index_size += (2 * sizeof(u64)) + sizeof(u16) + entry.path.size();
+        }
+
+        if (index_size > std::numeric_limits<u32>::max()) {
+            throw std::runtime_error("too many files for one archive");
+        }
+
+        u64 offset = align(header_size + index_size);
+        for (auto& entry : entries) {
+            entry.offset = offset;
+            offset = align(offset + entry.size);
+        }
+
+        stream.write(magic.data(), magic.size());
+        write_integer<u32>(stream, version);
+        write_integer<u32>(stream, static_cast<u32>(entries.size()));
+        write_integer<u32>(stream, static_cast<u32>(index_size));
+
+        for (const auto& entry : entries) {
+            write_integer<u64>(stream, entry.offset);
+            write_integer<u64>(stream, entry.size);
+            write_integer<u16>(stream, static_cast<u16>(entry.path.size()));
+            stream.write(entry.path.data(), static_cast<std::streamsize>(entry.path.size()));
+        }
+    }
+
+} // namespace asset_archive
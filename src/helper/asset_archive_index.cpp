@@ -0,0 +1,88 @@
+
+#include <core/helper/utils.hpp>
+
+#include "helper/asset_archive_format.hpp"
+#include "helper/asset_archive_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <optional>
+#include <tuple>
+
+namespace {
+
+    template<utils::integral T>
+    [[nodiscard]] std::optional<T> read_integer(std::span<const std::byte> bytes, usize& offset) {
+        if (offset + sizeof(T) > bytes.size()) {
+            return std::nullopt;
+        }
+
+        T value{};
+        std::memcpy(&value, bytes.subspan(offset, sizeof(T)).data(), sizeof(T));
+        offset += sizeof(T);
+        return utils::from_little_endian(value);
+    }
+
+} // namespace
+
+
+[[nodiscard]] helper::expected<u32, std::string> asset_archive::parse_header(std::span<const std::byte> bytes) {
+    if (bytes.size() < header_size) {
+        return helper::unexpected<std::string>{ "file is too small" };
+    }
+
+    if (std::memcmp(bytes.data(), magic.data(), magic.size()) != 0) {
+        return helper::unexpected<std::string>{ "invalid magic" };
+    }
+
+    usize offset = magic.size();
+    const auto read_version = read_integer<u32>(bytes, offset);
+    std::ignore = read_integer<u32>(bytes, offset);
+    const auto index_size = read_integer<u32>(bytes, offset);
+
+    if (read_version != version) {
+        return helper::unexpected<std::string>{
+            fmt::format("unsupported version {}, expected {}", read_version.value_or(0), version)
+        };
+    }
+
+    return index_size.value_or(0);
+}
+
+[[nodiscard]] helper::expected<asset_archive::Index, std::string>
+asset_archive::parse_index(std::span<const std::byte> bytes, u64 file_size) {
+    usize offset = magic.size() + sizeof(u32);
+    const auto entry_count = read_integer<u32>(bytes, offset);
+    if (not entry_count.has_value()) {
+        return helper::unexpected<std::string>{ "file is too small" };
+    }
+    offset = header_size;
+
+    Index entries{};
+    // every entry needs at least its fixed size fields, so a corrupt count can't reserve more than the index could hold
+    entries.reserve(std::min<usize>(entry_count.value(), bytes.size() / ((2 * sizeof(u64)) + sizeof(u16))));
+
+    for (u32 i = 0; i < entry_count.value(); ++i) {
+        const auto entry_offset = read_integer<u64>(bytes, offset);
+        const auto entry_size = read_integer<u64>(bytes, offset);
+        const auto path_length = read_integer<u16>(bytes, offset);
+
+        if (not entry_offset.has_value() or not entry_size.has_value() or not path_length.has_value()
+            or offset + path_length.value() > bytes.size()) {
+            return helper::unexpected<std::string>{ fmt::format("index entry {} is truncated", i) };
+        }
+
+        if (entry_offset.value() > file_size or entry_size.value() > file_size - entry_offset.value()) {
+            return helper::unexpected<std::string>{ fmt::format("index entry {} is out of bounds", i) };
+        }
+
+        std::string path(path_length.value(), '\0');
+        std::memcpy(path.data(), bytes.subspan(offset, path_length.value()).data(), path_length.value());
+        offset += path_length.value();
+
+        entries.insert_or_assign(std::move(path), Entry{ .offset = entry_offset.value(), .size = entry_size.value() });
+    }
+
+    return entries;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/types.hpp>
+
+#include <span>
+#include <string>
+#include <unordered_map>
+
+// parsing of the header and index of a packed asset archive (see asset_archive_format.hpp), this never reads past the given bytes
+namespace asset_archive {
+
+    struct Entry {
+        u64 offset;
+        u64 size;
+    };
+
+    using Index = std::unordered_map<std::string, Entry>;
+
+    // returns the size of the index, so that it can be read at once
+    [[nodiscard]] helper::expected<u32, std::string> parse_header(std::span<const std::byte> bytes);
+
+    // the bytes have to contain the header and the index, the entries are checked against the file size
+    [[nodiscard]] helper::expected<Index, std::string> parse_index(std::span<const std::byte> bytes, u64 file_size);
+
+} // namespace asset_archive
@@ -3,6 +3,7 @@
 #include <SDL.h>
 #include <cassert>
 #include <spdlog/spdlog.h>
+#include <utility>
 
 namespace {
     [[nodiscard]] double elapsed_time() {
@@ -23,6 +24,14 @@ LocalClock::LocalClock(const u32 target_frequency)
     return static_cast<SimulationStep>(time_since_start / m_step_duration);
 }
 
+[[nodiscard]] SimulationStep LocalClock::simulation_step_index_before(const std::chrono::nanoseconds age) const {
+    const auto time = m_paused_at.value_or(elapsed_time()) - std::chrono::duration<double>(age).count();
+    if (time <= m_start_time) {
+        return 0;
+    }
+    return static_cast<SimulationStep>((time - m_start_time) / m_step_duration);
+}
+
 bool LocalClock::can_be_paused() {
     return true;
 }
@@ -45,3 +54,162 @@ double LocalClock::resume() {
     spdlog::info("resuming clock (duration of pause: {} s)", duration);
     return duration;
 }
+
+HighResolutionClock::HighResolutionClock(const u32 target_frequency, TimeSource time_source)
+    : m_time_source{ std::move(time_source) },
+      m_start_time{ m_time_source() },
+      m_target_frequency{ target_frequency } {
+    assert(target_frequency >= 1);
+}
+
+[[nodiscard]] SimulationStep HighResolutionClock::simulation_step_index() const {
+    return simulation_step_index_at(m_paused_at.value_or(m_time_source()));
+}
+
+[[nodiscard]] SimulationStep HighResolutionClock::simulation_step_index_before(const std::chrono::nanoseconds age
+) const {
+    return simulation_step_index_at(m_paused_at.value_or(m_time_source()) - age);
+}
+
+[[nodiscard]] SimulationStep HighResolutionClock::simulation_step_index_at(const Clock::time_point time) const {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_start_time).count();
+    if (elapsed <= 0) {
+        return 0;
+    }
+
+    // split into whole seconds and the rest, so that the multiplication can't overflow
+    constexpr u64 nanoseconds_per_second = 1'000'000'000;
+    const auto nanoseconds = static_cast<u64>(elapsed);
+    return ((nanoseconds / nanoseconds_per_second) * m_target_frequency)
+           + ((nanoseconds % nanoseconds_per_second) * m_target_frequency / nanoseconds_per_second);
+}
+
+bool HighResolutionClock::can_be_paused() {
+    return true;
+}
+
+void HighResolutionClock::pause() {
+    if (m_paused_at) {
+        throw std::runtime_error("cannot pause if already paused");
+    }
+    m_paused_at = m_time_source();
+    spdlog::info("pausing clock");
+}
+
+double HighResolutionClock::resume() {
+    if (not m_paused_at) {
+        throw std::runtime_error("must have been paused before to be able to resume");
+    }
+    const auto duration = m_time_source() - *m_paused_at;
+    m_start_time += duration;
+    m_paused_at = std::nullopt;
+
+    const auto seconds = std::chrono::duration<double>(duration).count();
+    spdlog::info("resuming clock (duration of pause: {} s)", seconds);
+    return seconds;
+}
+
+
+ScaledClock::ScaledClock(const u32 target_frequency, const double speed, TimeSource time_source)
+    : m_time_source{ std::move(time_source) },
+      m_target_frequency{ target_frequency },
+      m_speed{ speed },
+      m_segment_start_time{ m_time_source() } {
+    assert(target_frequency >= 1);
+    if (speed <= 0.0) {
+        throw std::invalid_argument("the speed of a clock has to be greater than 0");
+    }
+}
+
+[[nodiscard]] ScaledClock::Clock::time_point ScaledClock::current_time() const {
+    return m_paused_at.value_or(m_time_source());
+}
+
+void ScaledClock::set_speed(const double speed) {
+    if (speed <= 0.0) {
+        throw std::invalid_argument("the speed of a clock has to be greater than 0");
+    }
+
+    m_segment_start_step = simulation_step_index();
+    m_segment_start_time = current_time();
+    m_speed = speed;
+}
+
+[[nodiscard]] double ScaledClock::speed() const {
+    return m_speed;
+}
+
+[[nodiscard]] SimulationStep ScaledClock::simulation_step_index() const {
+    return simulation_step_index_at(current_time());
+}
+
+[[nodiscard]] SimulationStep ScaledClock::simulation_step_index_before(const std::chrono::nanoseconds age) const {
+    return simulation_step_index_at(current_time() - age);
+}
+
+[[nodiscard]] SimulationStep ScaledClock::simulation_step_index_at(const Clock::time_point time) const {
+    const auto elapsed = std::chrono::duration<double>(time - m_segment_start_time).count();
+    if (elapsed <= 0.0) {
+        return m_segment_start_step;
+    }
+
+    return m_segment_start_step
+           + static_cast<SimulationStep>(elapsed * m_speed * static_cast<double>(m_target_frequency));
+}
+
+bool ScaledClock::can_be_paused() {
+    return true;
+}
+
+void ScaledClock::pause() {
+    if (m_paused_at) {
+        throw std::runtime_error("cannot pause if already paused");
+    }
+    m_paused_at = m_time_source();
+    spdlog::info("pausing clock");
+}
+
+double ScaledClock::resume() {
+    if (not m_paused_at) {
+        throw std::runtime_error("must have been paused before to be able to resume");
+    }
+    const auto duration = m_time_source() - *m_paused_at;
+    m_segment_start_time += duration;
+    m_paused_at = std::nullopt;
+
+    const auto seconds = std::chrono::duration<double>(duration).count();
+    spdlog::info("resuming clock (duration of pause: {} s)", seconds);
+    return seconds;
+}
+
+
+void ManualClock::advance(const SimulationStep steps) {
+    if (m_is_paused) {
+        return;
+    }
+    m_simulation_step_index.fetch_add(steps, std::memory_order_release);
+}
+
+[[nodiscard]] SimulationStep ManualClock::simulation_step_index() const {
+    return m_simulation_step_index.load(std::memory_order_acquire);
+}
+
+bool ManualClock::can_be_paused() {
+    return true;
+}
+
+void ManualClock::pause() {
+    if (m_is_paused) {
+        throw std::runtime_error("cannot pause if already paused");
+    }
+    m_is_paused = true;
+}
+
+double ManualClock::resume() {
+    if (not m_is_paused) {
+        throw std::runtime_error("must have been paused before to be able to resume");
+    }
+    m_is_paused = false;
+    // the clock doesn't advance during a pause, so no time passed for the game
+    return 0.0;
+}
@@ -3,13 +3,26 @@
 
 #include <core/helper/types.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 
+// the current time of the clocks, that follow the real time, tests replace it, so that they control the time
+using TimeSource = std::function<std::chrono::steady_clock::time_point()>;
+
 struct ClockSource {
     virtual ~ClockSource() = default;
 
     [[nodiscard]] virtual SimulationStep simulation_step_index() const = 0;
+
+    // the step index the clock had the given time ago, clocks that don't follow the real time return the current one
+    [[nodiscard]] virtual SimulationStep simulation_step_index_before(std::chrono::nanoseconds /*age*/) const {
+        return simulation_step_index();
+    }
+
     [[nodiscard]] virtual bool can_be_paused() = 0;
 
     virtual void pause() {
@@ -23,6 +36,11 @@ struct ClockSource {
     virtual double resume() {
         throw std::runtime_error("not implemented");
     };
+
+    // the speed relative to real time, the catch up budget of a game scales with it
+    [[nodiscard]] virtual double speed() const {
+        return 1.0;
+    }
 };
 
 struct LocalClock : public ClockSource {
@@ -34,7 +52,80 @@ private:
 public:
     explicit LocalClock(u32 target_frequency);
     [[nodiscard]] SimulationStep simulation_step_index() const override;
+    [[nodiscard]] SimulationStep simulation_step_index_before(std::chrono::nanoseconds age) const override;
     bool can_be_paused() override;
     void pause() override;
     double resume() override;
 };
+
+// derives the step index from a monotonic nanosecond counter with integer arithmetic, so unlike LocalClock, it has no millisecond rounding and doesn't drift in long sessions
+struct HighResolutionClock : public ClockSource {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    TimeSource m_time_source;
+    Clock::time_point m_start_time;
+    u32 m_target_frequency;
+    std::optional<Clock::time_point> m_paused_at;
+
+    [[nodiscard]] SimulationStep simulation_step_index_at(Clock::time_point time) const;
+
+public:
+    explicit HighResolutionClock(u32 target_frequency, TimeSource time_source = Clock::now);
+    [[nodiscard]] SimulationStep simulation_step_index() const override;
+    [[nodiscard]] SimulationStep simulation_step_index_before(std::chrono::nanoseconds age) const override;
+    bool can_be_paused() override;
+    void pause() override;
+    double resume() override;
+};
+
+// runs faster or slower than real time, e.g. for replays, the speed can be changed at any time, without a jump of the step index
+struct ScaledClock : public ClockSource {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    TimeSource m_time_source;
+    u32 m_target_frequency;
+    double m_speed;
+    // the step index is computed from the last speed change, so that earlier speeds don't influence the current one
+    SimulationStep m_segment_start_step{ 0 };
+    Clock::time_point m_segment_start_time;
+    std::optional<Clock::time_point> m_paused_at;
+
+    [[nodiscard]] Clock::time_point current_time() const;
+    [[nodiscard]] SimulationStep simulation_step_index_at(Clock::time_point time) const;
+
+public:
+    ScaledClock(u32 target_frequency, double speed, TimeSource time_source = Clock::now);
+
+    // the speed has to be greater than 0, 1.0 is real time
+    void set_speed(double speed);
+    [[nodiscard]] double speed() const override;
+
+    [[nodiscard]] SimulationStep simulation_step_index() const override;
+    // only the time since the last speed change is taken into account, earlier times return the step of that change
+    [[nodiscard]] SimulationStep simulation_step_index_before(std::chrono::nanoseconds age) const override;
+    bool can_be_paused() override;
+    void pause() override;
+    double resume() override;
+};
+
+// only advances, when it is stepped, so that tests and benchmarks can drive a game independent of the real time
+// the step index may be read from the simulation thread, so it is atomic
+struct ManualClock : public ClockSource {
+private:
+    std::atomic<SimulationStep> m_simulation_step_index{ 0 };
+    bool m_is_paused{ false };
+
+public:
+    // has no effect, while the clock is paused
+    void advance(SimulationStep steps = 1);
+
+    [[nodiscard]] SimulationStep simulation_step_index() const override;
+    bool can_be_paused() override;
+    void pause() override;
+    double resume() override;
+};
+
+// creates the clock of a game with the given simulation frequency, an empty factory means the default clock of the game
+using ClockFactory = std::function<std::unique_ptr<ClockSource>(u32 simulation_frequency)>;
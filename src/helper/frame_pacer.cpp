@@ -0,0 +1,135 @@
+#include "helper/frame_pacer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace {
+
+    using namespace std::chrono_literals;
+
+    // if the remaining time is shorter than this (after subtracting the overshoot estimate), we only spin, since the OS sleep is too coarse for such durations
+    constexpr auto min_sleep_duration = 500us;
+
+    // a conservative initial guess, it adapts to the real overshoot of the OS within the first few frames
+    constexpr double initial_overshoot_ns = 1'000'000.0;
+
+    [[nodiscard]] std::chrono::nanoseconds to_nanoseconds(double value) {
+        return std::chrono::nanoseconds{ static_cast<std::chrono::nanoseconds::rep>(value) };
+    }
+
+} // namespace
+
+
+helper::FramePacer::FramePacer(std::optional<u32> target_framerate, TimeSource time_source, Sleep sleep)
+    : m_time_source{ std::move(time_source) },
+      m_sleep{ std::move(sleep) },
+      m_next_deadline{ m_time_source() },
+      m_last_frame{ m_next_deadline },
+      m_overshoot_mean_ns{ initial_overshoot_ns } {
+
+    if (target_framerate.has_value()) {
+        assert(target_framerate.value() >= 1);
+        m_frame_duration = std::chrono::duration_cast<Duration>(std::chrono::seconds{ 1 }) / target_framerate.value();
+    }
+}
+
+void helper::FramePacer::wait_for_next_frame() {
+
+    if (m_frame_duration.has_value()) {
+        const auto frame_duration = m_frame_duration.value();
+
+        m_next_deadline += frame_duration;
+
+        const auto now = m_time_source();
+        if (now - m_next_deadline > frame_duration * max_frames_behind) {
+            // we are way behind (e.g. after a stall), so start a new schedule, instead of trying to catch up with a burst of frames
+            m_next_deadline = now;
+        } else {
+            sleep_until(m_next_deadline);
+        }
+    }
+
+    record_frame(m_time_source());
+}
+
+[[nodiscard]] helper::FrameStatistics helper::FramePacer::statistics() const {
+
+    const auto jitter_ns = m_frame_count > 1 ? std::sqrt(m_frame_time_m2 / static_cast<double>(m_frame_count)) : 0.0;
+
+    return FrameStatistics{ .frame_count = m_frame_count,
+                            .average_frame_time = to_nanoseconds(m_frame_time_mean_ns),
+                            .jitter = to_nanoseconds(jitter_ns),
+                            .max_deviation = m_max_deviation,
+                            .sleep_overshoot = sleep_overshoot_estimate() };
+}
+
+void helper::FramePacer::reset_statistics() {
+    m_frame_count = 0;
+    m_frame_time_mean_ns = 0.0;
+    m_frame_time_m2 = 0.0;
+    m_max_deviation = Duration{ 0 };
+}
+
+void helper::FramePacer::sleep_until(const Clock::time_point deadline) {
+
+    auto now = m_time_source();
+
+    const auto overshoot_estimate = sleep_overshoot_estimate();
+
+    if (deadline - now > overshoot_estimate + min_sleep_duration) {
+        const auto requested = std::chrono::duration_cast<Duration>(deadline - now - overshoot_estimate);
+
+        const auto sleep_start = now;
+        //TODO(totto): use SDL_DelayNS in sdl >= 3.0
+        m_sleep(requested);
+        now = m_time_source();
+
+        record_sleep_overshoot(std::chrono::duration_cast<Duration>(now - sleep_start) - requested);
+    }
+
+    // spin for the rest of the time, this is more accurate than any OS sleep
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = m_time_source();
+    }
+}
+
+void helper::FramePacer::record_sleep_overshoot(const Duration overshoot) {
+    // exponentially weighted moving average and variance
+    const auto difference = static_cast<double>(overshoot.count()) - m_overshoot_mean_ns;
+    m_overshoot_mean_ns += overshoot_smoothing * difference;
+    m_overshoot_variance_ns =
+            (1.0 - overshoot_smoothing) * (m_overshoot_variance_ns + overshoot_smoothing * difference * difference);
+}
+
+[[nodiscard]] helper::FramePacer::Duration helper::FramePacer::sleep_overshoot_estimate() const {
+    const auto estimate = m_overshoot_mean_ns + overshoot_deviations * std::sqrt(m_overshoot_variance_ns);
+
+    auto result = to_nanoseconds(std::max(estimate, 0.0));
+
+    // never spin for more than a whole frame
+    if (m_frame_duration.has_value()) {
+        result = std::min(result, m_frame_duration.value());
+    }
+
+    return result;
+}
+
+void helper::FramePacer::record_frame(const Clock::time_point now) {
+    const auto frame_time = std::chrono::duration_cast<Duration>(now - m_last_frame);
+    m_last_frame = now;
+
+    ++m_frame_count;
+    const auto frame_time_ns = static_cast<double>(frame_time.count());
+    const auto delta = frame_time_ns - m_frame_time_mean_ns;
+    m_frame_time_mean_ns += delta / static_cast<double>(m_frame_count);
+    m_frame_time_m2 += delta * (frame_time_ns - m_frame_time_mean_ns);
+
+    const auto expected_frame_time = m_frame_duration.value_or(to_nanoseconds(m_frame_time_mean_ns));
+    const auto deviation = frame_time > expected_frame_time ? frame_time - expected_frame_time
+                                                            : expected_frame_time - frame_time;
+    m_max_deviation = std::max(m_max_deviation, deviation);
+}
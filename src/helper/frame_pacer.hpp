@@ -0,0 +1,79 @@
+#pragma once
+
+#include <core/helper/sleep.hpp>
+#include <core/helper/types.hpp>
+
+#include "helper/clock_source.hpp"
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace helper {
+
+    struct FrameStatistics {
+        u64 frame_count;
+        std::chrono::nanoseconds average_frame_time;
+        // standard deviation of the frame times
+        std::chrono::nanoseconds jitter;
+        std::chrono::nanoseconds max_deviation;
+        // the current estimate of how much the OS oversleeps a requested sleep
+        std::chrono::nanoseconds sleep_overshoot;
+    };
+
+    // limits the frame rate to a target, if one is given, and measures frame times
+    // frames are scheduled against absolute deadlines, so that sleeping inaccuracies don't add up over time
+    // waiting is done by a coarse OS sleep, followed by a short spin until the deadline, the length of the sleep is adapted to the measured overshoot of previous sleeps
+    struct FramePacer final {
+    public:
+        // sleeps for about the given duration, tests replace it together with the time source
+        using Sleep = std::function<bool(std::chrono::nanoseconds)>;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::nanoseconds;
+
+        // if we are behind the deadline by more than this amount of frames, we don't try to catch up, but start again from now
+        static constexpr i64 max_frames_behind = 2;
+
+        // the overshoot estimate is a moving average + a multiple of the moving standard deviation
+        static constexpr double overshoot_smoothing = 0.1;
+        static constexpr double overshoot_deviations = 2.0;
+
+        TimeSource m_time_source;
+        Sleep m_sleep;
+
+        std::optional<Duration> m_frame_duration;
+        Clock::time_point m_next_deadline;
+        Clock::time_point m_last_frame;
+
+        double m_overshoot_mean_ns{ 0.0 };
+        double m_overshoot_variance_ns{ 0.0 };
+
+        // running statistics since the last reset (Welford's algorithm)
+        u64 m_frame_count{ 0 };
+        double m_frame_time_mean_ns{ 0.0 };
+        double m_frame_time_m2{ 0.0 };
+        Duration m_max_deviation{ 0 };
+
+    public:
+        explicit FramePacer(
+                std::optional<u32> target_framerate,
+                TimeSource time_source = Clock::now,
+                Sleep sleep = helper::sleep_nanoseconds
+        );
+
+        // call this once per frame, after presenting
+        void wait_for_next_frame();
+
+        [[nodiscard]] FrameStatistics statistics() const;
+        void reset_statistics();
+
+    private:
+        void sleep_until(Clock::time_point deadline);
+        void record_sleep_overshoot(Duration overshoot);
+        [[nodiscard]] Duration sleep_overshoot_estimate() const;
+        void record_frame(Clock::time_point now);
+    };
+
+} // namespace helper
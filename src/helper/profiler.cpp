@@ -0,0 +1,308 @@
+#include "helper/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fmt/format.h>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace {
+
+    // about 40 MB, after that only the statistics are kept, so that a long session doesn't use up all memory
+    constexpr usize max_trace_events = 1'000'000;
+
+    enum class EventType : u8 { Zone, Counter };
+
+    struct TraceEvent {
+        EventType type;
+        std::string_view name;
+        u32 thread;
+        helper::profiler::Clock::time_point start;
+        // the duration in nanoseconds for zones, the value for counters
+        i64 value;
+    };
+
+    struct Accumulator {
+        std::chrono::nanoseconds total{ 0 };
+        std::chrono::nanoseconds max_per_frame{ 0 };
+        u64 calls{ 0 };
+    };
+
+    struct Profiler {
+        std::atomic<bool> enabled{ false };
+
+        std::mutex mutex;
+        std::optional<std::filesystem::path> trace_path;
+        helper::profiler::Clock::time_point start_time;
+        std::vector<TraceEvent> events;
+        bool reported_full{ false };
+        std::unordered_map<std::thread::id, u32> thread_ids;
+
+        std::unordered_map<std::string_view, std::chrono::nanoseconds> current_frame;
+        std::unordered_map<std::string_view, Accumulator> accumulated;
+        u64 frames{ 0 };
+
+        // std::map never moves its nodes, so the names stay valid
+        std::map<std::pair<std::type_index, std::string_view>, std::string> type_names;
+
+        [[nodiscard]] u32 thread_id() {
+            const auto [iterator, _] =
+                    thread_ids.try_emplace(std::this_thread::get_id(), static_cast<u32>(thread_ids.size()));
+            return iterator->second;
+        }
+
+        void add_event(TraceEvent&& event) {
+            if (not trace_path.has_value()) {
+                return;
+            }
+
+            if (events.size() >= max_trace_events) {
+                if (not reported_full) {
+                    spdlog::warn("profiler trace is full, only the first {} events are recorded", max_trace_events);
+                    reported_full = true;
+                }
+                return;
+            }
+
+            events.push_back(event);
+        }
+    };
+
+    [[nodiscard]] Profiler& global_profiler() {
+        static Profiler instance{};
+        return instance;
+    }
+
+    [[nodiscard]] std::string demangle(const char* name) {
+#if defined(__GNUC__) || defined(__clang__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 and demangled != nullptr) {
+            std::string result{ demangled };
+            std::free(demangled); //NOLINT(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+            return result;
+        }
+        return name;
+#else
+        // msvc already returns a readable name, but with a "struct " or "class " prefix
+        std::string_view result{ name };
+        for (const std::string_view prefix : { "struct ", "class " }) {
+            if (result.starts_with(prefix)) {
+                result.remove_prefix(prefix.size());
+            }
+        }
+        return std::string{ result };
+#endif
+    }
+
+    // JSON strings need escaping, zone names are mostly identifiers, but type names may contain anything
+    [[nodiscard]] std::string escaped(std::string_view value) {
+        std::string result{};
+        result.reserve(value.size());
+        for (const auto character : value) {
+            if (character == '"' or character == '\\') {
+                result += '\\';
+            }
+            result += character;
+        }
+        return result;
+    }
+
+} // namespace
+
+
+void helper::profiler::enable(std::optional<std::filesystem::path> trace_path) {
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    instance.trace_path = std::move(trace_path);
+    instance.start_time = Clock::now();
+    instance.enabled.store(true, std::memory_order_release);
+}
+
+[[nodiscard]] bool helper::profiler::is_enabled() {
+    return global_profiler().enabled.load(std::memory_order_relaxed);
+}
+
+
+helper::profiler::Zone::Zone(std::string_view name) : m_name{ name }, m_is_active{ is_enabled() } {
+    if (m_is_active) {
+        m_start = Clock::now();
+    }
+}
+
+helper::profiler::Zone::Zone(const std::type_info& type, std::string_view suffix) : m_is_active{ is_enabled() } {
+    if (not m_is_active) {
+        return;
+    }
+
+    auto& instance = global_profiler();
+    {
+        const std::lock_guard lock{ instance.mutex };
+        const auto key = std::make_pair(std::type_index{ type }, suffix);
+        auto iterator = instance.type_names.find(key);
+        if (iterator == instance.type_names.end()) {
+            iterator = instance.type_names.emplace(key, fmt::format("{}{}", demangle(type.name()), suffix)).first;
+        }
+        m_name = iterator->second;
+    }
+
+    m_start = Clock::now();
+}
+
+helper::profiler::Zone::~Zone() {
+    if (not m_is_active) {
+        return;
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start);
+
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    instance.current_frame[m_name] += duration;
+
+    auto& accumulator = instance.accumulated[m_name];
+    ++accumulator.calls;
+
+    instance.add_event(TraceEvent{ .type = EventType::Zone,
+                                   .name = m_name,
+                                   .thread = instance.thread_id(),
+                                   .start = m_start,
+                                   .value = duration.count() });
+}
+
+void helper::profiler::counter(std::string_view name, i64 value) {
+    if (not is_enabled()) {
+        return;
+    }
+
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    instance.add_event(TraceEvent{ .type = EventType::Counter,
+                                   .name = name,
+                                   .thread = instance.thread_id(),
+                                   .start = Clock::now(),
+                                   .value = value });
+}
+
+void helper::profiler::end_frame() {
+    if (not is_enabled()) {
+        return;
+    }
+
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    for (const auto& [name, duration] : instance.current_frame) {
+        auto& accumulator = instance.accumulated[name];
+        accumulator.total += duration;
+        accumulator.max_per_frame = std::max(accumulator.max_per_frame, duration);
+    }
+
+    instance.current_frame.clear();
+    ++instance.frames;
+}
+
+[[nodiscard]] std::vector<helper::profiler::ZoneStatistics> helper::profiler::take_statistics(usize max_zones) {
+    if (not is_enabled()) {
+        return {};
+    }
+
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    std::vector<ZoneStatistics> result{};
+
+    if (instance.frames == 0) {
+        return result;
+    }
+
+    const auto frames = static_cast<i64>(instance.frames);
+
+    result.reserve(instance.accumulated.size());
+    for (const auto& [name, accumulator] : instance.accumulated) {
+        result.push_back(ZoneStatistics{ .name = name,
+                                         .average_per_frame = accumulator.total / frames,
+                                         .max_per_frame = accumulator.max_per_frame,
+                                         .calls_per_frame = static_cast<double>(accumulator.calls)
+                                                            / static_cast<double>(instance.frames) });
+    }
+
+    instance.accumulated.clear();
+    instance.frames = 0;
+
+    std::ranges::sort(result, [](const ZoneStatistics& first, const ZoneStatistics& second) {
+        return first.average_per_frame > second.average_per_frame;
+    });
+
+    if (result.size() > max_zones) {
+        result.resize(max_zones);
+    }
+
+    return result;
+}
+
+void helper::profiler::write_trace() {
+    if (not is_enabled()) {
+        return;
+    }
+
+    auto& instance = global_profiler();
+    const std::lock_guard lock{ instance.mutex };
+
+    if (not instance.trace_path.has_value()) {
+        return;
+    }
+
+    std::ofstream file{ instance.trace_path.value() };
+    if (not file) {
+        spdlog::error("unable to open profiler trace file {}", instance.trace_path->string());
+        return;
+    }
+
+    const auto to_microseconds = [&instance](Clock::time_point time_point) {
+        return std::chrono::duration<double, std::micro>(time_point - instance.start_time).count();
+    };
+
+    // the events are written by hand, building a json object first would need a multiple of the memory
+    file << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+    for (usize i = 0; i < instance.events.size(); ++i) {
+        const auto& event = instance.events.at(i);
+        const auto* const separator = i == 0 ? "" : ",";
+
+        switch (event.type) {
+            case EventType::Zone:
+                file << fmt::format(
+                        R"({}{}{{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", separator, "\n",
+                        escaped(event.name), event.thread, to_microseconds(event.start),
+                        static_cast<double>(event.value) / 1000.0
+                );
+                break;
+            case EventType::Counter:
+                file << fmt::format(
+                        R"({}{}{{"name":"{}","ph":"C","pid":0,"tid":{},"ts":{:.3f},"args":{{"value":{}}}}})",
+                        separator, "\n", escaped(event.name), event.thread, to_microseconds(event.start),
+                        event.value
+                );
+                break;
+        }
+    }
+
+    file << "\n]}\n";
+
+    spdlog::info("wrote {} profiler events to {}", instance.events.size(), instance.trace_path->string());
+}
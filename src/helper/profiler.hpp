@@ -0,0 +1,61 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+// a lightweight profiler with named scoped zones, it is compiled into all builds, but everything is a cheap no-op, until it is enabled at runtime
+// zone names are not copied, so they have to outlive the profiler, use string literals or the type_info overload of Zone
+namespace helper::profiler {
+
+    using Clock = std::chrono::steady_clock;
+
+    // if a path is given, all zones are additionally recorded and written as chrome trace JSON to it in write_trace()
+    void enable(std::optional<std::filesystem::path> trace_path);
+
+    [[nodiscard]] bool is_enabled();
+
+    struct Zone final {
+    private:
+        std::string_view m_name;
+        Clock::time_point m_start{};
+        bool m_is_active;
+
+    public:
+        explicit Zone(std::string_view name);
+
+        // the name is the demangled type name followed by the suffix, it is only computed, if the profiler is enabled
+        Zone(const std::type_info& type, std::string_view suffix);
+
+        Zone(const Zone&) = delete;
+        Zone(Zone&&) = delete;
+        Zone& operator=(const Zone&) = delete;
+        Zone& operator=(Zone&&) = delete;
+
+        ~Zone();
+    };
+
+    // records a value, that changes over time, e.g. the number of simulation steps per frame
+    void counter(std::string_view name, i64 value);
+
+    // has to be called once per frame, the statistics are averaged over frames
+    void end_frame();
+
+    struct ZoneStatistics {
+        std::string_view name;
+        std::chrono::nanoseconds average_per_frame;
+        std::chrono::nanoseconds max_per_frame;
+        double calls_per_frame;
+    };
+
+    // returns the zones with the highest average time per frame, since the last call, sorted by that time
+    [[nodiscard]] std::vector<ZoneStatistics> take_statistics(usize max_zones);
+
+    void write_trace();
+
+} // namespace helper::profiler
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+namespace helper {
+
+    // a bounded lock-free single producer single consumer queue
+    // the head is only written by the consumer and the tail only by the producer, so neither side ever waits on the other
+    template<typename T, usize Capacity>
+    struct SpscQueue final {
+        static_assert(Capacity >= 2 and (Capacity & (Capacity - 1)) == 0, "the capacity has to be a power of two");
+
+    private:
+        static constexpr usize index_mask = Capacity - 1;
+        // avoids false sharing between the producer and the consumer
+        static constexpr usize cache_line_size = 64;
+
+        std::array<T, Capacity> m_slots{};
+
+        // both grow monotonically, the slot of an index is index & index_mask
+        alignas(cache_line_size) std::atomic<usize> m_head{ 0 };
+        alignas(cache_line_size) std::atomic<usize> m_tail{ 0 };
+
+    public:
+        SpscQueue() = default;
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+        SpscQueue(SpscQueue&&) = delete;
+        SpscQueue& operator=(SpscQueue&&) = delete;
+
+        ~SpscQueue() = default;
+
+        // producer side: returns false, if the queue is full, the value is not pushed in that case
+        [[nodiscard]] bool try_push(const T& value) {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) >= Capacity) {
+                return false;
+            }
+
+            m_slots.at(tail & index_mask) = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side
+        [[nodiscard]] std::optional<T> try_pop() {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+
+            auto value = m_slots.at(head & index_mask);
+            m_head.store(head + 1, std::memory_order_release);
+            return value;
+        }
+    };
+
+} // namespace helper
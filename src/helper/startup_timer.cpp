@@ -0,0 +1,110 @@
+#include <core/helper/types.hpp>
+
+#include "helper/startup_timer.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <mutex>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    struct PhaseRecord {
+        std::string_view name;
+        helper::startup::Clock::time_point start;
+        helper::startup::Clock::duration duration;
+        u32 thread;
+    };
+
+    struct StartupTimer {
+        std::mutex mutex;
+        helper::startup::Clock::time_point process_start{ helper::startup::Clock::now() };
+        std::optional<helper::startup::Clock::time_point> first_frame;
+        std::vector<PhaseRecord> phases;
+        std::unordered_map<std::thread::id, u32> thread_ids;
+
+        [[nodiscard]] u32 thread_id() {
+            const auto [iterator, _] =
+                    thread_ids.try_emplace(std::this_thread::get_id(), static_cast<u32>(thread_ids.size()));
+            return iterator->second;
+        }
+    };
+
+    [[nodiscard]] StartupTimer& global_startup_timer() {
+        static StartupTimer instance{};
+        return instance;
+    }
+
+    [[nodiscard]] double to_milliseconds(helper::startup::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+} // namespace
+
+
+void helper::startup::mark_process_start() {
+    auto& instance = global_startup_timer();
+    const std::lock_guard lock{ instance.mutex };
+
+    instance.process_start = Clock::now();
+    // the main thread should be thread 0 in the report
+    std::ignore = instance.thread_id();
+}
+
+helper::startup::Phase::Phase(std::string_view name) : m_name{ name }, m_start{ Clock::now() } { }
+
+helper::startup::Phase::~Phase() {
+    const auto end = Clock::now();
+
+    auto& instance = global_startup_timer();
+    const std::lock_guard lock{ instance.mutex };
+
+    instance.phases.push_back(
+            PhaseRecord{ .name = m_name, .start = m_start, .duration = end - m_start, .thread = instance.thread_id() }
+    );
+}
+
+void helper::startup::mark_first_frame() {
+    auto& instance = global_startup_timer();
+    const std::lock_guard lock{ instance.mutex };
+
+    if (instance.first_frame.has_value()) {
+        return;
+    }
+
+    instance.first_frame = Clock::now();
+
+    spdlog::debug("first frame after {:.2f} ms", to_milliseconds(instance.first_frame.value() - instance.process_start));
+}
+
+[[nodiscard]] std::string helper::startup::report() {
+    auto& instance = global_startup_timer();
+    const std::lock_guard lock{ instance.mutex };
+
+    auto phases = instance.phases;
+    std::ranges::sort(phases, [](const PhaseRecord& first, const PhaseRecord& second) {
+        return first.start < second.start;
+    });
+
+    std::string result = fmt::format("{:<40} {:>12} {:>12} {:>7}\n", "phase", "start (ms)", "took (ms)", "thread");
+
+    for (const auto& phase : phases) {
+        result += fmt::format(
+                "{:<40} {:>12.2f} {:>12.2f} {:>7}\n", phase.name, to_milliseconds(phase.start - instance.process_start),
+                to_milliseconds(phase.duration), phase.thread
+        );
+    }
+
+    if (instance.first_frame.has_value()) {
+        result += fmt::format(
+                "{:<40} {:>12.2f}\n", "first frame", to_milliseconds(instance.first_frame.value() - instance.process_start)
+        );
+    }
+
+    return result;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+// records how long the phases of the startup take, this is always on, since there are only a few phases
+// the breakdown is printed with --startup-benchmark, so that cold-start regressions can be tracked
+namespace helper::startup {
+
+    using Clock = std::chrono::steady_clock;
+
+    // the start offsets of all phases are relative to this, so it should be called as early as possible in main
+    void mark_process_start();
+
+    // phases may be nested and may run on multiple threads, names have to outlive the startup, use string literals
+    struct Phase final {
+    private:
+        std::string_view m_name;
+        Clock::time_point m_start;
+
+    public:
+        explicit Phase(std::string_view name);
+
+        Phase(const Phase&) = delete;
+        Phase(Phase&&) = delete;
+        Phase& operator=(const Phase&) = delete;
+        Phase& operator=(Phase&&) = delete;
+
+        ~Phase();
+    };
+
+    // has to be called after the first frame was presented, only the first call has an effect
+    void mark_first_frame();
+
+    // a human readable table of all phases, sorted by their start, and the total time to the first frame
+    [[nodiscard]] std::string report();
+
+} // namespace helper::startup
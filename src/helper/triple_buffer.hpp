@@ -0,0 +1,67 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace helper {
+
+    // a lock-free single producer single consumer triple buffer
+    // the producer always has a slot to write into and the consumer always has a consistent slot to read from, the third slot is used to exchange them, so that neither side ever waits on the other
+    template<typename T>
+    struct TripleBuffer final {
+    private:
+        static constexpr u8 index_mask = 0b011;
+        static constexpr u8 fresh_bit = 0b100;
+
+        std::array<T, 3> m_slots{};
+
+        // index of the exchange slot, the fresh_bit is set, if the producer published it and the consumer didn't take it yet
+        std::atomic<u8> m_exchange{ 1 };
+
+        // only accessed by the producer
+        u8 m_back{ 0 };
+
+        // only accessed by the consumer
+        u8 m_front{ 2 };
+
+    public:
+        TripleBuffer() = default;
+
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+        TripleBuffer(TripleBuffer&&) = delete;
+        TripleBuffer& operator=(TripleBuffer&&) = delete;
+
+        ~TripleBuffer() = default;
+
+        // producer side: the slot, that gets published by the next call to publish()
+        [[nodiscard]] T& back() {
+            return m_slots.at(m_back);
+        }
+
+        // producer side: make the back slot visible to the consumer
+        void publish() {
+            const auto previous = m_exchange.exchange(static_cast<u8>(m_back | fresh_bit), std::memory_order_acq_rel);
+            m_back = static_cast<u8>(previous & index_mask);
+        }
+
+        // consumer side: take the most recently published slot, if there is one, returns if the front slot changed
+        bool consume() {
+            if ((m_exchange.load(std::memory_order_acquire) & fresh_bit) == 0) {
+                return false;
+            }
+
+            const auto previous = m_exchange.exchange(m_front, std::memory_order_acq_rel);
+            m_front = static_cast<u8>(previous & index_mask);
+            return true;
+        }
+
+        // consumer side: the slot, that was taken by the last successful call to consume()
+        [[nodiscard]] const T& front() const {
+            return m_slots.at(m_front);
+        }
+    };
+
+} // namespace helper
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <core/helper/parse_json.hpp>
+#include <core/helper/types.hpp>
+
+namespace input {
+
+    // the delayed auto shift (DAS) and auto repeat rate (ARR) of a held left or right key, in simulation steps
+    struct AutoShiftTimings {
+        static constexpr u32 default_delayed_auto_shift_frames = 10;
+        static constexpr u32 default_auto_repeat_rate_frames = 2;
+
+        u32 delayed_auto_shift_frames{ default_delayed_auto_shift_frames };
+        // 0 moves the tetromino to the wall instantly, after the delay expired
+        u32 auto_repeat_rate_frames{ default_auto_repeat_rate_frames };
+
+        [[nodiscard]] bool operator==(const AutoShiftTimings& other) const = default;
+    };
+
+} // namespace input
+
+
+namespace nlohmann {
+    template<>
+    struct adl_serializer<input::AutoShiftTimings> {
+        static input::AutoShiftTimings from_json(const json& obj) {
+            ::json::check_for_no_additional_keys(obj, { "delay", "repeat_rate" });
+
+            return input::AutoShiftTimings{ .delayed_auto_shift_frames = obj.at("delay").get<u32>(),
+                                            .auto_repeat_rate_frames = obj.at("repeat_rate").get<u32>() };
+        }
+
+        static void to_json(json& obj, const input::AutoShiftTimings& timings) {
+            obj = nlohmann::json{
+                {       "delay", timings.delayed_auto_shift_frames },
+                { "repeat_rate",   timings.auto_repeat_rate_frames },
+            };
+        }
+    };
+} // namespace nlohmann
+
+
+namespace json_helper {
+
+    // the timings are optional in the settings of a control, so that existing settings files stay valid
+    [[nodiscard]] inline input::AutoShiftTimings get_auto_shift_timings(const nlohmann::json& obj) {
+        if (not obj.contains("auto_shift")) {
+            return input::AutoShiftTimings{};
+        }
+
+        return obj.at("auto_shift").get<input::AutoShiftTimings>();
+    }
+
+} // namespace json_helper
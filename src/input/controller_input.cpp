@@ -197,7 +197,9 @@ input::ControllerGameInput::ControllerGameInput(
 )
     : JoystickLikeGameInput{ event_dispatcher, JoystickLikeType::Controller },
       m_settings{ settings },
-      m_underlying_input{ underlying_input } { }
+      m_underlying_input{ underlying_input } {
+    set_auto_shift_timings(m_settings.auto_shift);
+}
 
 [[nodiscard]] const input::ControllerInput* input::ControllerGameInput::underlying_input() const {
     return m_underlying_input;
@@ -47,6 +47,7 @@ namespace input {
         sdl::ControllerKey pause;
         sdl::ControllerKey open_settings;
 
+        AutoShiftTimings auto_shift;
 
         [[nodiscard]] helper::expected<void, std::string> validate() const;
 
@@ -60,7 +61,8 @@ namespace input {
                                        .drop = sdl::ControllerKey{ SDL_CONTROLLER_BUTTON_A },
                                        .hold = sdl::ControllerKey{ SDL_CONTROLLER_BUTTON_B },
                                        .pause = sdl::ControllerKey{ SDL_CONTROLLER_BUTTON_START },
-                                       .open_settings = sdl::ControllerKey{ SDL_CONTROLLER_BUTTON_GUIDE } };
+                                       .open_settings = sdl::ControllerKey{ SDL_CONTROLLER_BUTTON_GUIDE },
+                                       .auto_shift = AutoShiftTimings{} };
         }
     };
 
@@ -107,7 +109,7 @@ namespace nlohmann {
 
             ::json::check_for_no_additional_keys(
                     obj, { "type", "rotate_left", "rotate_right", "move_left", "move_right", "move_down", "drop",
-                           "hold", "menu" }
+                           "hold", "menu", "auto_shift" }
             );
 
             const auto rotate_left = json_helper::get_controller_key(obj, "rotate_left");
@@ -133,7 +135,8 @@ namespace nlohmann {
                                                        .drop = drop,
                                                        .hold = hold,
                                                        .pause = pause,
-                                                       .open_settings = open_settings };
+                                                       .open_settings = open_settings,
+                                                       .auto_shift = json_helper::get_auto_shift_timings(obj) };
 
             const auto is_valid = settings.validate();
             if (not is_valid.has_value()) {
@@ -156,7 +159,8 @@ namespace nlohmann {
                  "menu", nlohmann::json{
                                 { "pause", settings.pause.to_string() },
                                 { "open_settings", settings.open_settings.to_string() },
-                        }, }
+                        }, },
+                { "auto_shift", settings.auto_shift },
             };
         }
     };
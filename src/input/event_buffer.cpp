@@ -0,0 +1,75 @@
+#include "event_buffer.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace {
+
+    [[nodiscard]] std::chrono::nanoseconds age_of_sdl_timestamp(const u32 timestamp) {
+        // unsigned, so that this also works, after the 32 bit ticks wrapped around
+        const u32 age_in_milliseconds = SDL_GetTicks() - timestamp;
+
+        // timestamps from the future (e.g. synthetic events) are treated as now
+        if (age_in_milliseconds > std::numeric_limits<u32>::max() / 2) {
+            return std::chrono::nanoseconds{ 0 };
+        }
+
+        return std::chrono::milliseconds{ age_in_milliseconds };
+    }
+
+} // namespace
+
+
+void input::EventBuffer::push(const SDL_Event& event) {
+    if (m_subscription != nullptr) {
+        return;
+    }
+
+    const std::lock_guard lock{ m_mutex };
+    m_events.push_back(Entry{ .event = event, .received_at = std::nullopt, .simulation_step = std::nullopt });
+}
+
+[[nodiscard]] std::vector<SDL_Event>
+input::EventBuffer::take(const SimulationStep simulation_step_index, const TimestampMapper& timestamp_mapper) {
+    std::vector<SDL_Event> result{};
+    const std::lock_guard lock{ m_mutex };
+
+    if (m_subscription != nullptr) {
+        while (auto event = m_subscription->queue.try_pop()) {
+            m_events.push_back(
+                    Entry{ .event = event->event, .received_at = event->received_at, .simulation_step = std::nullopt }
+            );
+        }
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    usize taken = 0;
+    for (auto& [event, received_at, simulation_step] : m_events) {
+        if (timestamp_mapper) {
+            if (not simulation_step.has_value()) {
+                const auto age = received_at.has_value()
+                                         ? std::chrono::duration_cast<std::chrono::nanoseconds>(now - *received_at)
+                                         : age_of_sdl_timestamp(event.common.timestamp);
+                simulation_step = timestamp_mapper(age);
+            }
+
+            // the events are in the order they happened, so all following ones are later, too
+            if (simulation_step.value() > simulation_step_index) {
+                break;
+            }
+        }
+
+        result.push_back(event);
+        ++taken;
+    }
+
+    m_events.erase(m_events.begin(), m_events.begin() + static_cast<std::ptrdiff_t>(taken));
+    return result;
+}
+
+void input::EventBuffer::set_paused(const bool paused) {
+    if (m_subscription != nullptr) {
+        m_subscription->is_paused.store(paused, std::memory_order_release);
+    }
+}
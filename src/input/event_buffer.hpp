@@ -0,0 +1,71 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "input_thread.hpp"
+
+#include <SDL.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace input {
+
+    // buffers the SDL events a game input receives from the event dispatcher or the input thread, until the simulation consumes them
+    // this has to be synchronized, since the simulation may run on a different thread than the event dispatcher
+    struct EventBuffer final {
+    public:
+        // maps the time since an event happened to the simulation step, in which it happened
+        using TimestampMapper = std::function<SimulationStep(std::chrono::nanoseconds age)>;
+
+    private:
+        struct Entry {
+            SDL_Event event;
+            // only set for events from the input thread, they have a higher resolution than the SDL timestamp
+            std::optional<std::chrono::steady_clock::time_point> received_at;
+            // mapped on the first take, so that the clock is only read from the thread that runs the simulation
+            std::optional<SimulationStep> simulation_step;
+        };
+
+        std::vector<Entry> m_events;
+        std::mutex m_mutex;
+        std::shared_ptr<InputSubscription> m_subscription;
+
+    public:
+        // if there is a subscription to the input thread, the events are taken from it and pushed events are ignored
+        explicit EventBuffer(std::shared_ptr<InputSubscription> subscription = nullptr)
+            : m_subscription{ std::move(subscription) } { }
+
+        EventBuffer(const EventBuffer&) = delete;
+        EventBuffer& operator=(const EventBuffer&) = delete;
+
+        EventBuffer(EventBuffer&& other) noexcept
+            : m_events{ std::move(other.m_events) },
+              m_subscription{ std::move(other.m_subscription) } { }
+
+        EventBuffer& operator=(EventBuffer&& other) noexcept {
+            if (this != &other) {
+                m_events = std::move(other.m_events);
+                m_subscription = std::move(other.m_subscription);
+            }
+            return *this;
+        }
+
+        ~EventBuffer() = default;
+
+        void push(const SDL_Event& event);
+
+        // removes the buffered events, that happened up to the given step, and returns them in the order they were pushed
+        // later events stay buffered, so that they are applied at their own step, when multiple steps are simulated at once
+        // without a mapper, all events are returned
+        [[nodiscard]] std::vector<SDL_Event>
+        take(SimulationStep simulation_step_index, const TimestampMapper& timestamp_mapper);
+
+        // the input thread doesn't push events while paused, so that they aren't applied after resuming
+        void set_paused(bool paused);
+    };
+
+} // namespace input
@@ -3,7 +3,24 @@
 #include "manager/event_dispatcher.hpp"
 
 #include <spdlog/spdlog.h>
+#include <utility>
 
+namespace {
+
+    [[nodiscard]] input::HoldableKey opposite(const input::HoldableKey key) {
+        return key == input::HoldableKey::Left ? input::HoldableKey::Right : input::HoldableKey::Left;
+    }
+
+    [[nodiscard]] input::GameInputCommand move_command(const input::HoldableKey key) {
+        return key == input::HoldableKey::Left ? input::GameInputCommand::MoveLeft : input::GameInputCommand::MoveRight;
+    }
+
+    [[nodiscard]] input::GameInputCommand move_to_wall_command(const input::HoldableKey key) {
+        return key == input::HoldableKey::Left ? input::GameInputCommand::MoveLeftToWall
+                                               : input::GameInputCommand::MoveRightToWall;
+    }
+
+} // namespace
 
 void input::GameInput::handle_event(const InputEvent event, const SimulationStep simulation_step_index) {
     if (m_on_event_callback) {
@@ -18,28 +35,10 @@ void input::GameInput::handle_event(const InputEvent event, const SimulationStep
             m_target_tetrion->handle_input_command(GameInputCommand::RotateRight, simulation_step_index);
             break;
         case InputEvent::MoveLeftPressed:
-            if (not supports_das()) {
-                m_target_tetrion->handle_input_command(GameInputCommand::MoveLeft, simulation_step_index);
-            } else {
-                m_keys_hold[HoldableKey::Left] = simulation_step_index + delayed_auto_shift_frames;
-                if (not m_keys_hold.contains(HoldableKey::Right)
-                    and not m_target_tetrion->handle_input_command(GameInputCommand::MoveLeft, simulation_step_index)) {
-                    m_keys_hold[HoldableKey::Left] = simulation_step_index;
-                }
-            }
+            press_holdable_key(HoldableKey::Left, simulation_step_index);
             break;
         case InputEvent::MoveRightPressed:
-            if (not supports_das()) {
-                m_target_tetrion->handle_input_command(GameInputCommand::MoveRight, simulation_step_index);
-            } else {
-                m_keys_hold[HoldableKey::Right] = simulation_step_index + delayed_auto_shift_frames;
-                if (not m_keys_hold.contains(HoldableKey::Left)
-                    and not m_target_tetrion->handle_input_command(
-                            GameInputCommand::MoveRight, simulation_step_index
-                    )) {
-                    m_keys_hold[HoldableKey::Right] = simulation_step_index;
-                }
-            }
+            press_holdable_key(HoldableKey::Right, simulation_step_index);
             break;
         case InputEvent::MoveDownPressed:
             m_target_tetrion->handle_input_command(GameInputCommand::MoveDown, simulation_step_index);
@@ -51,14 +50,10 @@ void input::GameInput::handle_event(const InputEvent event, const SimulationStep
             m_target_tetrion->handle_input_command(GameInputCommand::Hold, simulation_step_index);
             break;
         case InputEvent::MoveLeftReleased:
-            if (supports_das()) {
-                m_keys_hold.erase(HoldableKey::Left);
-            }
+            release_holdable_key(HoldableKey::Left);
             break;
         case InputEvent::MoveRightReleased:
-            if (supports_das()) {
-                m_keys_hold.erase(HoldableKey::Right);
-            }
+            release_holdable_key(HoldableKey::Right);
             break;
         case InputEvent::MoveDownReleased:
             m_target_tetrion->handle_input_command(GameInputCommand::ReleaseMoveDown, simulation_step_index);
@@ -74,26 +69,59 @@ void input::GameInput::handle_event(const InputEvent event, const SimulationStep
 }
 
 void input::GameInput::update(const SimulationStep simulation_step_index) {
-    const auto current_simulation_step_index = simulation_step_index;
+    const auto& left = m_held_keys.at(std::to_underlying(HoldableKey::Left));
+    const auto& right = m_held_keys.at(std::to_underlying(HoldableKey::Right));
 
-    const auto is_left_key_down = m_keys_hold.contains(HoldableKey::Left);
-    const auto is_right_key_down = m_keys_hold.contains(HoldableKey::Right);
-    if (is_left_key_down and is_right_key_down) {
+    // nothing is held, or both keys are held, which cancel each other out
+    if (left.is_held == right.is_held) {
         return;
     }
 
-    for (auto& [key, target_simulation_step_index] : m_keys_hold) {
-        if (current_simulation_step_index >= target_simulation_step_index) {
-            while (target_simulation_step_index <= current_simulation_step_index) { // NOLINT(bugprone-infinite-loop)
-                target_simulation_step_index += auto_repeat_rate_frames;
-            }
-            if ((key == HoldableKey::Left
-                 and not m_target_tetrion->handle_input_command(GameInputCommand::MoveLeft, simulation_step_index))
-                or (key == HoldableKey::Right
-                    and not m_target_tetrion->handle_input_command(GameInputCommand::MoveRight, simulation_step_index)
-                )) {
-                target_simulation_step_index = current_simulation_step_index + delayed_auto_shift_frames;
-            }
-        }
+    const auto key = left.is_held ? HoldableKey::Left : HoldableKey::Right;
+    auto& held_key = m_held_keys.at(std::to_underlying(key));
+
+    if (simulation_step_index < held_key.next_shift_step) {
+        return;
+    }
+
+    const auto auto_repeat_rate = m_auto_shift_timings.auto_repeat_rate_frames;
+
+    if (auto_repeat_rate == 0) {
+        // this is tried in every step, while the key is held, since e.g. a rotation may have freed the way
+        m_target_tetrion->handle_input_command(move_to_wall_command(key), simulation_step_index);
+        return;
+    }
+
+    // skip the repeats, that were missed, so that the next one is in the future
+    held_key.next_shift_step +=
+            (((simulation_step_index - held_key.next_shift_step) / auto_repeat_rate) + 1) * auto_repeat_rate;
+
+    if (not m_target_tetrion->handle_input_command(move_command(key), simulation_step_index)) {
+        held_key.next_shift_step = simulation_step_index + m_auto_shift_timings.delayed_auto_shift_frames;
+    }
+}
+
+void input::GameInput::press_holdable_key(const HoldableKey key, const SimulationStep simulation_step_index) {
+    if (not supports_das()) {
+        m_target_tetrion->handle_input_command(move_command(key), simulation_step_index);
+        return;
+    }
+
+    auto& held_key = m_held_keys.at(std::to_underlying(key));
+    const auto& opposite_key = m_held_keys.at(std::to_underlying(opposite(key)));
+
+    held_key = HeldKey{ .is_held = true,
+                        .next_shift_step = simulation_step_index + m_auto_shift_timings.delayed_auto_shift_frames };
+
+    // if the move is blocked, the key starts repeating right away, so that it moves as soon as it's possible
+    if (not opposite_key.is_held
+        and not m_target_tetrion->handle_input_command(move_command(key), simulation_step_index)) {
+        held_key.next_shift_step = simulation_step_index;
+    }
+}
+
+void input::GameInput::release_holdable_key(const HoldableKey key) {
+    if (supports_das()) {
+        m_held_keys.at(std::to_underlying(key)).is_held = false;
     }
 }
@@ -4,10 +4,12 @@
 #include <core/helper/random.hpp>
 #include <core/helper/types.hpp>
 
+#include "auto_shift.hpp"
+#include "event_buffer.hpp"
 
 #include <SDL.h>
+#include <array>
 #include <functional>
-#include <unordered_map>
 
 struct SimulatedTetrion;
 
@@ -22,6 +24,8 @@ namespace input {
         Drop,
         Hold,
         ReleaseMoveDown,
+        MoveLeftToWall,
+        MoveRightToWall,
     };
 
     enum class GameInputType : u8 { Touch, Keyboard, JoyStick, Controller, Recording };
@@ -41,14 +45,24 @@ namespace input {
     public:
         using OnEventCallback = std::function<void(InputEvent, SimulationStep)>;
 
-    private:
-        static constexpr u64 delayed_auto_shift_frames = 10;
-        static constexpr u64 auto_repeat_rate_frames = 2;
+        struct HeldKey {
+            bool is_held{ false };
+            SimulationStep next_shift_step{ 0 };
+        };
+
+        // indexed by HoldableKey
+        using HeldKeys = std::array<HeldKey, 2>;
 
-        std::unordered_map<HoldableKey, u64> m_keys_hold;
+    private:
+        HeldKeys m_held_keys{};
+        AutoShiftTimings m_auto_shift_timings;
         GameInputType m_input_type;
         SimulatedTetrion* m_target_tetrion{};
         OnEventCallback m_on_event_callback;
+        EventBuffer::TimestampMapper m_timestamp_mapper;
+
+        void press_holdable_key(HoldableKey key, SimulationStep simulation_step_index);
+        void release_holdable_key(HoldableKey key);
 
     protected:
         explicit GameInput(GameInputType input_type) : m_input_type{ input_type } { }
@@ -63,6 +77,10 @@ namespace input {
             return m_on_event_callback;
         }
 
+        [[nodiscard]] const EventBuffer::TimestampMapper& timestamp_mapper() const {
+            return m_timestamp_mapper;
+        }
+
     public:
         GameInput(const GameInput&) = delete;
         GameInput& operator=(const GameInput&) = delete;
@@ -89,6 +107,24 @@ namespace input {
             return m_input_type != GameInputType::Touch;
         }
 
+        // replays have to use the timings of the recording, so that they stay exact
+        void set_auto_shift_timings(const AutoShiftTimings& timings) {
+            m_auto_shift_timings = timings;
+        }
+
+        [[nodiscard]] const AutoShiftTimings& auto_shift_timings() const {
+            return m_auto_shift_timings;
+        }
+
+        // the auto shift state has to be rewound together with the target tetrion
+        [[nodiscard]] const HeldKeys& held_keys() const {
+            return m_held_keys;
+        }
+
+        void set_held_keys(const HeldKeys& held_keys) {
+            m_held_keys = held_keys;
+        }
+
         void set_target_tetrion(SimulatedTetrion* target_tetrion) {
             m_target_tetrion = target_tetrion;
         }
@@ -97,6 +133,11 @@ namespace input {
             m_on_event_callback = std::move(on_event_callback);
         }
 
+        // set by the owner of the clock, that drives update(), it is only called from update()
+        void set_timestamp_mapper(EventBuffer::TimestampMapper timestamp_mapper) {
+            m_timestamp_mapper = std::move(timestamp_mapper);
+        }
+
 
         [[nodiscard]] virtual const Input* underlying_input() const = 0;
     };
@@ -5,11 +5,14 @@
 #include "input/controller_input.hpp"
 #include "joystick_input.hpp"
 #include "keyboard_input.hpp"
+#include "manager/event_listener.hpp"
 #include "manager/settings_manager.hpp"
 #include "mouse_input.hpp"
 #include "touch_input.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <spdlog/spdlog.h>
@@ -110,15 +113,38 @@ input::InputManager::InputManager(const std::shared_ptr<Window>& window) {
 
 [[nodiscard]] std::optional<input::PointerEventHelper> input::InputManager::get_pointer_event(const SDL_Event& event
 ) const {
+    if (get_event_category(event) != EventCategory::Pointer) {
+        return std::nullopt;
+    }
+
+    const auto cached = std::ranges::find_if(m_pointer_event_cache, [&event](const CachedPointerEvent& cached_event) {
+        return std::memcmp(&cached_event.event, &event, sizeof(SDL_Event)) == 0;
+    });
+    if (cached != m_pointer_event_cache.end()) {
+        return cached->pointer_event;
+    }
+
+    std::optional<PointerEventHelper> result = std::nullopt;
+
     for (const auto& input : m_inputs) {
         if (const auto pointer_input = utils::is_child_class<input::PointerInput>(input); pointer_input.has_value()) {
             if (const auto pointer_event = pointer_input.value()->get_pointer_event(event); pointer_event.has_value()) {
-                return pointer_event;
+                result = pointer_event;
+                break;
             }
         }
     }
 
-    return std::nullopt;
+    if (m_pointer_event_cache.size() >= pointer_event_cache_size) {
+        m_pointer_event_cache.erase(m_pointer_event_cache.begin());
+    }
+    m_pointer_event_cache.push_back(CachedPointerEvent{ .event = event, .pointer_event = result });
+
+    return result;
+}
+
+void input::InputManager::clear_pointer_event_cache() {
+    m_pointer_event_cache.clear();
 }
 
 
@@ -84,7 +84,16 @@ namespace input {
 
     struct InputManager {
     private:
+        struct CachedPointerEvent {
+            SDL_Event event;
+            std::optional<PointerEventHelper> pointer_event;
+        };
+
+        static constexpr usize pointer_event_cache_size = 8;
+
         std::vector<std::unique_ptr<Input>> m_inputs;
+        // every scene and layout asks for the pointer event of the same event again, so the results of the current frame are cached
+        mutable std::vector<CachedPointerEvent> m_pointer_event_cache;
 
     public:
         explicit InputManager(const std::shared_ptr<Window>& window);
@@ -95,6 +104,9 @@ namespace input {
 
         [[nodiscard]] std::optional<PointerEventHelper> get_pointer_event(const SDL_Event& event) const;
 
+        // has to be called every frame before the events are dispatched, since the conversion depends on e.g. the window size
+        void clear_pointer_event_cache();
+
         /**
         * @brief Offsets a pointer event, only safe to call, if get_pointer_event returns a non null optional
         * 
@@ -71,6 +71,15 @@ input::get_game_parameters_for_replay(
 
     const auto tetrion_headers = recording_reader->tetrion_headers();
 
+    // recordings without these were made with the previously hardcoded timings, which are the defaults
+    const auto& information = recording_reader->information();
+    const auto auto_shift_timings = AutoShiftTimings{
+        .delayed_auto_shift_frames = information.get_if<u32>("delayed_auto_shift_frames")
+                                             .value_or(AutoShiftTimings::default_delayed_auto_shift_frames),
+        .auto_repeat_rate_frames = information.get_if<u32>("auto_repeat_rate_frames")
+                                           .value_or(AutoShiftTimings::default_auto_repeat_rate_frames),
+    };
+
 
     result.reserve(tetrion_headers.size());
 
@@ -79,6 +88,7 @@ input::get_game_parameters_for_replay(
         const auto* primary_input = service_provider->input_manager().get_primary_input();
 
         auto input = std::make_unique<ReplayGameInput>(recording_reader, primary_input);
+        input->set_auto_shift_timings(auto_shift_timings);
 
         const auto& header = tetrion_headers.at(tetrion_index);
 
@@ -115,6 +125,11 @@ input::get_game_parameters_for_replay(
 
     const tetrion::StartingParameters starting_parameters = { target_fps, seed, starting_level, 0 };
 
+    // the replay has to repeat the moves at exactly the same steps
+    const auto& auto_shift_timings = input.value()->auto_shift_timings();
+    information.add<u32>("delayed_auto_shift_frames", auto_shift_timings.delayed_auto_shift_frames);
+    information.add<u32>("auto_repeat_rate_frames", auto_shift_timings.auto_repeat_rate_frames);
+
     AdditionalInfo result{ input.value(), starting_parameters };
 
 
@@ -0,0 +1,246 @@
+#include <core/helper/metrics.hpp>
+
+#include "input_thread.hpp"
+
+#include <algorithm>
+#include <array>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace {
+
+    struct EventRange {
+        u32 first;
+        u32 last;
+    };
+
+    // the events, that are taken by the input thread, device added and removed events stay on the main thread
+    constexpr std::array<EventRange, 4> input_event_ranges{
+        EventRange{               .first = SDL_KEYDOWN,                  .last = SDL_KEYUP },
+        EventRange{        .first = SDL_JOYAXISMOTION,              .last = SDL_JOYBUTTONUP },
+        EventRange{ .first = SDL_CONTROLLERAXISMOTION,       .last = SDL_CONTROLLERBUTTONUP },
+        EventRange{           .first = SDL_FINGERDOWN,             .last = SDL_FINGERMOTION },
+    };
+
+    constexpr usize events_per_peep = 64;
+
+    [[nodiscard]] bool is_input_event(const SDL_Event& event) {
+        return std::ranges::any_of(input_event_ranges, [&event](const EventRange& range) {
+            return event.type >= range.first and event.type <= range.last;
+        });
+    }
+
+    // calls the callback for every event in the range, that is currently in the SDL event queue, and removes it
+    template<typename Callback>
+    void take_events(const EventRange& range, const Callback& callback) {
+        std::array<SDL_Event, events_per_peep> events{};
+
+        while (true) {
+            const auto count = SDL_PeepEvents(
+                    events.data(), static_cast<int>(events.size()), SDL_GETEVENT, range.first, range.last
+            );
+            if (count <= 0) {
+                return;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                callback(events.at(static_cast<usize>(i)));
+            }
+
+            if (count < static_cast<int>(events.size())) {
+                return;
+            }
+        }
+    }
+
+    void push_event(input::InputSubscription& subscription, const input::TimedEvent& event) {
+        if (subscription.is_paused.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        if (not subscription.queue.try_push(event)) {
+            static auto& dropped_events = metrics::Registry::global().counter(
+                    "oopetris_input_events_dropped_total", "input events, that were dropped, since a queue was full"
+            );
+            dropped_events.add();
+        }
+    }
+
+} // namespace
+
+
+input::InputThread::InputThread(std::vector<sdl::Key> allowed_text_input_keys)
+    : m_allowed_text_input_keys{ std::move(allowed_text_input_keys) } {
+    SDL_SetHint(SDL_HINT_JOYSTICK_THREAD, "1");
+    SDL_AddEventWatch(on_event_added, this);
+
+    m_thread = std::thread{ [this] { run(); } };
+}
+
+input::InputThread::~InputThread() {
+    SDL_DelEventWatch(on_event_added, this);
+
+    {
+        const std::lock_guard lock{ m_wake_mutex };
+        m_is_running.store(false, std::memory_order_release);
+    }
+    m_wake_condition.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+[[nodiscard]] std::shared_ptr<input::InputSubscription> input::InputThread::subscribe(const EventCategory category) {
+    auto subscription = std::make_shared<InputSubscription>(category);
+
+    const std::lock_guard lock{ m_mutex };
+    m_subscriptions.push_back(subscription);
+
+    return subscription;
+}
+
+[[nodiscard]] std::vector<SDL_Event> input::InputThread::take_main_thread_events() {
+    SDL_PumpEvents();
+
+    std::vector<SDL_Event> result{};
+
+    // all events between the input ranges
+    u32 first = SDL_FIRSTEVENT;
+    for (const auto& range : input_event_ranges) {
+        take_events(EventRange{ .first = first, .last = range.first - 1 }, [&result](const SDL_Event& event) {
+            result.push_back(event);
+        });
+        first = range.last + 1;
+    }
+    take_events(EventRange{ .first = first, .last = SDL_LASTEVENT }, [&result](const SDL_Event& event) {
+        result.push_back(event);
+    });
+
+    while (auto event = m_main_thread.queue.try_pop()) {
+        result.push_back(event->event);
+    }
+
+    // the input events were taken out of the SDL queue earlier, so they have to be put back in between the other events
+    std::ranges::stable_sort(result, {}, [](const SDL_Event& event) { return event.common.timestamp; });
+
+    return result;
+}
+
+void input::InputThread::discard_main_thread_events() {
+    while (m_main_thread.queue.try_pop().has_value()) { }
+}
+
+void input::InputThread::set_enabled(const bool enabled) {
+    m_is_enabled.store(enabled, std::memory_order_release);
+}
+
+void input::InputThread::set_text_input_active(const bool active) {
+    m_is_text_input_active.store(active, std::memory_order_release);
+}
+
+int input::InputThread::on_event_added(void* userdata, SDL_Event* event) {
+    if (is_input_event(*event)) {
+        auto* const input_thread = static_cast<InputThread*>(userdata);
+        {
+            const std::lock_guard lock{ input_thread->m_wake_mutex };
+            ++input_thread->m_num_announced_events;
+        }
+        input_thread->m_wake_condition.notify_one();
+    }
+
+    // the return value of event watches is ignored
+    return 0;
+}
+
+void input::InputThread::run() {
+    spdlog::debug("starting input thread");
+
+    while (true) {
+        {
+            std::unique_lock lock{ m_wake_mutex };
+            m_wake_condition.wait_for(lock, idle_poll_interval, [this] {
+                return m_num_announced_events > 0 or not m_is_running.load(std::memory_order_acquire);
+            });
+        }
+
+        if (not m_is_running.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        take_announced_events();
+    }
+
+    spdlog::debug("stopping input thread");
+}
+
+void input::InputThread::take_announced_events() {
+    const auto deadline = std::chrono::steady_clock::now() + announced_event_timeout;
+
+    while (true) {
+        const auto num_taken = poll_input_events();
+
+        {
+            const std::lock_guard lock{ m_wake_mutex };
+            m_num_announced_events -= std::min(m_num_announced_events, num_taken);
+
+            // an announced event, that never arrives, e.g. since the SDL queue was full, mustn't keep the thread busy
+            if (m_num_announced_events == 0 or std::chrono::steady_clock::now() >= deadline) {
+                m_num_announced_events = 0;
+                return;
+            }
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+[[nodiscard]] usize input::InputThread::poll_input_events() {
+    const std::lock_guard lock{ m_mutex };
+
+    std::erase_if(m_subscriptions, [](const std::weak_ptr<InputSubscription>& subscription) {
+        return subscription.expired();
+    });
+
+    usize num_taken = 0;
+
+    for (const auto& range : input_event_ranges) {
+        take_events(range, [this, &num_taken](const SDL_Event& event) {
+            ++num_taken;
+            if (not is_accepted(event)) {
+                return;
+            }
+
+            const TimedEvent timed_event{ .event = event, .received_at = std::chrono::steady_clock::now() };
+            const auto category = get_event_category(event);
+
+            push_event(m_main_thread, timed_event);
+
+            for (const auto& weak_subscription : m_subscriptions) {
+                if (auto subscription = weak_subscription.lock()) {
+                    if (subscription->category.has_value() and subscription->category != category) {
+                        continue;
+                    }
+
+                    push_event(*subscription, timed_event);
+                }
+            }
+        });
+    }
+
+    return num_taken;
+}
+
+[[nodiscard]] bool input::InputThread::is_accepted(const SDL_Event& event) const {
+    if (not m_is_enabled.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // the same keys, that the event dispatcher allows, so that e.g. typing a name doesn't move the tetromino
+    if (m_is_text_input_active.load(std::memory_order_acquire) and get_event_category(event) == EventCategory::Key) {
+        return std::ranges::find(m_allowed_text_input_keys, sdl::Key{ event.key.keysym })
+               != m_allowed_text_input_keys.cend();
+    }
+
+    return true;
+}
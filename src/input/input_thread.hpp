@@ -0,0 +1,102 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "helper/spsc_queue.hpp"
+#include "manager/event_listener.hpp"
+#include "manager/sdl_key.hpp"
+
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace input {
+
+    struct TimedEvent {
+        SDL_Event event;
+        // SDL timestamps only have a resolution of milliseconds
+        std::chrono::steady_clock::time_point received_at;
+    };
+
+    // the events of one consumer, e.g. a game input, the input thread is the only producer
+    struct InputSubscription final {
+        static constexpr usize capacity = 256;
+
+        helper::SpscQueue<TimedEvent, capacity> queue;
+        // while paused, no events are pushed, so that they aren't applied after resuming
+        std::atomic<bool> is_paused{ false };
+        // only events of this category are pushed, all, if it isn't set
+        std::optional<EventCategory> category;
+
+        explicit InputSubscription(std::optional<EventCategory> category = std::nullopt) : category{ category } { }
+    };
+
+    // takes the keyboard, joystick, controller and touch events out of the SDL event queue at a high frequency and pushes them into the queues of the subscribers, so that e.g. the simulation thread gets them without waiting for the next frame
+    // SDL only allows pumping events on the main thread, so this can only take the events SDL already queued: events from its own joystick thread immediately, keyboard events after the next SDL_PumpEvents of the main thread
+    // an event watch wakes the thread, when an input event is pushed, so it doesn't have to poll the queue all the time
+    struct InputThread final {
+    private:
+        // SDL calls the event watches right before the event is added to the queue, so the thread polls for this long, until it got all announced events
+        static constexpr auto announced_event_timeout = std::chrono::milliseconds{ 1 };
+        // in case an event isn't announced, e.g. since it was added with SDL_PeepEvents
+        static constexpr auto idle_poll_interval = std::chrono::milliseconds{ 50 };
+
+        std::mutex m_mutex;
+        std::vector<std::weak_ptr<InputSubscription>> m_subscriptions;
+
+        // the input events also have to be handled by the event dispatcher, e.g. for the pause menu
+        InputSubscription m_main_thread;
+
+        // the state of the event dispatcher, the events it wouldn't dispatch aren't pushed to any subscription
+        std::atomic<bool> m_is_enabled{ true };
+        std::atomic<bool> m_is_text_input_active{ false };
+        std::vector<sdl::Key> m_allowed_text_input_keys;
+
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake_condition;
+        // the input events, that were pushed, but not yet taken
+        usize m_num_announced_events{ 0 };
+
+        std::atomic<bool> m_is_running{ true };
+        std::thread m_thread;
+
+    public:
+        // has to be created before the joystick subsystem is initialized, so that SDL uses a separate thread for joysticks
+        explicit InputThread(std::vector<sdl::Key> allowed_text_input_keys);
+
+        InputThread(const InputThread&) = delete;
+        InputThread& operator=(const InputThread&) = delete;
+        InputThread(InputThread&&) = delete;
+        InputThread& operator=(InputThread&&) = delete;
+
+        ~InputThread();
+
+        [[nodiscard]] std::shared_ptr<InputSubscription> subscribe(EventCategory category);
+
+        // main thread: pumps the SDL events and returns all pending events in the order of their timestamps, the input events come from the input thread
+        [[nodiscard]] std::vector<SDL_Event> take_main_thread_events();
+
+        // main thread: drops the input events, that weren't taken yet
+        void discard_main_thread_events();
+
+        void set_enabled(bool enabled);
+
+        // while text input is active, only the allowed text input keys are pushed
+        void set_text_input_active(bool active);
+
+    private:
+        static int on_event_added(void* userdata, SDL_Event* event);
+
+        void run();
+        void take_announced_events();
+        [[nodiscard]] usize poll_input_events();
+        [[nodiscard]] bool is_accepted(const SDL_Event& event) const;
+    };
+
+} // namespace input
@@ -4,7 +4,9 @@
 #include <core/helper/utils.hpp>
 
 #include "controller_input.hpp"
+#include "helper/asset_archive.hpp"
 #include "helper/graphic_utils.hpp"
+#include "helper/startup_timer.hpp"
 #include "input/game_input.hpp"
 #include "input/input.hpp"
 #include "joystick_input.hpp"
@@ -120,10 +122,12 @@ void input::JoyStickInputManager::discover_devices(std::vector<std::unique_ptr<I
 
     const auto mappings_file = utils::get_assets_folder() / "mappings" / "gamecontrollerdb.txt";
 
-    if (not std::filesystem::exists(mappings_file)) {
+    if (not helper::assets::exists(mappings_file)) {
         spdlog::warn("Mappings file doesn't exist: {}", mappings_file.string());
     } else {
-        const auto mapped_number = SDL_GameControllerAddMappingsFromFile(mappings_file.string().c_str());
+        const helper::startup::Phase phase{ "controller mappings" };
+
+        const auto mapped_number = SDL_GameControllerAddMappingsFromRW(helper::assets::open(mappings_file), 1);
 
         if (mapped_number < 0) {
             // this is just a warning, no need to abort here, since we just have less mappings
@@ -134,6 +138,8 @@ void input::JoyStickInputManager::discover_devices(std::vector<std::unique_ptr<I
     }
 
 
+    const helper::startup::Phase phase{ "joystick enumeration" };
+
     const auto num_of_joysticks = SDL_NumJoysticks();
 
     if (num_of_joysticks < 0) {
@@ -472,6 +478,8 @@ input::SwitchJoystickInput_Type1::SwitchJoystickInput_Type1(
 
 #undef X_LIST_MACRO
 
+    result.auto_shift = settings.auto_shift;
+
     return result;
 }
 
@@ -489,7 +497,8 @@ input::SwitchJoystickInput_Type1::default_settings_raw() const {
                 .drop = JOYCON_X,
                 .hold = JOYCON_B,
                 .pause = JOYCON_MINUS,
-                .open_settings = JOYCON_PLUS
+                .open_settings = JOYCON_PLUS,
+                .auto_shift = AutoShiftTimings{},
     };
 
     return settings;
@@ -633,6 +642,8 @@ input::_3DSJoystickInput_Type1::_3DSJoystickInput_Type1(
 
 #undef X_LIST_MACRO
 
+    result.auto_shift = settings.auto_shift;
+
     return result;
 }
 [[nodiscard]] input::AbstractJoystickSettings<input::console::SettingsType>
@@ -649,7 +660,8 @@ input::_3DSJoystickInput_Type1::default_settings_raw() const {
                 .drop = JOYCON_X,
                 .hold = JOYCON_B,
                 .pause = JOYCON_START,
-                .open_settings = JOYCON_SELECT
+                .open_settings = JOYCON_SELECT,
+                .auto_shift = AutoShiftTimings{},
     };
 
     return settings;
@@ -663,8 +675,9 @@ input::_3DSJoystickInput_Type1::default_settings_raw() const {
 input::JoystickLikeGameInput::JoystickLikeGameInput(EventDispatcher* event_dispatcher, JoystickLikeType type)
     : GameInput{ type == JoystickLikeType::Joystick ? input::GameInputType::JoyStick
                                                     : input::GameInputType::Controller },
+      m_event_buffer{ event_dispatcher->subscribe_to_input_thread(EventCategory::Controller) },
       m_event_dispatcher{ event_dispatcher } {
-    m_event_dispatcher->register_listener(this);
+    m_event_dispatcher->register_listener(this, { EventCategory::Controller });
 }
 
 
@@ -677,17 +690,21 @@ input::JoystickLikeGameInput::JoystickLikeGameInput(JoystickLikeGameInput&& inpu
 ) noexcept = default;
 
 void input::JoystickLikeGameInput::handle_event(const SDL_Event& event) {
-    m_event_buffer.push_back(event);
+    m_event_buffer.push(event);
+}
+
+void input::JoystickLikeGameInput::set_paused(const bool is_paused) {
+    EventListener::set_paused(is_paused);
+    m_event_buffer.set_paused(is_paused);
 }
 
 void input::JoystickLikeGameInput::update(SimulationStep simulation_step_index) {
-    for (const auto& event : m_event_buffer) {
+    for (const auto& event : m_event_buffer.take(simulation_step_index, timestamp_mapper())) {
         const auto input_event = sdl_event_to_input_event(event);
         if (input_event.has_value()) {
             GameInput::handle_event(*input_event, simulation_step_index);
         }
     }
-    m_event_buffer.clear();
 
     GameInput::update(simulation_step_index);
 }
@@ -857,6 +874,8 @@ input::ConsoleJoystickGameInput::ConsoleJoystickGameInput(
 
         m_settings = m_underlying_input->default_settings_raw();
     }
+
+    set_auto_shift_timings(m_settings.auto_shift);
 }
 
 input::ConsoleJoystickGameInput::~ConsoleJoystickGameInput() = default;
@@ -3,9 +3,11 @@
 #include <core/helper/expected.hpp>
 #include <core/helper/parse_json.hpp>
 
+#include "auto_shift.hpp"
 #include "guid.hpp"
 #include "input.hpp"
 #include "input/console_buttons.hpp"
+#include "input/event_buffer.hpp"
 #include "input/game_input.hpp"
 #include "manager/event_dispatcher.hpp"
 
@@ -43,6 +45,7 @@ namespace input {
         T pause;
         T open_settings;
 
+        AutoShiftTimings auto_shift;
 
         [[nodiscard]] helper::expected<void, std::string> validate() const {
             const std::vector<std::string> to_use{ rotate_left, rotate_right, move_left, move_right,   move_down,
@@ -233,7 +236,7 @@ namespace input {
 
     struct JoystickLikeGameInput : public GameInput, public EventListener {
     private:
-        std::vector<SDL_Event> m_event_buffer;
+        EventBuffer m_event_buffer;
         EventDispatcher* m_event_dispatcher;
 
     public:
@@ -248,6 +251,7 @@ namespace input {
         [[nodiscard]] JoystickLikeGameInput& operator=(JoystickLikeGameInput&& input) noexcept;
 
         void handle_event(const SDL_Event& event) override;
+        void set_paused(bool is_paused) override;
 
         void update(SimulationStep simulation_step_index) override;
 
@@ -374,7 +378,7 @@ namespace nlohmann {
 
             ::json::check_for_no_additional_keys(
                     obj, { "type", "identification", "rotate_left", "rotate_right", "move_left", "move_right",
-                           "move_down", "drop", "hold", "menu" }
+                           "move_down", "drop", "hold", "menu", "auto_shift" }
             );
 
             const input::JoystickIdentification identification =
@@ -404,7 +408,8 @@ namespace nlohmann {
                                                      .drop = drop,
                                                      .hold = hold,
                                                      .pause = pause,
-                                                     .open_settings = open_settings };
+                                                     .open_settings = open_settings,
+                                                     .auto_shift = json_helper::get_auto_shift_timings(obj) };
 
             const auto is_valid = settings.validate();
             if (not is_valid.has_value()) {
@@ -432,7 +437,8 @@ namespace nlohmann {
                  "menu", nlohmann::json{
                                 { "pause", settings.pause },
                                 { "open_settings", settings.open_settings },
-                        }, }
+                        }, },
+                { "auto_shift", settings.auto_shift },
             };
         }
     };
@@ -80,17 +80,21 @@ input::KeyboardInput::KeyboardInput() : input::Input{ "keyboard", InputType::Key
 
 
 void input::KeyboardGameInput::handle_event(const SDL_Event& event) {
-    m_event_buffer.push_back(event);
+    m_event_buffer.push(event);
+}
+
+void input::KeyboardGameInput::set_paused(const bool is_paused) {
+    EventListener::set_paused(is_paused);
+    m_event_buffer.set_paused(is_paused);
 }
 
 void input::KeyboardGameInput::update(SimulationStep simulation_step_index) {
-    for (const auto& event : m_event_buffer) {
+    for (const auto& event : m_event_buffer.take(simulation_step_index, timestamp_mapper())) {
         const auto input_event = sdl_event_to_input_event(event);
         if (input_event.has_value()) {
             GameInput::handle_event(*input_event, simulation_step_index);
         }
     }
-    m_event_buffer.clear();
 
     GameInput::update(simulation_step_index);
 }
@@ -149,8 +153,10 @@ std::optional<InputEvent> input::KeyboardGameInput::sdl_event_to_input_event(con
 input::KeyboardGameInput::KeyboardGameInput(const KeyboardSettings& settings, EventDispatcher* event_dispatcher)
     : GameInput{ GameInputType::Keyboard },
       m_settings{ settings },
+      m_event_buffer{ event_dispatcher->subscribe_to_input_thread(EventCategory::Key) },
       m_event_dispatcher{ event_dispatcher } {
-    m_event_dispatcher->register_listener(this);
+    set_auto_shift_timings(m_settings.auto_shift);
+    m_event_dispatcher->register_listener(this, { EventCategory::Key });
 }
 
 input::KeyboardGameInput::~KeyboardGameInput() {
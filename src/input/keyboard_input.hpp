@@ -3,6 +3,8 @@
 #include <core/helper/expected.hpp>
 #include <core/helper/parse_json.hpp>
 
+#include "auto_shift.hpp"
+#include "event_buffer.hpp"
 #include "game_input.hpp"
 #include "input.hpp"
 #include "manager/event_dispatcher.hpp"
@@ -38,6 +40,7 @@ namespace input {
         sdl::Key pause;
         sdl::Key open_settings;
 
+        AutoShiftTimings auto_shift;
 
         [[nodiscard]] helper::expected<void, std::string> validate() const;
 
@@ -50,7 +53,8 @@ namespace input {
                                      .drop = sdl::Key{ SDLK_w },
                                      .hold = sdl::Key{ SDLK_TAB },
                                      .pause = sdl::Key{ SDLK_SPACE },
-                                     .open_settings = sdl::Key{ SDLK_e } };
+                                     .open_settings = sdl::Key{ SDLK_e },
+                                     .auto_shift = AutoShiftTimings{} };
         }
     };
 
@@ -58,7 +62,7 @@ namespace input {
     struct KeyboardGameInput : public GameInput, public EventListener {
     private:
         KeyboardSettings m_settings;
-        std::vector<SDL_Event> m_event_buffer;
+        EventBuffer m_event_buffer;
         EventDispatcher* m_event_dispatcher;
         KeyboardInput m_underlying_input;
 
@@ -75,6 +79,7 @@ namespace input {
 
 
         void handle_event(const SDL_Event& event) override;
+        void set_paused(bool is_paused) override;
 
         void update(SimulationStep simulation_step_index) override;
 
@@ -105,7 +110,7 @@ namespace nlohmann {
 
             ::json::check_for_no_additional_keys(
                     obj, { "type", "rotate_left", "rotate_right", "move_left", "move_right", "move_down", "drop",
-                           "hold", "menu" }
+                           "hold", "menu", "auto_shift" }
             );
 
             const auto rotate_left = json_helper::get_key(obj, "rotate_left");
@@ -131,7 +136,8 @@ namespace nlohmann {
                                                      .drop = drop,
                                                      .hold = hold,
                                                      .pause = pause,
-                                                     .open_settings = open_settings };
+                                                     .open_settings = open_settings,
+                                                     .auto_shift = json_helper::get_auto_shift_timings(obj) };
 
             const auto is_valid = settings.validate();
             if (not is_valid.has_value()) {
@@ -154,7 +160,8 @@ namespace nlohmann {
                  "menu", nlohmann::json{
                                 { "pause", settings.pause.to_string() },
                                 { "open_settings", settings.open_settings.to_string() },
-                        }, }
+                        }, },
+                { "auto_shift", settings.auto_shift },
             };
         }
     };
@@ -11,17 +11,21 @@
 #include <stdexcept>
 
 void input::TouchGameInput::handle_event(const SDL_Event& event) {
-    m_event_buffer.push_back(event);
+    m_event_buffer.push(event);
+}
+
+void input::TouchGameInput::set_paused(const bool is_paused) {
+    EventListener::set_paused(is_paused);
+    m_event_buffer.set_paused(is_paused);
 }
 
 void input::TouchGameInput::update(SimulationStep simulation_step_index) {
-    for (const auto& event : m_event_buffer) {
+    for (const auto& event : m_event_buffer.take(simulation_step_index, timestamp_mapper())) {
         const auto input_event = sdl_event_to_input_event(event);
         if (input_event.has_value()) {
             GameInput::handle_event(*input_event, simulation_step_index);
         }
     }
-    m_event_buffer.clear();
 
     GameInput::update(simulation_step_index);
 }
@@ -149,9 +153,10 @@ input::TouchGameInput::TouchGameInput(
 )
     : GameInput{ GameInputType::Touch },
       m_settings{ settings },
+      m_event_buffer{ event_dispatcher->subscribe_to_input_thread(EventCategory::Pointer) },
       m_event_dispatcher{ event_dispatcher },
       m_underlying_input{ underlying_input } {
-    m_event_dispatcher->register_listener(this);
+    m_event_dispatcher->register_listener(this, { EventCategory::Pointer });
 }
 
 input::TouchGameInput::~TouchGameInput() {
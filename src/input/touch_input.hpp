@@ -4,6 +4,7 @@
 #include <core/helper/parse_json.hpp>
 
 #include "input.hpp"
+#include "input/event_buffer.hpp"
 #include "input/game_input.hpp"
 #include "manager/event_dispatcher.hpp"
 #include <limits>
@@ -71,7 +72,7 @@ namespace input {
         TouchSettings m_settings;
 
         std::unordered_map<SDL_FingerID, std::optional<PressedState>> m_finger_state;
-        std::vector<SDL_Event> m_event_buffer;
+        EventBuffer m_event_buffer;
         EventDispatcher* m_event_dispatcher;
         TouchInput* m_underlying_input;
 
@@ -92,6 +93,7 @@ namespace input {
         [[nodiscard]] TouchGameInput& operator=(TouchGameInput&& input) noexcept;
 
         void handle_event(const SDL_Event& event) override;
+        void set_paused(bool is_paused) override;
         void update(SimulationStep simulation_step_index) override;
 
         [[nodiscard]] std::optional<MenuEvent> get_menu_event(const SDL_Event& event) const override;
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <fmt/format.h>
 #include <ostream>
+#include <span>
 #include <string>
 
 struct Color;
@@ -259,3 +260,14 @@ struct Color {
 
     std::ostream& operator<<(std::ostream& os) const;
 };
+
+namespace color {
+
+    // converts many colors at once, using SIMD instructions, if they are available on the target (AVX2, SSE2 or NEON)
+    // the results are bit-exact with HSVColor::to_rgb_color() and Color::to_hsv_color()
+    // `to` has to be at least as big as `from`
+    void to_rgb_colors(std::span<const HSVColor> from, std::span<Color> to);
+
+    void to_hsv_colors(std::span<const Color> from, std::span<HSVColor> to);
+
+} // namespace color
@@ -0,0 +1,416 @@
+#include "./color.hpp"
+
+#include <array>
+#include <cassert>
+
+#if defined(__AVX2__)
+#define OOPETRIS_COLOR_SIMD
+#define OOPETRIS_COLOR_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OOPETRIS_COLOR_SIMD
+#define OOPETRIS_COLOR_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OOPETRIS_COLOR_SIMD
+#define OOPETRIS_COLOR_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// the SIMD code paths are a lane wise translation of the scalar code in Color(const HSVColor&) and Color::to_hsv_color()
+// they only use IEEE operations, that are exact or correctly rounded (add, sub, mul, div, min, max, abs, trunc), in the same order as the scalar code, so that the results are bit-exact
+
+namespace {
+
+#if defined(OOPETRIS_COLOR_SIMD_AVX2)
+
+    struct Simd {
+        using Vector = __m256d;
+        using Mask = __m256d;
+
+        static constexpr usize lanes = 4;
+
+        [[nodiscard]] static Vector load(const double* values) {
+            return _mm256_loadu_pd(values);
+        }
+
+        static void store(double* destination, Vector value) {
+            _mm256_storeu_pd(destination, value);
+        }
+
+        [[nodiscard]] static Vector broadcast(double value) {
+            return _mm256_set1_pd(value);
+        }
+
+        [[nodiscard]] static Vector add(Vector lhs, Vector rhs) {
+            return _mm256_add_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector sub(Vector lhs, Vector rhs) {
+            return _mm256_sub_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector mul(Vector lhs, Vector rhs) {
+            return _mm256_mul_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector div(Vector lhs, Vector rhs) {
+            return _mm256_div_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector min(Vector lhs, Vector rhs) {
+            return _mm256_min_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector max(Vector lhs, Vector rhs) {
+            return _mm256_max_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector abs(Vector value) {
+            return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+        }
+
+        [[nodiscard]] static Vector trunc(Vector value) {
+            return _mm256_round_pd(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+
+        [[nodiscard]] static Mask equal(Vector lhs, Vector rhs) {
+            return _mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ);
+        }
+
+        [[nodiscard]] static Mask greater_equal(Vector lhs, Vector rhs) {
+            return _mm256_cmp_pd(lhs, rhs, _CMP_GE_OQ);
+        }
+
+        [[nodiscard]] static Mask less(Vector lhs, Vector rhs) {
+            return _mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ);
+        }
+
+        [[nodiscard]] static Mask either(Mask lhs, Mask rhs) {
+            return _mm256_or_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector select(Mask mask, Vector if_true, Vector if_false) {
+            return _mm256_blendv_pd(if_false, if_true, mask);
+        }
+    };
+
+#elif defined(OOPETRIS_COLOR_SIMD_SSE2)
+
+    struct Simd {
+        using Vector = __m128d;
+        using Mask = __m128d;
+
+        static constexpr usize lanes = 2;
+
+        [[nodiscard]] static Vector load(const double* values) {
+            return _mm_loadu_pd(values);
+        }
+
+        static void store(double* destination, Vector value) {
+            _mm_storeu_pd(destination, value);
+        }
+
+        [[nodiscard]] static Vector broadcast(double value) {
+            return _mm_set1_pd(value);
+        }
+
+        [[nodiscard]] static Vector add(Vector lhs, Vector rhs) {
+            return _mm_add_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector sub(Vector lhs, Vector rhs) {
+            return _mm_sub_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector mul(Vector lhs, Vector rhs) {
+            return _mm_mul_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector div(Vector lhs, Vector rhs) {
+            return _mm_div_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector min(Vector lhs, Vector rhs) {
+            return _mm_min_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector max(Vector lhs, Vector rhs) {
+            return _mm_max_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector abs(Vector value) {
+            return _mm_andnot_pd(_mm_set1_pd(-0.0), value);
+        }
+
+        // SSE2 has no rounding instruction, so this goes through 32 bit integers, this is only correct for values in the i32 range, which is always the case here
+        [[nodiscard]] static Vector trunc(Vector value) {
+            return _mm_cvtepi32_pd(_mm_cvttpd_epi32(value));
+        }
+
+        [[nodiscard]] static Mask equal(Vector lhs, Vector rhs) {
+            return _mm_cmpeq_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask greater_equal(Vector lhs, Vector rhs) {
+            return _mm_cmpge_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask less(Vector lhs, Vector rhs) {
+            return _mm_cmplt_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask either(Mask lhs, Mask rhs) {
+            return _mm_or_pd(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector select(Mask mask, Vector if_true, Vector if_false) {
+            return _mm_or_pd(_mm_and_pd(mask, if_true), _mm_andnot_pd(mask, if_false));
+        }
+    };
+
+#elif defined(OOPETRIS_COLOR_SIMD_NEON)
+
+    struct Simd {
+        using Vector = float64x2_t;
+        using Mask = uint64x2_t;
+
+        static constexpr usize lanes = 2;
+
+        [[nodiscard]] static Vector load(const double* values) {
+            return vld1q_f64(values);
+        }
+
+        static void store(double* destination, Vector value) {
+            vst1q_f64(destination, value);
+        }
+
+        [[nodiscard]] static Vector broadcast(double value) {
+            return vdupq_n_f64(value);
+        }
+
+        [[nodiscard]] static Vector add(Vector lhs, Vector rhs) {
+            return vaddq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector sub(Vector lhs, Vector rhs) {
+            return vsubq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector mul(Vector lhs, Vector rhs) {
+            return vmulq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector div(Vector lhs, Vector rhs) {
+            return vdivq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector min(Vector lhs, Vector rhs) {
+            return vminq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector max(Vector lhs, Vector rhs) {
+            return vmaxq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector abs(Vector value) {
+            return vabsq_f64(value);
+        }
+
+        [[nodiscard]] static Vector trunc(Vector value) {
+            return vrndq_f64(value);
+        }
+
+        [[nodiscard]] static Mask equal(Vector lhs, Vector rhs) {
+            return vceqq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask greater_equal(Vector lhs, Vector rhs) {
+            return vcgeq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask less(Vector lhs, Vector rhs) {
+            return vcltq_f64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Mask either(Mask lhs, Mask rhs) {
+            return vorrq_u64(lhs, rhs);
+        }
+
+        [[nodiscard]] static Vector select(Mask mask, Vector if_true, Vector if_false) {
+            return vbslq_f64(mask, if_true, if_false);
+        }
+    };
+
+#endif
+
+#if defined(OOPETRIS_COLOR_SIMD)
+
+    using Vector = Simd::Vector;
+    using Lanes = std::array<double, Simd::lanes>;
+
+    // std::round for positive values
+    [[nodiscard]] Vector round_positive(Vector value) {
+        const auto truncated = Simd::trunc(value);
+        const auto round_up = Simd::greater_equal(Simd::sub(value, truncated), Simd::broadcast(0.5));
+        return Simd::select(round_up, Simd::add(truncated, Simd::broadcast(1.0)), truncated);
+    }
+
+    // converts exactly Simd::lanes colors
+    void to_rgb_colors_simd(const HSVColor* from, Color* to) {
+
+        Lanes hues{};
+        Lanes saturations{};
+        Lanes values{};
+
+        for (usize lane = 0; lane < Simd::lanes; ++lane) {
+            hues[lane] = from[lane].h;
+            saturations[lane] = from[lane].s;
+            values[lane] = from[lane].v;
+        }
+
+        const auto zero = Simd::broadcast(0.0);
+        const auto one = Simd::broadcast(1.0);
+        const auto two = Simd::broadcast(2.0);
+
+        auto hue = Simd::load(hues.data());
+        const auto saturation = Simd::load(saturations.data());
+        const auto value = Simd::load(values.data());
+
+        const auto chroma = Simd::mul(value, saturation);
+
+        hue = Simd::select(Simd::greater_equal(hue, Simd::broadcast(360.0)), zero, hue);
+
+        const auto sector = Simd::div(hue, Simd::broadcast(60.0));
+
+        // fmod(sector, 2.0), both the multiplication by 0.5 and the subtraction are exact
+        const auto sector_mod_2 = Simd::sub(sector, Simd::mul(Simd::trunc(Simd::mul(sector, Simd::broadcast(0.5))), two));
+
+        const auto x_offset = Simd::mul(chroma, Simd::sub(one, Simd::abs(Simd::sub(sector_mod_2, one))));
+
+        const auto index = Simd::trunc(sector);
+
+        // the lanes, where the index is one of the given values
+        const auto is_index = [&index](double first, double second) {
+            return Simd::either(
+                    Simd::equal(index, Simd::broadcast(first)), Simd::equal(index, Simd::broadcast(second))
+            );
+        };
+
+        const auto d_r =
+                Simd::select(is_index(0.0, 5.0), chroma, Simd::select(is_index(1.0, 4.0), x_offset, zero));
+        const auto d_g =
+                Simd::select(is_index(1.0, 2.0), chroma, Simd::select(is_index(0.0, 3.0), x_offset, zero));
+        const auto d_b =
+                Simd::select(is_index(3.0, 4.0), chroma, Simd::select(is_index(2.0, 5.0), x_offset, zero));
+
+        const auto offset = Simd::sub(value, chroma);
+
+        const auto finish_value = [&](Vector channel) -> Lanes {
+            const auto clamped = Simd::min(Simd::max(Simd::add(channel, offset), zero), one);
+
+            Lanes result{};
+            Simd::store(result.data(), round_positive(Simd::mul(clamped, Simd::broadcast(static_cast<double>(0xFF)))));
+            return result;
+        };
+
+        const auto red = finish_value(d_r);
+        const auto green = finish_value(d_g);
+        const auto blue = finish_value(d_b);
+
+        for (usize lane = 0; lane < Simd::lanes; ++lane) {
+            to[lane] = Color{ static_cast<u8>(red[lane]), static_cast<u8>(green[lane]), static_cast<u8>(blue[lane]),
+                              from[lane].a };
+        }
+    }
+
+    // converts exactly Simd::lanes colors
+    void to_hsv_colors_simd(const Color* from, HSVColor* to) {
+
+        Lanes reds{};
+        Lanes greens{};
+        Lanes blues{};
+
+        for (usize lane = 0; lane < Simd::lanes; ++lane) {
+            reds[lane] = static_cast<double>(from[lane].r);
+            greens[lane] = static_cast<double>(from[lane].g);
+            blues[lane] = static_cast<double>(from[lane].b);
+        }
+
+        const auto zero = Simd::broadcast(0.0);
+        const auto max_d = Simd::broadcast(static_cast<double>(0xFF));
+
+        const auto r_d = Simd::div(Simd::load(reds.data()), max_d);
+        const auto g_d = Simd::div(Simd::load(greens.data()), max_d);
+        const auto b_d = Simd::div(Simd::load(blues.data()), max_d);
+
+        const auto min = Simd::min(Simd::min(r_d, g_d), b_d);
+        const auto max = Simd::max(Simd::max(r_d, g_d), b_d);
+        const auto delta = Simd::sub(max, min);
+
+        // lanes, where delta is zero, produce garbage here, but they are never selected
+        auto h_red = Simd::div(Simd::sub(g_d, b_d), delta);
+        h_red = Simd::select(Simd::less(h_red, zero), Simd::add(h_red, Simd::broadcast(6.0)), h_red);
+
+        const auto h_green = Simd::add(Simd::broadcast(2.0), Simd::div(Simd::sub(b_d, r_d), delta));
+        const auto h_blue = Simd::add(Simd::broadcast(4.0), Simd::div(Simd::sub(r_d, g_d), delta));
+
+        const auto h_temp = Simd::select(
+                Simd::equal(min, max), zero,
+                Simd::select(
+                        Simd::greater_equal(r_d, max), h_red,
+                        Simd::select(Simd::greater_equal(g_d, max), h_green, h_blue)
+                )
+        );
+
+        const auto hue = Simd::mul(h_temp, Simd::broadcast(60.0));
+        const auto saturation = Simd::select(Simd::equal(max, zero), zero, Simd::div(delta, max));
+
+        Lanes hues{};
+        Lanes saturations{};
+        Lanes values{};
+        Simd::store(hues.data(), hue);
+        Simd::store(saturations.data(), saturation);
+        Simd::store(values.data(), max);
+
+        for (usize lane = 0; lane < Simd::lanes; ++lane) {
+            to[lane] = HSVColor{ hues[lane], saturations[lane], values[lane], from[lane].a };
+        }
+    }
+
+#endif
+
+} // namespace
+
+
+void color::to_rgb_colors(std::span<const HSVColor> from, std::span<Color> to) {
+    assert(to.size() >= from.size());
+
+    usize i = 0;
+
+#if defined(OOPETRIS_COLOR_SIMD)
+    for (; i + Simd::lanes <= from.size(); i += Simd::lanes) {
+        to_rgb_colors_simd(from.data() + i, to.data() + i);
+    }
+#endif
+
+    for (; i < from.size(); ++i) {
+        to[i] = from[i].to_rgb_color();
+    }
+}
+
+void color::to_hsv_colors(std::span<const Color> from, std::span<HSVColor> to) {
+    assert(to.size() >= from.size());
+
+    usize i = 0;
+
+#if defined(OOPETRIS_COLOR_SIMD)
+    for (; i + Simd::lanes <= from.size(); i += Simd::lanes) {
+        to_hsv_colors_simd(from.data() + i, to.data() + i);
+    }
+#endif
+
+    for (; i < from.size(); ++i) {
+        to[i] = from[i].to_hsv_color();
+    }
+}
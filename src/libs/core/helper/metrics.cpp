@@ -0,0 +1,193 @@
+#include "./metrics.hpp"
+#include "./utils.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <fmt/format.h>
+#include <fstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+    // the signal handler may only touch lock-free atomics or volatile sig_atomic_t
+    volatile std::sig_atomic_t dump_requested = 0; //NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    [[maybe_unused]] void handle_dump_signal(int /* signal */) {
+        dump_requested = 1;
+    }
+
+} // namespace
+
+
+[[nodiscard]] u64 metrics::Counter::value() const {
+    return m_value.load(std::memory_order_relaxed);
+}
+
+
+metrics::Histogram::Histogram(std::vector<double> upper_bounds)
+    : m_upper_bounds{ std::move(upper_bounds) },
+      m_bucket_counts(m_upper_bounds.size() + 1) {
+    if (not std::ranges::is_sorted(m_upper_bounds)) {
+        throw std::runtime_error("the upper bounds of a histogram have to be sorted");
+    }
+}
+
+void metrics::Histogram::observe(double value) {
+    const auto bucket = std::ranges::lower_bound(m_upper_bounds, value) - m_upper_bounds.begin();
+    m_bucket_counts.at(static_cast<usize>(bucket)).fetch_add(1, std::memory_order_relaxed);
+
+    // fetch_add for floating point atomics isn't available everywhere
+    auto sum = m_sum.load(std::memory_order_relaxed);
+    while (not m_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) { }
+}
+
+[[nodiscard]] const std::vector<double>& metrics::Histogram::upper_bounds() const {
+    return m_upper_bounds;
+}
+
+[[nodiscard]] std::vector<u64> metrics::Histogram::bucket_counts() const {
+    std::vector<u64> result{};
+    result.reserve(m_bucket_counts.size());
+    for (const auto& count : m_bucket_counts) {
+        result.push_back(count.load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+[[nodiscard]] double metrics::Histogram::sum() const {
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+
+[[nodiscard]] metrics::Registry& metrics::Registry::global() {
+    static Registry registry{};
+    return registry;
+}
+
+[[nodiscard]] metrics::Counter& metrics::Registry::counter(const std::string& name, const std::string& help) {
+    const std::lock_guard lock{ m_mutex };
+
+    auto iterator = m_metrics.find(name);
+    if (iterator == m_metrics.end()) {
+        iterator = m_metrics.emplace(name, Metric{ .help = help, .value = std::make_unique<Counter>() }).first;
+    }
+
+    auto* const counter = std::get_if<std::unique_ptr<Counter>>(&iterator->second.value);
+    if (counter == nullptr) {
+        throw std::runtime_error(fmt::format("metric '{}' is already registered with a different type", name));
+    }
+
+    return **counter;
+}
+
+[[nodiscard]] metrics::Histogram& metrics::Registry::histogram(
+        const std::string& name,
+        const std::string& help,
+        const std::vector<double>& upper_bounds
+) {
+    const std::lock_guard lock{ m_mutex };
+
+    auto iterator = m_metrics.find(name);
+    if (iterator == m_metrics.end()) {
+        iterator =
+                m_metrics.emplace(name, Metric{ .help = help, .value = std::make_unique<Histogram>(upper_bounds) })
+                        .first;
+    }
+
+    auto* const histogram = std::get_if<std::unique_ptr<Histogram>>(&iterator->second.value);
+    if (histogram == nullptr or (*histogram)->upper_bounds() != upper_bounds) {
+        throw std::runtime_error(
+                fmt::format("metric '{}' is already registered with a different type or different buckets", name)
+        );
+    }
+
+    return **histogram;
+}
+
+[[nodiscard]] std::string metrics::Registry::to_prometheus_text() const {
+    const std::lock_guard lock{ m_mutex };
+
+    std::string result{};
+
+    for (const auto& [name, metric] : m_metrics) {
+        result += fmt::format("# HELP {} {}\n", name, metric.help);
+
+        std::visit(
+                helper::overloaded{
+                        [&result, &name](const std::unique_ptr<Counter>& counter) {
+                            result += fmt::format("# TYPE {} counter\n{} {}\n", name, name, counter->value());
+                        },
+                        [&result, &name](const std::unique_ptr<Histogram>& histogram) {
+                            result += fmt::format("# TYPE {} histogram\n", name);
+
+                            const auto& upper_bounds = histogram->upper_bounds();
+                            const auto counts = histogram->bucket_counts();
+
+                            // the buckets in the prometheus format are cumulative
+                            u64 cumulative = 0;
+                            for (usize i = 0; i < counts.size(); ++i) {
+                                cumulative += counts.at(i);
+                                const auto bound =
+                                        i < upper_bounds.size() ? fmt::format("{}", upper_bounds.at(i)) : "+Inf";
+                                result += fmt::format("{}_bucket{{le=\"{}\"}} {}\n", name, bound, cumulative);
+                            }
+
+                            result += fmt::format("{}_sum {}\n{}_count {}\n", name, histogram->sum(), name, cumulative);
+                        },
+                },
+                metric.value
+        );
+    }
+
+    return result;
+}
+
+[[nodiscard]] helper::expected<void, std::string> metrics::Registry::write_to_file(const std::filesystem::path& path
+) const {
+    auto temporary_path = path;
+    temporary_path += ".tmp";
+
+    {
+        std::ofstream file{ temporary_path, std::ios::out | std::ios::trunc };
+        if (not file) {
+            return helper::unexpected<std::string>{
+                fmt::format("unable to open metrics file \"{}\"", temporary_path.string())
+            };
+        }
+
+        file << to_prometheus_text();
+
+        if (not file) {
+            return helper::unexpected<std::string>{
+                fmt::format("unable to write metrics file \"{}\"", temporary_path.string())
+            };
+        }
+    }
+
+    std::error_code error_code{};
+    std::filesystem::rename(temporary_path, path, error_code);
+    if (error_code) {
+        return helper::unexpected<std::string>{
+            fmt::format("unable to move metrics file to \"{}\": {}", path.string(), error_code.message())
+        };
+    }
+
+    return {};
+}
+
+
+void metrics::install_dump_signal_handler() {
+#if defined(SIGUSR1)
+    std::ignore = std::signal(SIGUSR1, handle_dump_signal);
+#endif
+}
+
+[[nodiscard]] bool metrics::take_dump_request() {
+    if (dump_requested == 0) {
+        return false;
+    }
+
+    dump_requested = 0;
+    return true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "./expected.hpp"
+#include "./types.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+// process wide metrics, that can be written in the prometheus text format
+// registering a metric takes a lock, so it should be done once (e.g. in a function local static), updating it is lock-free
+namespace metrics {
+
+    struct Counter final {
+    private:
+        std::atomic<u64> m_value{ 0 };
+
+    public:
+        void add(u64 value = 1) {
+            m_value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] u64 value() const;
+    };
+
+    // the buckets are fixed at registration, every observed value is counted in the first bucket, whose upper bound is greater or equal
+    struct Histogram final {
+    private:
+        std::vector<double> m_upper_bounds;
+        // one more than upper bounds, the last one counts everything above the last upper bound
+        std::vector<std::atomic<u64>> m_bucket_counts;
+        std::atomic<double> m_sum{ 0.0 };
+
+    public:
+        explicit Histogram(std::vector<double> upper_bounds);
+
+        void observe(double value);
+
+        [[nodiscard]] const std::vector<double>& upper_bounds() const;
+
+        // not cumulative, one value per bucket, including the last, unbounded one
+        [[nodiscard]] std::vector<u64> bucket_counts() const;
+
+        [[nodiscard]] double sum() const;
+    };
+
+    struct Registry final {
+    private:
+        struct Metric {
+            std::string help;
+            std::variant<std::unique_ptr<Counter>, std::unique_ptr<Histogram>> value;
+        };
+
+        mutable std::mutex m_mutex;
+        // ordered, so that the output is stable
+        std::map<std::string, Metric> m_metrics;
+
+    public:
+        [[nodiscard]] static Registry& global();
+
+        // returns the already registered metric, if one with the same name exists, throws, if it has a different type
+        [[nodiscard]] Counter& counter(const std::string& name, const std::string& help);
+        [[nodiscard]] Histogram&
+        histogram(const std::string& name, const std::string& help, const std::vector<double>& upper_bounds);
+
+        [[nodiscard]] std::string to_prometheus_text() const;
+
+        // the file is written to a temporary file first and than renamed, so that readers never see a partial file
+        [[nodiscard]] helper::expected<void, std::string> write_to_file(const std::filesystem::path& path) const;
+    };
+
+    // on platforms with SIGUSR1, this installs a handler for it, that requests a dump, this has to be polled with take_dump_request()
+    void install_dump_signal_handler();
+
+    // returns true once for every received signal
+    [[nodiscard]] bool take_dump_request();
+
+} // namespace metrics
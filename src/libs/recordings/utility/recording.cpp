@@ -1,9 +1,41 @@
 
 #include "./recording.hpp"
+#include "./helper.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
 
+void recorder::Record::append_bytes(std::vector<char>& bytes) const {
+    helper::writer::append_value(bytes, tetrion_index);
+    helper::writer::append_value(bytes, simulation_step_index);
+    helper::writer::append_value(bytes, utils::to_underlying(event));
+}
+
+[[nodiscard]] std::optional<recorder::Record> recorder::Record::from_bytes(std::span<const char> bytes) {
+    if (bytes.size() < encoded_size) {
+        return std::nullopt;
+    }
+
+    u8 tetrion_index{};
+    u64 simulation_step_index{};
+    std::underlying_type_t<InputEvent> event{};
+
+    std::memcpy(&tetrion_index, bytes.data(), sizeof(tetrion_index));
+    std::memcpy(&simulation_step_index, bytes.subspan(sizeof(tetrion_index)).data(), sizeof(simulation_step_index));
+    std::memcpy(&event, bytes.subspan(sizeof(tetrion_index) + sizeof(simulation_step_index)).data(), sizeof(event));
+
+    event = utils::from_little_endian(event);
+    if (event > utils::to_underlying(InputEvent::HoldReleased)) {
+        return std::nullopt;
+    }
+
+    return Record{ .tetrion_index = utils::from_little_endian(tetrion_index),
+                   .simulation_step_index = utils::from_little_endian(simulation_step_index),
+                   .event = static_cast<InputEvent>(event) };
+}
+
+
 recorder::TetrionHeader::TetrionHeader(Random::Seed seed, u32 starting_level)
     : seed{ seed },
       starting_level{ starting_level } { }
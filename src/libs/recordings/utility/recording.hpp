@@ -7,6 +7,8 @@
 #include "./additional_information.hpp"
 #include "./checksum_helper.hpp"
 
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -25,6 +27,14 @@ namespace recorder {
         u8 tetrion_index;
         u64 simulation_step_index;
         InputEvent event;
+
+        // the encoding of a record in a recording, without the magic byte, the network protocol uses it as well
+        static constexpr usize encoded_size = sizeof(tetrion_index) + sizeof(simulation_step_index) + sizeof(event);
+
+        void append_bytes(std::vector<char>& bytes) const;
+
+        // nullopt, if there are not enough bytes or the event is invalid
+        [[nodiscard]] static std::optional<Record> from_bytes(std::span<const char> bytes);
     };
 
     enum class MagicByte : u8 {
@@ -1,5 +1,6 @@
 
 #include <core/helper/magic_enum_wrapper.hpp>
+#include <core/helper/metrics.hpp>
 
 #include "./additional_information.hpp"
 #include "./recording_reader.hpp"
@@ -154,6 +155,19 @@ helper::expected<recorder::RecordingReader, std::string> recorder::RecordingRead
         }
     }
 
+    static auto& records_read = metrics::Registry::global().counter(
+            "oopetris_records_read_total", "records read from recording files"
+    );
+    static auto& bytes_read = metrics::Registry::global().counter(
+            "oopetris_recording_bytes_read_total", "bytes of successfully read recording files"
+    );
+
+    records_read.add(records.size());
+    std::error_code error_code{};
+    if (const auto file_size = std::filesystem::file_size(path, error_code); not error_code) {
+        bytes_read.add(file_size);
+    }
+
     return RecordingReader{ std::move(tetrion_headers), std::move(information), std::move(records),
                             std::move(snapshots) };
 }
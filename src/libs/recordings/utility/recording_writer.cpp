@@ -2,6 +2,19 @@
 #include "./recording.hpp"
 #include "./tetrion_snapshot.hpp"
 
+#include <core/helper/metrics.hpp>
+
+namespace {
+
+    [[nodiscard]] metrics::Counter& bytes_written_counter() {
+        static auto& counter = metrics::Registry::global().counter(
+                "oopetris_recording_bytes_written_total", "bytes written to recording files"
+        );
+        return counter;
+    }
+
+} // namespace
+
 recorder::RecordingWriter::RecordingWriter(
         std::ofstream&& output_file,
         std::vector<TetrionHeader>&& tetrion_headers,
@@ -83,6 +96,10 @@ helper::expected<recorder::RecordingWriter, std::string> recorder::RecordingWrit
         return helper::unexpected<std::string>{ fmt::format("error while writing: {}", result.error()) };
     }
 
+    if (const auto header_size = output_file.tellp(); header_size > 0) {
+        bytes_written_counter().add(static_cast<u64>(header_size));
+    }
+
     return RecordingWriter{ std::move(output_file), std::move(tetrion_headers), std::move(information) };
 }
 
@@ -93,6 +110,8 @@ helper::expected<void, std::string> recorder::RecordingWriter::add_record(
 ) {
     assert(tetrion_index < m_tetrion_headers.size());
 
+    const std::lock_guard lock{ m_write_mutex };
+
     helper::expected<void, std::string> result{};
 
     static_assert(sizeof(std::underlying_type_t<MagicByte>) == 1);
@@ -116,6 +135,12 @@ helper::expected<void, std::string> recorder::RecordingWriter::add_record(
     static_assert(sizeof(std::underlying_type_t<InputEvent>) == 1);
     result = write(utils::to_underlying(event));
 
+    if (result.has_value()) {
+        bytes_written_counter().add(
+                sizeof(MagicByte) + sizeof(tetrion_index) + sizeof(simulation_step_index) + sizeof(InputEvent)
+        );
+    }
+
     return result;
 }
 
@@ -124,6 +149,8 @@ helper::expected<void, std::string> recorder::RecordingWriter::add_snapshot(
         std::unique_ptr<TetrionCoreInformation> information
 ) {
 
+    const std::lock_guard lock{ m_write_mutex };
+
     helper::expected<void, std::string> result{};
 
     static_assert(sizeof(std::underlying_type_t<MagicByte>) == 1);
@@ -138,6 +165,10 @@ helper::expected<void, std::string> recorder::RecordingWriter::add_snapshot(
     const auto bytes = snapshot.to_bytes();
     result = helper::writer::write_vector_to_file(m_output_file, bytes);
 
+    if (result.has_value()) {
+        bytes_written_counter().add(sizeof(MagicByte) + bytes.size());
+    }
+
     return result;
 }
 
@@ -7,12 +7,15 @@
 #include <core/helper/expected.hpp>
 
 #include <filesystem>
+#include <mutex>
 
 namespace recorder {
 
     struct RecordingWriter : public Recording {
     private:
         std::ofstream m_output_file;
+        // the tetrions of a game may be simulated on different threads, but every record has to be written at once
+        std::mutex m_write_mutex;
 
         explicit RecordingWriter(
                 std::ofstream&& output_file,
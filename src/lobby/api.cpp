@@ -164,6 +164,11 @@ lobby::Client::Client(const std::string& api_url) : m_client{ api_url } {
     m_client.set_compress(true);
     m_client.set_decompress(true);
 #endif
+
+    // reuses the connection, so that polling doesn't need a new TCP (and TLS) handshake every time
+    m_client.set_keep_alive(true);
+    m_client.set_connection_timeout(std::chrono::seconds{ 5 });
+    m_client.set_read_timeout(std::chrono::seconds{ 10 });
 }
 
 helper::expected<lobby::VersionResult, std::string> lobby::Client::get_version() {
@@ -234,6 +239,33 @@ helper::expected<std::vector<lobby::LobbyInfo>, std::string> lobby::Client::get_
     return get_json_from_request<std::vector<LobbyInfo>>(res);
 }
 
+helper::expected<lobby::LobbyList, std::string> lobby::Client::get_lobbies_if_changed(
+        const std::optional<std::string>& etag
+) {
+    httplib::Headers headers{};
+    if (etag.has_value()) {
+        headers.emplace("If-None-Match", etag.value());
+    }
+
+    auto res = m_client.Get("/lobbies", headers);
+
+    if (res and res->status == 304) {
+        return LobbyList{ .lobbies = std::nullopt, .etag = etag };
+    }
+
+    auto lobbies = get_json_from_request<std::vector<LobbyInfo>>(res);
+    if (not lobbies.has_value()) {
+        return helper::unexpected<std::string>{ lobbies.error() };
+    }
+
+    std::optional<std::string> new_etag = std::nullopt;
+    if (res->has_header("ETag")) {
+        new_etag = res->get_header_value("ETag");
+    }
+
+    return LobbyList{ .lobbies = std::move(lobbies.value()), .etag = std::move(new_etag) };
+}
+
 
 helper::expected<void, std::string> lobby::Client::join_lobby(int lobby_id) {
     if (not is_authenticated()) {
@@ -337,3 +369,7 @@ helper::expected<void, std::string> lobby::Client::register_user(const RegisterR
 
     return is_request_ok(res, 204);
 }
+
+void lobby::Client::stop() {
+    m_client.stop();
+}
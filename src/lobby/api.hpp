@@ -37,9 +37,17 @@ namespace constants {
 
 namespace lobby {
 
+    struct LobbyList {
+        // nullopt, if the list didn't change since the request with the given etag
+        std::optional<std::vector<LobbyInfo>> lobbies;
+        std::optional<std::string> etag;
+    };
 
     struct Client {
     private:
+        // creates the client on its worker thread, so that the reachability check doesn't block
+        friend struct AsyncClient;
+
         httplib::Client m_client;
         std::optional<std::string> m_authentication_token;
 
@@ -75,6 +83,11 @@ namespace lobby {
 
         [[nodiscard]] helper::expected<std::vector<LobbyInfo>, std::string> get_lobbies();
 
+        // sends the etag of the last response, so that the server can answer with 304, if nothing changed
+        [[nodiscard]] helper::expected<LobbyList, std::string> get_lobbies_if_changed(
+                const std::optional<std::string>& etag
+        );
+
         [[nodiscard]] helper::expected<void, std::string> join_lobby(int lobby_id);
 
         [[nodiscard]] helper::expected<LobbyDetail, std::string> get_lobby_detail(int lobby_id);
@@ -92,6 +105,9 @@ namespace lobby {
         [[nodiscard]] helper::expected<std::vector<PlayerInfo>, std::string> get_users();
 
         [[nodiscard]] helper::expected<void, std::string> register_user(const RegisterRequest& register_request);
+
+        // can be called from another thread, the running request fails, the next one opens a new connection
+        void stop();
     };
 
 
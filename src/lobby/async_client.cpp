@@ -0,0 +1,391 @@
+#include <core/helper/metrics.hpp>
+
+#include "async_client.hpp"
+
+#include <algorithm>
+#include <map>
+
+
+namespace {
+
+    constexpr std::chrono::milliseconds initial_connect_backoff{ 250 };
+    constexpr std::chrono::milliseconds max_connect_backoff{ 30'000 };
+
+    void record_request(std::chrono::steady_clock::duration duration) {
+        static auto& request_seconds = metrics::Registry::global().histogram(
+                "oopetris_lobby_request_seconds", "time needed for a request to the lobby server",
+                { 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0 }
+        );
+
+        request_seconds.observe(std::chrono::duration<double>(duration).count());
+    }
+
+    template<typename T>
+    [[nodiscard]] std::function<void()> completion(
+            const std::shared_ptr<std::atomic<bool>>& cancelled,
+            const lobby::Callback<T>& callback,
+            lobby::Result<T>&& result
+    ) {
+        return [cancelled, callback, result = std::move(result)]() mutable {
+            if (not cancelled->load(std::memory_order_acquire)) {
+                callback(std::move(result));
+            }
+        };
+    }
+
+    [[nodiscard]] lobby::Result<void> authentication_result(bool authenticated) {
+        if (not authenticated) {
+            return helper::unexpected<std::string>{ "authentication failed" };
+        }
+        return {};
+    }
+
+} // namespace
+
+
+lobby::RequestHandle::RequestHandle() : m_cancelled{ std::make_shared<std::atomic<bool>>(false) } { }
+
+[[nodiscard]] bool lobby::RequestHandle::is_cancelled() const {
+    return m_cancelled->load(std::memory_order_acquire);
+}
+
+[[nodiscard]] const std::shared_ptr<std::atomic<bool>>& lobby::RequestHandle::cancelled_flag() const {
+    return m_cancelled;
+}
+
+
+[[nodiscard]] bool lobby::LobbyListUpdate::is_empty() const {
+    return added.empty() and changed.empty() and removed.empty();
+}
+
+[[nodiscard]] lobby::LobbyListUpdate
+lobby::diff_lobby_lists(const std::vector<LobbyInfo>& previous, const std::vector<LobbyInfo>& current) {
+    LobbyListUpdate update{ .lobbies = current, .added = {}, .changed = {}, .removed = {} };
+
+    std::map<std::string, const LobbyInfo*> previous_by_id{};
+    for (const auto& lobby : previous) {
+        previous_by_id.emplace(lobby.id, &lobby);
+    }
+
+    for (const auto& lobby : current) {
+        const auto previous_lobby = previous_by_id.find(lobby.id);
+        if (previous_lobby == previous_by_id.end()) {
+            update.added.push_back(lobby);
+            continue;
+        }
+
+        if (*previous_lobby->second != lobby) {
+            update.changed.push_back(lobby);
+        }
+        previous_by_id.erase(previous_lobby);
+    }
+
+    for (const auto& [id, lobby] : previous_by_id) {
+        update.removed.push_back(id);
+    }
+
+    return update;
+}
+
+
+lobby::AsyncClient::AsyncClient(std::string url, Callback<void> on_connected) : m_url{ std::move(url) } {
+    m_thread = std::thread{ [this, on_connected = std::move(on_connected)] { run(on_connected); } };
+}
+
+lobby::AsyncClient::~AsyncClient() {
+    {
+        std::unique_lock lock{ m_mutex };
+        m_is_running = false;
+
+        for (auto& task : m_tasks) {
+            task.cancelled->store(true, std::memory_order_release);
+        }
+        m_tasks.clear();
+
+        // this also aborts the reachability check, while connecting
+        if (m_client != nullptr) {
+            m_client->stop();
+        }
+    }
+
+    m_condition.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void lobby::AsyncClient::poll() {
+    std::vector<std::function<void()>> completions{};
+    {
+        std::unique_lock lock{ m_mutex };
+        std::swap(completions, m_completions);
+    }
+
+    // outside of the lock, so that the callbacks can send new requests
+    for (auto& completion : completions) {
+        completion();
+    }
+}
+
+void lobby::AsyncClient::cancel(const RequestHandle& handle) {
+    handle.cancelled_flag()->store(true, std::memory_order_release);
+
+    std::unique_lock lock{ m_mutex };
+    if (m_running_request == handle.cancelled_flag() and m_client != nullptr) {
+        m_client->stop();
+    }
+}
+
+lobby::RequestHandle lobby::AsyncClient::authenticate(const Credentials& credentials, Callback<void> callback) {
+    return send<void>(
+            [credentials](Client& client) { return authentication_result(client.authenticate(credentials)); },
+            std::move(callback)
+    );
+}
+
+lobby::RequestHandle lobby::AsyncClient::get_lobbies(Callback<std::vector<LobbyInfo>> callback) {
+    return send<std::vector<LobbyInfo>>([](Client& client) { return client.get_lobbies(); }, std::move(callback));
+}
+
+lobby::RequestHandle lobby::AsyncClient::join_lobby(int lobby_id, Callback<void> callback) {
+    return send<void>([lobby_id](Client& client) { return client.join_lobby(lobby_id); }, std::move(callback));
+}
+
+lobby::RequestHandle lobby::AsyncClient::get_lobby_detail(int lobby_id, Callback<LobbyDetail> callback) {
+    return send<LobbyDetail>(
+            [lobby_id](Client& client) { return client.get_lobby_detail(lobby_id); }, std::move(callback)
+    );
+}
+
+lobby::RequestHandle lobby::AsyncClient::delete_lobby(int lobby_id, Callback<void> callback) {
+    return send<void>([lobby_id](Client& client) { return client.delete_lobby(lobby_id); }, std::move(callback));
+}
+
+lobby::RequestHandle lobby::AsyncClient::leave_lobby(int lobby_id, Callback<void> callback) {
+    return send<void>([lobby_id](Client& client) { return client.leave_lobby(lobby_id); }, std::move(callback));
+}
+
+lobby::RequestHandle lobby::AsyncClient::start_lobby(int lobby_id, Callback<void> callback) {
+    return send<void>([lobby_id](Client& client) { return client.start_lobby(lobby_id); }, std::move(callback));
+}
+
+lobby::RequestHandle
+lobby::AsyncClient::create_lobby(const CreateLobbyRequest& arguments, Callback<LobbyCreateResponse> callback) {
+    return send<LobbyCreateResponse>(
+            [arguments](Client& client) { return client.create_lobby(arguments); }, std::move(callback)
+    );
+}
+
+lobby::RequestHandle lobby::AsyncClient::get_users(Callback<std::vector<PlayerInfo>> callback) {
+    return send<std::vector<PlayerInfo>>([](Client& client) { return client.get_users(); }, std::move(callback));
+}
+
+lobby::RequestHandle
+lobby::AsyncClient::register_user(const RegisterRequest& register_request, Callback<void> callback) {
+    return send<void>(
+            [register_request](Client& client) { return client.register_user(register_request); },
+            std::move(callback)
+    );
+}
+
+void lobby::AsyncClient::start_polling_lobbies(
+        std::chrono::milliseconds interval,
+        std::function<void(Result<LobbyListUpdate>&& result)> callback
+) {
+    {
+        std::unique_lock lock{ m_mutex };
+
+        if (m_lobby_polling.has_value()) {
+            m_lobby_polling->cancelled->store(true, std::memory_order_release);
+        }
+
+        m_lobby_polling = LobbyPolling{
+            .interval = interval,
+            .callback = std::move(callback),
+            .next_poll = std::chrono::steady_clock::now(),
+            .cancelled = std::make_shared<std::atomic<bool>>(false),
+            .etag = std::nullopt,
+            .lobbies = std::nullopt,
+        };
+    }
+
+    m_condition.notify_one();
+}
+
+void lobby::AsyncClient::stop_polling_lobbies() {
+    std::unique_lock lock{ m_mutex };
+
+    if (m_lobby_polling.has_value()) {
+        m_lobby_polling->cancelled->store(true, std::memory_order_release);
+        m_lobby_polling = std::nullopt;
+    }
+}
+
+template<typename T>
+lobby::RequestHandle
+lobby::AsyncClient::send(std::function<Result<T>(Client& client)> request, Callback<T> callback) {
+    RequestHandle handle{};
+    const auto& cancelled = handle.cancelled_flag();
+
+    Task task{
+        .cancelled = cancelled,
+        .run = [cancelled, callback, request = std::move(request)](Client& client) {
+            return completion<T>(cancelled, callback, request(client));
+        },
+        .fail = [cancelled, callback](const std::string& error) {
+            return completion<T>(cancelled, callback, helper::unexpected<std::string>{ error });
+        },
+    };
+
+    {
+        std::unique_lock lock{ m_mutex };
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_condition.notify_one();
+    return handle;
+}
+
+void lobby::AsyncClient::run(const Callback<void>& on_connected) {
+    connect(on_connected);
+
+    std::unique_lock lock{ m_mutex };
+
+    while (m_is_running) {
+        if (not m_tasks.empty()) {
+            auto task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+
+            if (task.cancelled->load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            m_running_request = task.cancelled;
+            lock.unlock();
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto connection_error = reconnect_if_needed();
+            auto finished = connection_error.has_value() ? task.fail(connection_error.value()) : task.run(*m_client);
+            record_request(std::chrono::steady_clock::now() - start);
+
+            lock.lock();
+            m_running_request = nullptr;
+            m_completions.push_back(std::move(finished));
+            continue;
+        }
+
+        // explicit requests are more important than the polling, so it only happens, when there are none
+        if (m_lobby_polling.has_value()) {
+            if (std::chrono::steady_clock::now() >= m_lobby_polling->next_poll) {
+                poll_lobbies(lock);
+                continue;
+            }
+
+            // a copy, since the polling can be stopped while waiting
+            const auto next_poll = m_lobby_polling->next_poll;
+            m_condition.wait_until(lock, next_poll);
+            continue;
+        }
+
+        m_condition.wait(lock);
+    }
+}
+
+void lobby::AsyncClient::connect(const Callback<void>& on_connected) {
+    {
+        std::unique_lock lock{ m_mutex };
+        if (not m_is_running) {
+            return;
+        }
+        m_client = std::unique_ptr<Client>{ new Client{ m_url } };
+    }
+
+    //TODO(Totto):  once version is standard, check here if the version is supported, like in Client::get_client
+    auto reachable = m_client->check_reachability();
+
+    std::unique_lock lock{ m_mutex };
+    if (not reachable.has_value()) {
+        m_connection_error = reachable.error();
+        m_connect_backoff = initial_connect_backoff;
+        m_next_connect_attempt = std::chrono::steady_clock::now() + m_connect_backoff;
+    }
+
+    if (on_connected) {
+        m_completions.push_back(
+                completion<void>(std::make_shared<std::atomic<bool>>(false), on_connected, std::move(reachable))
+        );
+    }
+}
+
+std::optional<std::string> lobby::AsyncClient::reconnect_if_needed() {
+    if (not m_connection_error.has_value()) {
+        return std::nullopt;
+    }
+
+    // so that an unreachable server isn't asked again for every request
+    if (std::chrono::steady_clock::now() < m_next_connect_attempt) {
+        return m_connection_error;
+    }
+
+    auto reachable = m_client->check_reachability();
+    if (reachable.has_value()) {
+        m_connection_error = std::nullopt;
+        return std::nullopt;
+    }
+
+    m_connection_error = std::move(reachable.error());
+    m_connect_backoff = std::min(m_connect_backoff * 2, max_connect_backoff);
+    m_next_connect_attempt = std::chrono::steady_clock::now() + m_connect_backoff;
+    return m_connection_error;
+}
+
+void lobby::AsyncClient::poll_lobbies(std::unique_lock<std::mutex>& lock) {
+    auto& polling = m_lobby_polling.value();
+    polling.next_poll = std::chrono::steady_clock::now() + polling.interval;
+
+    const auto cancelled = polling.cancelled;
+    const auto etag = polling.etag;
+
+    lock.unlock();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto connection_error = reconnect_if_needed();
+    auto result = connection_error.has_value()
+                          ? Result<LobbyList>{ helper::unexpected<std::string>{ connection_error.value() } }
+                          : m_client->get_lobbies_if_changed(etag);
+    record_request(std::chrono::steady_clock::now() - start);
+
+    lock.lock();
+
+    // the polling was stopped or restarted in the meantime
+    if (not m_lobby_polling.has_value() or m_lobby_polling->cancelled != cancelled) {
+        return;
+    }
+
+    auto& current = m_lobby_polling.value();
+
+    if (not result.has_value()) {
+        m_completions.push_back(completion<LobbyListUpdate>(
+                cancelled, current.callback, helper::unexpected<std::string>{ std::move(result.error()) }
+        ));
+        return;
+    }
+
+    // not modified since the last poll
+    if (not result->lobbies.has_value()) {
+        return;
+    }
+
+    const auto is_first = not current.lobbies.has_value();
+    auto update = diff_lobby_lists(current.lobbies.value_or(std::vector<LobbyInfo>{}), result->lobbies.value());
+
+    current.etag = std::move(result->etag);
+    current.lobbies = std::move(result->lobbies);
+
+    if (not is_first and update.is_empty()) {
+        return;
+    }
+
+    m_completions.push_back(completion<LobbyListUpdate>(cancelled, current.callback, std::move(update)));
+}
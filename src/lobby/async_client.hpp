@@ -0,0 +1,159 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/types.hpp>
+
+#include "lobby/api.hpp"
+#include "lobby/types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lobby {
+
+    template<typename T>
+    using Result = helper::expected<T, std::string>;
+
+    template<typename T>
+    using Callback = std::function<void(Result<T>&& result)>;
+
+    // a request, that was sent by the async client, the callback of a cancelled request is never called
+    struct RequestHandle {
+    private:
+        std::shared_ptr<std::atomic<bool>> m_cancelled;
+
+    public:
+        RequestHandle();
+
+        [[nodiscard]] bool is_cancelled() const;
+
+    private:
+        friend struct AsyncClient;
+
+        [[nodiscard]] const std::shared_ptr<std::atomic<bool>>& cancelled_flag() const;
+    };
+
+    // the difference of the lobby list to the previous poll, lobbies are identified by their id
+    struct LobbyListUpdate {
+        std::vector<LobbyInfo> lobbies;
+        std::vector<LobbyInfo> added;
+        std::vector<LobbyInfo> changed;
+        std::vector<std::string> removed;
+
+        [[nodiscard]] bool is_empty() const;
+    };
+
+    // diffs two lobby lists, the order of the lobbies in the lists doesn't matter
+    [[nodiscard]] LobbyListUpdate
+    diff_lobby_lists(const std::vector<LobbyInfo>& previous, const std::vector<LobbyInfo>& current);
+
+    // runs the requests of the blocking client on a worker thread, so that the render loop never waits for the network
+    // the callbacks are called on the thread, that calls poll(), e.g. in the update of a scene, so they can modify the ui
+    struct AsyncClient final {
+    private:
+        struct Task {
+            std::shared_ptr<std::atomic<bool>> cancelled;
+            // runs on the worker thread and returns the completion, that is run by poll()
+            std::function<std::function<void()>(Client& client)> run;
+            // runs on the worker thread instead of run(), if the client couldn't connect
+            std::function<std::function<void()>(const std::string& error)> fail;
+        };
+
+        struct LobbyPolling {
+            std::chrono::milliseconds interval;
+            std::function<void(Result<LobbyListUpdate>&& result)> callback;
+            std::chrono::steady_clock::time_point next_poll;
+            // set, when the polling is stopped, so that a result, that is already finished, isn't reported anymore
+            std::shared_ptr<std::atomic<bool>> cancelled;
+            std::optional<std::string> etag;
+            std::optional<std::vector<LobbyInfo>> lobbies;
+        };
+
+        std::string m_url;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Task> m_tasks;
+        std::vector<std::function<void()>> m_completions;
+        std::optional<LobbyPolling> m_lobby_polling;
+        // the request, that is executed right now, so that cancelling it can stop the connection
+        std::shared_ptr<std::atomic<bool>> m_running_request;
+        bool m_is_running{ true };
+
+        // only set by the worker thread, the main thread only calls stop() on it, guarded by m_mutex
+        std::unique_ptr<Client> m_client;
+        std::optional<std::string> m_connection_error;
+        // a failed connect is retried by the next request or poll after this, the delay doubles with every failure
+        std::chrono::steady_clock::time_point m_next_connect_attempt;
+        std::chrono::milliseconds m_connect_backoff{ 0 };
+
+        std::thread m_thread;
+
+    public:
+        // connecting happens on the worker thread as well, requests sent before that are queued until then
+        // on_connected only reports the first attempt, later requests retry a failed connect
+        AsyncClient(std::string url, Callback<void> on_connected);
+
+        AsyncClient(const AsyncClient&) = delete;
+        AsyncClient& operator=(const AsyncClient&) = delete;
+        AsyncClient(AsyncClient&&) = delete;
+        AsyncClient& operator=(AsyncClient&&) = delete;
+
+        // cancels all pending requests and stops the running one
+        ~AsyncClient();
+
+        // calls the callbacks of all finished requests
+        void poll();
+
+        void cancel(const RequestHandle& handle);
+
+        RequestHandle authenticate(const Credentials& credentials, Callback<void> callback);
+
+        RequestHandle get_lobbies(Callback<std::vector<LobbyInfo>> callback);
+
+        RequestHandle join_lobby(int lobby_id, Callback<void> callback);
+
+        RequestHandle get_lobby_detail(int lobby_id, Callback<LobbyDetail> callback);
+
+        RequestHandle delete_lobby(int lobby_id, Callback<void> callback);
+
+        RequestHandle leave_lobby(int lobby_id, Callback<void> callback);
+
+        RequestHandle start_lobby(int lobby_id, Callback<void> callback);
+
+        RequestHandle create_lobby(const CreateLobbyRequest& arguments, Callback<LobbyCreateResponse> callback);
+
+        RequestHandle get_users(Callback<std::vector<PlayerInfo>> callback);
+
+        RequestHandle register_user(const RegisterRequest& register_request, Callback<void> callback);
+
+        // requests the lobby list every interval, the callback is only called, if the list changed or the request failed
+        // the first successful poll reports all lobbies as added
+        void start_polling_lobbies(
+                std::chrono::milliseconds interval,
+                std::function<void(Result<LobbyListUpdate>&& result)> callback
+        );
+
+        void stop_polling_lobbies();
+
+    private:
+        template<typename T>
+        RequestHandle send(std::function<Result<T>(Client& client)> request, Callback<T> callback);
+
+        void run(const Callback<void>& on_connected);
+        void connect(const Callback<void>& on_connected);
+        // retries a failed connect, if the delay is over, returns the error, if the client still isn't connected
+        [[nodiscard]] std::optional<std::string> reconnect_if_needed();
+        void poll_lobbies(std::unique_lock<std::mutex>& lock);
+    };
+
+} // namespace lobby
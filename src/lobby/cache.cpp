@@ -0,0 +1,85 @@
+#include "async_client.hpp"
+#include "cache.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+
+namespace {
+
+    [[nodiscard]] bool is_sorted_before(const lobby::LobbyInfo& lhs, const lobby::LobbyInfo& rhs) {
+        return std::tie(lhs.name, lhs.id) < std::tie(rhs.name, rhs.id);
+    }
+
+} // namespace
+
+
+[[nodiscard]] std::vector<lobby::LobbyListChange> lobby::LobbyCache::apply(const LobbyListUpdate& update) {
+    std::vector<LobbyListChange> changes{};
+
+    for (const auto& lobby_id : update.removed) {
+        if (const auto index = index_of(lobby_id); index.has_value()) {
+            remove(index.value(), changes);
+        }
+    }
+
+    // an added lobby, that is already cached, is handled like a changed one, so that the cache never has duplicates
+    for (const auto* lobbies : { &update.changed, &update.added }) {
+        for (const auto& lobby : *lobbies) {
+            const auto index = index_of(lobby.id);
+            if (not index.has_value()) {
+                insert(lobby, changes);
+                continue;
+            }
+
+            auto& cached = m_lobbies.at(index.value());
+            if (cached == lobby) {
+                continue;
+            }
+
+            // a renamed lobby has to move to its new position
+            if (cached.name == lobby.name) {
+                cached = lobby;
+                changes.push_back(LobbyListChange{ .type = LobbyListChange::Type::Update, .index = index.value() });
+                continue;
+            }
+
+            remove(index.value(), changes);
+            insert(lobby, changes);
+        }
+    }
+
+    return changes;
+}
+
+[[nodiscard]] const std::vector<lobby::LobbyInfo>& lobby::LobbyCache::lobbies() const {
+    return m_lobbies;
+}
+
+[[nodiscard]] std::optional<usize> lobby::LobbyCache::index_of(const std::string& lobby_id) const {
+    const auto lobby = std::ranges::find_if(m_lobbies, [&lobby_id](const LobbyInfo& info) {
+        return info.id == lobby_id;
+    });
+
+    if (lobby == m_lobbies.end()) {
+        return std::nullopt;
+    }
+
+    return static_cast<usize>(std::distance(m_lobbies.begin(), lobby));
+}
+
+[[nodiscard]] usize lobby::LobbyCache::sorted_index(const LobbyInfo& lobby) const {
+    const auto position = std::ranges::lower_bound(m_lobbies, lobby, is_sorted_before);
+    return static_cast<usize>(std::distance(m_lobbies.begin(), position));
+}
+
+void lobby::LobbyCache::insert(const LobbyInfo& lobby, std::vector<LobbyListChange>& changes) {
+    const auto index = sorted_index(lobby);
+    m_lobbies.insert(m_lobbies.begin() + static_cast<std::ptrdiff_t>(index), lobby);
+    changes.push_back(LobbyListChange{ .type = LobbyListChange::Type::Insert, .index = index });
+}
+
+void lobby::LobbyCache::remove(const usize index, std::vector<LobbyListChange>& changes) {
+    m_lobbies.erase(m_lobbies.begin() + static_cast<std::ptrdiff_t>(index));
+    changes.push_back(LobbyListChange{ .type = LobbyListChange::Type::Remove, .index = index });
+}
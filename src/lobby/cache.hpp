@@ -0,0 +1,46 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "lobby/types.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lobby {
+
+    struct LobbyListUpdate;
+
+    // a change of one row of the lobby list, the index is valid at the time, the change is applied
+    struct LobbyListChange {
+        enum class Type : u8 { Insert, Update, Remove };
+
+        Type type;
+        usize index;
+
+        [[nodiscard]] bool operator==(const LobbyListChange&) const = default;
+    };
+
+    // the lobbies, that are shown, sorted by their name, so that a ui only has to change the rows, that changed
+    struct LobbyCache final {
+    private:
+        std::vector<LobbyInfo> m_lobbies;
+
+    public:
+        // applies the difference, that the AsyncClient computed, and returns the changes in the order, they have to be applied
+        // the updates of one polling have to be applied in order, the first one adds all lobbies
+        [[nodiscard]] std::vector<LobbyListChange> apply(const LobbyListUpdate& update);
+
+        [[nodiscard]] const std::vector<LobbyInfo>& lobbies() const;
+
+        [[nodiscard]] std::optional<usize> index_of(const std::string& lobby_id) const;
+
+    private:
+        [[nodiscard]] usize sorted_index(const LobbyInfo& lobby) const;
+
+        void insert(const LobbyInfo& lobby, std::vector<LobbyListChange>& changes);
+        void remove(usize index, std::vector<LobbyListChange>& changes);
+    };
+
+} // namespace lobby
@@ -23,6 +23,8 @@ namespace lobby {
     struct PlayerInfo {
         std::string id;
         std::string name;
+
+        [[nodiscard]] bool operator==(const PlayerInfo& other) const = default;
     };
 
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(PlayerInfo, id, name)
@@ -33,6 +35,8 @@ namespace lobby {
         int size;
         int num_players_in_lobby;
         PlayerInfo host_info;
+
+        [[nodiscard]] bool operator==(const LobbyInfo& other) const = default;
     };
 
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(LobbyInfo, id, name, size, num_players_in_lobby, host_info)
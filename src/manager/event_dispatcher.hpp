@@ -1,19 +1,28 @@
 #pragma once
 
+#include <core/helper/magic_enum_wrapper.hpp>
+#include <core/helper/utils.hpp>
+
 #include "graphics/rect.hpp"
+#include "input/input_thread.hpp"
 
 #include "manager/event_listener.hpp"
 #include "sdl_key.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <initializer_list>
+#include <memory>
 #include <vector>
 
 struct EventDispatcher final {
 private:
-    std::vector<EventListener*> m_listeners;
+    // the listeners of every event category
+    std::array<std::vector<EventListener*>, magic_enum::enum_count<EventCategory>()> m_listeners;
     bool m_input_activated{ false };
     bool m_enabled{ true };
+    std::unique_ptr<input::InputThread> m_input_thread;
 
     //TODO(Totto):  factor out to some other place!
     std::vector<sdl::Key> m_allowed_input_keys{
@@ -33,14 +42,45 @@ private:
 public:
     explicit EventDispatcher() = default;
 
+    // the listener gets all events
     void register_listener(EventListener* listener) {
-        m_listeners.push_back(listener);
+        for (auto& listeners : m_listeners) {
+            listeners.push_back(listener);
+        }
+    }
+
+    void register_listener(EventListener* listener, std::initializer_list<EventCategory> categories) {
+        for (const auto category : categories) {
+            m_listeners.at(utils::to_underlying(category)).push_back(listener);
+        }
     }
 
     void unregister_listener(const EventListener* listener) {
-        const auto end = std::ranges::remove(m_listeners, listener).begin();
-        assert(end != m_listeners.end() and "listener to delete could not be found");
-        m_listeners.erase(end, m_listeners.end());
+        [[maybe_unused]] bool found = false;
+
+        for (auto& listeners : m_listeners) {
+            const auto removed = std::ranges::remove(listeners, listener);
+            found = found or not removed.empty();
+            listeners.erase(removed.begin(), removed.end());
+        }
+
+        assert(found and "listener to delete could not be found");
+    }
+
+    // has to be called before the joystick subsystem is initialized
+    void start_input_thread() {
+        m_input_thread = std::make_unique<input::InputThread>(m_allowed_input_keys);
+        m_input_thread->set_enabled(m_enabled);
+        m_input_thread->set_text_input_active(m_input_activated);
+    }
+
+    // returns nullptr, if there is no input thread
+    [[nodiscard]] std::shared_ptr<input::InputSubscription> subscribe_to_input_thread(EventCategory category) {
+        if (m_input_thread == nullptr) {
+            return nullptr;
+        }
+
+        return m_input_thread->subscribe(category);
     }
 
     void dispatch_pending_events() const {
@@ -48,31 +88,16 @@ public:
             return;
         }
 
-        SDL_Event event;
-        while (SDL_PollEvent(&event) != 0) {
-            if (m_input_activated) {
-                switch (event.type) {
-                    case SDL_KEYDOWN:
-                    case SDL_KEYUP: {
-                        if (std::ranges::find(m_allowed_input_keys, sdl::Key{ event.key.keysym })
-                            == m_allowed_input_keys.cend()) {
-                            return;
-                        }
-
-                        break;
-                    }
-                    default:
-                        break;
-                }
+        if (m_input_thread != nullptr) {
+            for (const auto& event : m_input_thread->take_main_thread_events()) {
+                dispatch_event(event);
             }
+            return;
+        }
 
-            for (const auto& listener : m_listeners) {
-                if (listener->is_paused()) {
-                    continue;
-                }
-
-                listener->handle_event(event);
-            }
+        SDL_Event event;
+        while (SDL_PollEvent(&event) != 0) {
+            dispatch_event(event);
         }
     }
 
@@ -89,6 +114,9 @@ public:
         SDL_StartTextInput();
 
         m_input_activated = true;
+        if (m_input_thread != nullptr) {
+            m_input_thread->set_text_input_active(true);
+        }
     }
 
     void stop_text_input() {
@@ -99,10 +127,16 @@ public:
         SDL_StopTextInput();
 
         m_input_activated = false;
+        if (m_input_thread != nullptr) {
+            m_input_thread->set_text_input_active(false);
+        }
     }
 
     void disable() {
         m_enabled = false;
+        if (m_input_thread != nullptr) {
+            m_input_thread->set_enabled(false);
+        }
     }
 
     static void clear_all_events() {
@@ -114,12 +148,37 @@ public:
         if (not m_enabled) {
             // clear events received in the phase after disabling it
             clear_all_events();
+            if (m_input_thread != nullptr) {
+                m_input_thread->discard_main_thread_events();
+            }
         }
 
         m_enabled = true;
+        if (m_input_thread != nullptr) {
+            m_input_thread->set_enabled(true);
+        }
     }
 
     [[nodiscard]] bool is_enabled() const {
         return m_enabled;
     }
+
+private:
+    void dispatch_event(const SDL_Event& event) const {
+        const auto category = get_event_category(event);
+
+        if (m_input_activated and category == EventCategory::Key) {
+            if (std::ranges::find(m_allowed_input_keys, sdl::Key{ event.key.keysym }) == m_allowed_input_keys.cend()) {
+                return;
+            }
+        }
+
+        for (const auto& listener : m_listeners.at(utils::to_underlying(category))) {
+            if (listener->is_paused()) {
+                continue;
+            }
+
+            listener->handle_event(event);
+        }
+    }
 };
@@ -0,0 +1,45 @@
+#include "event_listener.hpp"
+
+[[nodiscard]] EventCategory get_event_category(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_MOUSEMOTION:
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        case SDL_MOUSEWHEEL:
+        case SDL_FINGERDOWN:
+        case SDL_FINGERUP:
+        case SDL_FINGERMOTION:
+            return EventCategory::Pointer;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            return EventCategory::Key;
+        case SDL_TEXTINPUT:
+        case SDL_TEXTEDITING:
+            return EventCategory::Text;
+        case SDL_JOYAXISMOTION:
+        case SDL_JOYBALLMOTION:
+        case SDL_JOYHATMOTION:
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        case SDL_JOYDEVICEADDED:
+        case SDL_JOYDEVICEREMOVED:
+        case SDL_CONTROLLERAXISMOTION:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERDEVICEREMAPPED:
+            return EventCategory::Controller;
+        case SDL_QUIT:
+        case SDL_WINDOWEVENT:
+        case SDL_APP_TERMINATING:
+        case SDL_APP_LOWMEMORY:
+        case SDL_APP_WILLENTERBACKGROUND:
+        case SDL_APP_DIDENTERBACKGROUND:
+        case SDL_APP_WILLENTERFOREGROUND:
+        case SDL_APP_DIDENTERFOREGROUND:
+            return EventCategory::Window;
+        default:
+            return EventCategory::Other;
+    }
+}
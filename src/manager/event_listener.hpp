@@ -1,8 +1,15 @@
 #pragma once
 
+#include <core/helper/types.hpp>
+
 #include <SDL.h>
 #include <memory>
 
+// the kind of an event, every event is classified once by the event dispatcher, so that listeners only get the events, they subscribed to
+enum class EventCategory : u8 { Pointer, Key, Text, Controller, Window, Other };
+
+[[nodiscard]] EventCategory get_event_category(const SDL_Event& event);
+
 struct EventListener {
     bool m_is_paused{ false };
 
@@ -14,7 +21,7 @@ struct EventListener {
         return m_is_paused;
     }
 
-    void set_paused(bool is_paused) {
+    virtual void set_paused(bool is_paused) {
         m_is_paused = is_paused;
     }
 };
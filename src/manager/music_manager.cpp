@@ -1,19 +1,44 @@
 #include <core/helper/errors.hpp>
+#include <core/helper/metrics.hpp>
 #include <core/helper/types.hpp>
 
 #include "game/command_line_arguments.hpp"
+#include "helper/asset_archive.hpp"
 #include "helper/constants.hpp"
 #include "manager/music_manager.hpp"
 #include "manager/sdl_key.hpp"
 
 #include <SDL.h>
 #include <SDL_mixer.h>
+#include <chrono>
 #include <filesystem>
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <string>
 
+namespace {
+
+    void record_music_load(std::chrono::steady_clock::duration duration) {
+        // a load, that takes longer than a frame at 60 fps, is visible as a stutter
+        constexpr auto stall_threshold = std::chrono::microseconds{ 16'667 };
+
+        static auto& load_seconds = metrics::Registry::global().histogram(
+                "oopetris_music_load_seconds", "time needed to load and decode the start of a music file",
+                { 0.001, 0.005, 0.01, 0.0167, 0.033, 0.05, 0.1, 0.25, 0.5, 1.0 }
+        );
+        static auto& stalls = metrics::Registry::global().counter(
+                "oopetris_music_decode_stalls_total", "music loads, that took longer than one frame at 60 fps"
+        );
+
+        load_seconds.observe(std::chrono::duration<double>(duration).count());
+        if (duration > stall_threshold) {
+            stalls.add();
+        }
+    }
+
+} // namespace
+
 MusicManager::MusicManager(ServiceProvider* service_provider, u8 channel_size)
     : m_music{ nullptr },
       m_queued_music{ nullptr },
@@ -105,7 +130,11 @@ std::optional<std::string> MusicManager::load_and_play_music(const std::filesyst
         return std::nullopt;
     }
 
-    Mix_Music* music = Mix_LoadMUS(location.string().c_str());
+    // loading decodes the header of the file (and for some formats everything) on the calling thread, which is normally the main thread
+    const auto load_start = std::chrono::steady_clock::now();
+    Mix_Music* music = Mix_LoadMUS_RW(helper::assets::open(location), 1);
+    record_music_load(std::chrono::steady_clock::now() - load_start);
+
     if (music == nullptr) {
         return ("an error occurred while trying to load the music '" + location.string()
                 + "': " + std::string{ Mix_GetError() });
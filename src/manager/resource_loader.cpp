@@ -0,0 +1,69 @@
+#include "manager/resource_loader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+ResourceLoader::ResourceLoader(usize max_threads) : m_max_threads{ std::max<usize>(max_threads, 1) } { }
+
+void ResourceLoader::add(std::string name, std::function<void()> function) {
+    m_tasks.push_back(Task{ .name = std::move(name), .function = std::move(function) });
+}
+
+[[nodiscard]] std::vector<ResourceLoader::Timing> ResourceLoader::run() {
+    std::vector<Timing> timings(m_tasks.size());
+    std::atomic<usize> next_task{ 0 };
+
+    std::mutex exception_mutex;
+    std::exception_ptr first_exception{ nullptr };
+
+    const auto worker = [&]() {
+        while (true) {
+            const auto index = next_task.fetch_add(1, std::memory_order_relaxed);
+            if (index >= m_tasks.size()) {
+                return;
+            }
+
+            const auto& task = m_tasks.at(index);
+            const auto start = std::chrono::steady_clock::now();
+
+            try {
+                task.function();
+            } catch (...) {
+                const std::lock_guard lock{ exception_mutex };
+                if (first_exception == nullptr) {
+                    first_exception = std::current_exception();
+                }
+            }
+
+            timings.at(index) = Timing{ .name = task.name,
+                                        .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                std::chrono::steady_clock::now() - start
+                                        ) };
+        }
+    };
+
+    const auto num_threads = std::min(m_max_threads, m_tasks.size());
+
+    std::vector<std::thread> threads{};
+    for (usize i = 1; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    m_tasks.clear();
+
+    if (first_exception != nullptr) {
+        std::rethrow_exception(first_exception);
+    }
+
+    return timings;
+}
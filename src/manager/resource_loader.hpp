@@ -0,0 +1,35 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+// runs independent loading tasks in parallel on a small pool of threads and measures, how long every task took
+// tasks, that share state, that isn't thread safe (e.g. SDL subsystem initialization), have to be combined into one task
+struct ResourceLoader final {
+    struct Timing {
+        std::string name;
+        std::chrono::nanoseconds duration;
+    };
+
+private:
+    struct Task {
+        std::string name;
+        std::function<void()> function;
+    };
+
+    std::vector<Task> m_tasks;
+    usize m_max_threads;
+
+public:
+    explicit ResourceLoader(usize max_threads);
+
+    void add(std::string name, std::function<void()> function);
+
+    // blocks until all tasks are finished, the calling thread is used as one of the workers
+    // if tasks throw, the first exception is rethrown, after all tasks are finished
+    [[nodiscard]] std::vector<Timing> run();
+};
@@ -0,0 +1,48 @@
+#include <core/helper/magic_enum_wrapper.hpp>
+
+#include "manager/resource_manager.hpp"
+
+#include <chrono>
+#include <fmt/chrono.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+    [[nodiscard]] Font load_font(FontId key, const std::filesystem::path& path, int font_size) {
+        const auto start = std::chrono::steady_clock::now();
+        auto font = Font{ path, font_size };
+        spdlog::debug(
+                "loaded font {} in {}", magic_enum::enum_name(key),
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+        );
+        return font;
+    }
+
+} // namespace
+
+
+void FontManager::load(FontId key, const std::filesystem::path& path, int font_size) {
+    resources()[key] = load_font(key, path, font_size);
+}
+
+void FontManager::load_lazily(FontId key, const std::filesystem::path& path, int font_size) {
+    const std::lock_guard lock{ m_lazy_mutex };
+    m_lazy_fonts.insert_or_assign(key, LazyFont{ .path = path, .font_size = font_size });
+}
+
+[[nodiscard]] const Font& FontManager::get(FontId key) const {
+    if (const auto font = resources().find(key); font != resources().end()) {
+        return font->second;
+    }
+
+    const std::lock_guard lock{ m_lazy_mutex };
+
+    if (const auto font = m_lazy_loaded_fonts.find(key); font != m_lazy_loaded_fonts.end()) {
+        return font->second;
+    }
+
+    const auto& lazy_font = m_lazy_fonts.at(key);
+
+    // references into an unordered_map stay valid, when other elements are inserted
+    return m_lazy_loaded_fonts.emplace(key, load_font(key, lazy_font.path, lazy_font.font_size)).first->second;
+}
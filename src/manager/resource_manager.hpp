@@ -6,6 +6,7 @@
 
 #include <SDL_ttf.h>
 #include <filesystem>
+#include <mutex>
 #include <unordered_map>
 
 enum class FontId : u8 { Default, Arial, NotoColorEmoji, Symbola };
@@ -27,13 +28,30 @@ protected:
     }
 
 public:
-    [[nodiscard]] const Resource& get(Key key) const {
+    virtual ~ResourceManager() = default;
+
+    // virtual, so that managers, that load some resources on demand, also do that, when they are used as a ResourceManager
+    [[nodiscard]] virtual const Resource& get(Key key) const {
         return m_resources.at(key);
     }
 };
 
 struct FontManager : public ResourceManager<FontId, Font> {
-    void load(FontId key, const std::filesystem::path& path, int font_size) {
-        resources()[key] = Font{ path, font_size };
-    }
+private:
+    struct LazyFont {
+        std::filesystem::path path;
+        int font_size;
+    };
+
+    // rarely used fonts are only loaded on the first get(), which may happen in a const context
+    mutable std::mutex m_lazy_mutex;
+    std::unordered_map<FontId, LazyFont> m_lazy_fonts;
+    mutable std::unordered_map<FontId, Font> m_lazy_loaded_fonts;
+
+public:
+    void load(FontId key, const std::filesystem::path& path, int font_size);
+
+    void load_lazily(FontId key, const std::filesystem::path& path, int font_size);
+
+    [[nodiscard]] const Font& get(FontId key) const override;
 };
@@ -0,0 +1,176 @@
+#include <core/helper/metrics.hpp>
+
+#include "connection.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+
+namespace {
+
+    // magic, version, type, sequence, number of acknowledgements, number of ranges and number of records
+    constexpr usize input_packet_header_size = sizeof(u32) + sizeof(u8) + sizeof(u8) + sizeof(u32) + sizeof(u8)
+                                               + sizeof(u8) + sizeof(u16);
+    constexpr usize acknowledgement_size = sizeof(u8) + sizeof(SimulationStep);
+
+} // namespace
+
+
+network::Connection::Connection(u32 max_frames_ahead) : m_max_frames_ahead{ max_frames_ahead } { }
+
+void network::Connection::queue(const rollback::InputFrame& frame) {
+    m_unacknowledged.insert_or_assign({ frame.tetrion_index, frame.simulation_step_index }, frame.events);
+}
+
+[[nodiscard]] network::InputPacket network::Connection::create_input_packet() {
+    InputPacket packet{ .sequence = m_next_sequence, .acknowledgements = {}, .frames = {} };
+    ++m_next_sequence;
+
+    for (const auto& [tetrion_index, received] : m_received_frames) {
+        if (received.next_step > 1) {
+            packet.acknowledgements.push_back(
+                    Acknowledgement{ .tetrion_index = tetrion_index, .simulation_step_index = received.next_step - 1 }
+            );
+        }
+    }
+
+    auto size = input_packet_header_size + (packet.acknowledgements.size() * acknowledgement_size);
+    usize num_ranges = 0;
+    usize num_records = 0;
+    usize num_frames = 0;
+
+    using Iterator = decltype(m_unacknowledged)::const_iterator;
+
+    struct TetrionFrames {
+        Iterator next;
+        Iterator end;
+        std::vector<rollback::InputFrame> frames;
+    };
+
+    // the unacknowledged frames are ordered by tetrion, so the frames of every tetrion are one part of the map
+    std::vector<TetrionFrames> tetrions{};
+    for (auto frame = m_unacknowledged.cbegin(); frame != m_unacknowledged.cend(); ++frame) {
+        if (tetrions.empty() or tetrions.back().next->first.first != frame->first.first) {
+            tetrions.push_back(TetrionFrames{ .next = frame, .end = frame, .frames = {} });
+        }
+        tetrions.back().end = std::next(frame);
+    }
+
+    // the tetrions take turns, a tetrion is done, once its oldest remaining frame doesn't fit anymore
+    for (auto added = true; added;) {
+        added = false;
+
+        for (auto& tetrion : tetrions) {
+            if (tetrion.next == tetrion.end) {
+                continue;
+            }
+
+            const auto& [key, events] = *tetrion.next;
+            const auto& [tetrion_index, simulation_step_index] = key;
+            auto frame = rollback::InputFrame{
+                .tetrion_index = tetrion_index, .simulation_step_index = simulation_step_index, .events = events
+            };
+
+            // the frames are grouped by tetrion in the packet, so a range only continues inside of one tetrion
+            const auto starts_range = tetrion.frames.empty()
+                                      or tetrion.frames.back().simulation_step_index + 1 != simulation_step_index;
+
+            const auto frame_size = encoded_size(frame, starts_range);
+            if (size + frame_size > max_packet_size or num_frames == max_frames_per_packet
+                or (starts_range and num_ranges == std::numeric_limits<u8>::max())
+                or num_records + events.size() > std::numeric_limits<u16>::max()) {
+                tetrion.next = tetrion.end;
+                continue;
+            }
+
+            size += frame_size;
+            num_ranges += starts_range ? 1 : 0;
+            num_records += events.size();
+            ++num_frames;
+            tetrion.frames.push_back(std::move(frame));
+            ++tetrion.next;
+            added = true;
+        }
+    }
+
+    for (auto& tetrion : tetrions) {
+        std::ranges::move(tetrion.frames, std::back_inserter(packet.frames));
+    }
+
+    ++m_statistics.packets_sent;
+    return packet;
+}
+
+void network::Connection::handle(const InputPacket& packet) {
+    ++m_statistics.packets_received;
+
+    static auto& lost_counter = metrics::Registry::global().counter(
+            "oopetris_network_packets_lost_total", "gaps in the sequence numbers of received game packets"
+    );
+
+    if (not m_highest_received_sequence.has_value() or packet.sequence > m_highest_received_sequence.value()) {
+        const auto expected_sequence =
+                m_highest_received_sequence.has_value() ? m_highest_received_sequence.value() + 1 : 0;
+        const auto lost = packet.sequence - expected_sequence;
+        m_statistics.packets_lost += lost;
+        lost_counter.add(lost);
+        m_highest_received_sequence = packet.sequence;
+    } else {
+        // it was counted as lost, when a later packet arrived
+        ++m_statistics.packets_reordered;
+        if (m_statistics.packets_lost > 0) {
+            --m_statistics.packets_lost;
+        }
+    }
+
+    for (const auto& acknowledgement : packet.acknowledgements) {
+        const auto first = m_unacknowledged.lower_bound({ acknowledgement.tetrion_index, 0 });
+        const auto last = m_unacknowledged.upper_bound({ acknowledgement.tetrion_index,
+                                                         acknowledgement.simulation_step_index });
+        m_unacknowledged.erase(first, last);
+    }
+
+    for (const auto& frame : packet.frames) {
+        auto& received = m_received_frames[frame.tetrion_index];
+
+        if (frame.simulation_step_index < received.next_step or received.ahead.contains(frame.simulation_step_index)) {
+            continue;
+        }
+
+        // neither received nor acknowledged, so the peer sends it again, once the earlier frames arrived
+        if (frame.simulation_step_index >= received.next_step + m_max_frames_ahead) {
+            ++m_statistics.frames_dropped;
+            continue;
+        }
+
+        if (frame.simulation_step_index == received.next_step) {
+            ++received.next_step;
+            while (received.ahead.erase(received.next_step) > 0) {
+                ++received.next_step;
+            }
+        } else {
+            received.ahead.insert(frame.simulation_step_index);
+        }
+
+        m_received.push_back(frame);
+    }
+}
+
+[[nodiscard]] std::optional<rollback::InputFrame> network::Connection::receive() {
+    if (m_received.empty()) {
+        return std::nullopt;
+    }
+
+    auto frame = std::move(m_received.front());
+    m_received.pop_front();
+    return frame;
+}
+
+[[nodiscard]] bool network::Connection::has_unacknowledged_frames() const {
+    return not m_unacknowledged.empty();
+}
+
+[[nodiscard]] const network::Connection::Statistics& network::Connection::statistics() const {
+    return m_statistics;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "game/rollback_session.hpp"
+#include "protocol.hpp"
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace network {
+
+    // makes the input frames to one peer reliable on top of unreliable packets
+    // every frame is sent again in every packet, until the peer acknowledged it, so a lost packet is repaired by the next one, without waiting for a round trip
+    struct Connection final {
+        static constexpr u32 default_max_frames_ahead = 1024;
+        // unacknowledged frames are sent again after this, even if there is nothing new for the peer
+        static constexpr std::chrono::milliseconds resend_interval{ 20 };
+
+        struct Statistics {
+            u64 packets_sent;
+            u64 packets_received;
+            // gaps in the sequence numbers, packets that arrive late are removed from this again
+            u64 packets_lost;
+            u64 packets_reordered;
+            // frames outside of the window, they are sent again by the peer
+            u64 frames_dropped;
+        };
+
+    private:
+        struct ReceivedFrames {
+            // all frames before this step were received
+            SimulationStep next_step{ 1 };
+            // only frames inside the window are kept, so this never has more than max_frames_ahead entries
+            std::set<SimulationStep> ahead;
+        };
+
+        u32 m_max_frames_ahead;
+        u32 m_next_sequence{ 0 };
+        std::optional<u32> m_highest_received_sequence;
+        // ordered by tetrion and step, so that consecutive frames are encoded as one range
+        std::map<std::pair<u8, SimulationStep>, std::vector<InputEvent>> m_unacknowledged;
+        std::map<u8, ReceivedFrames> m_received_frames;
+        std::deque<rollback::InputFrame> m_received;
+        Statistics m_statistics{
+            .packets_sent = 0, .packets_received = 0, .packets_lost = 0, .packets_reordered = 0, .frames_dropped = 0
+        };
+
+    public:
+        // frames further ahead of the first missing frame of their tetrion are dropped without acknowledging them, so that
+        // the peer can't make this buffer arbitrary many frames, and sends them again later
+        explicit Connection(u32 max_frames_ahead = default_max_frames_ahead);
+
+        // the frame is sent with every packet, until it is acknowledged
+        void queue(const rollback::InputFrame& frame);
+
+        // contains as many unacknowledged frames as fit into max_packet_size and max_frames_per_packet, starting with the
+        // oldest of every tetrion
+        // the tetrions take turns, so that the backlog of one tetrion can't use up the whole packet
+        [[nodiscard]] InputPacket create_input_packet();
+
+        void handle(const InputPacket& packet);
+
+        // the frames, that were received for the first time, in the order they arrived
+        [[nodiscard]] std::optional<rollback::InputFrame> receive();
+
+        [[nodiscard]] bool has_unacknowledged_frames() const;
+
+        [[nodiscard]] const Statistics& statistics() const;
+    };
+
+} // namespace network
@@ -0,0 +1,291 @@
+#include <core/helper/metrics.hpp>
+
+#include "game_server.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <limits>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+
+network::GameServer::GameServer(UdpSocket&& socket, const Options& options)
+    : m_socket{ std::move(socket) },
+      m_options{ options },
+      m_buffer(max_packet_size) {
+    m_clients.reserve(options.num_players);
+}
+
+[[nodiscard]] helper::expected<std::unique_ptr<network::GameServer>, std::string>
+network::GameServer::create(const Address& address, const Options& options) {
+    if (options.num_players == 0) {
+        return helper::unexpected<std::string>{ "the server needs at least one player" };
+    }
+
+    auto socket = UdpSocket::bind(address);
+    if (not socket.has_value()) {
+        return helper::unexpected<std::string>{ socket.error() };
+    }
+
+    return std::unique_ptr<GameServer>{ new GameServer{ std::move(socket.value()), options } };
+}
+
+void network::GameServer::poll() {
+    while (true) {
+        const auto received = m_socket.receive_from(m_buffer);
+        if (not received.has_value()) {
+            spdlog::warn("unable to receive: {}", received.error());
+            break;
+        }
+
+        if (not received->has_value()) {
+            break;
+        }
+
+        const auto& [address, size] = received->value();
+
+        auto packet = decode(std::span<const char>{ m_buffer.data(), size });
+        if (not packet.has_value()) {
+            ++m_num_invalid_packets;
+            spdlog::debug("received an invalid packet from {}: {}", address.to_string(), packet.error());
+            continue;
+        }
+
+        if (const auto* join = std::get_if<JoinPacket>(&packet.value())) {
+            handle_join(address, *join);
+            continue;
+        }
+
+        const auto* input = std::get_if<InputPacket>(&packet.value());
+        const auto client = std::ranges::find_if(m_clients, [&address](const Client& value) {
+            return value.address == address;
+        });
+
+        if (input == nullptr or client == m_clients.end() or not is_started()) {
+            ++m_num_invalid_packets;
+            continue;
+        }
+
+        handle_input(*client, *input);
+    }
+
+    if (is_started()) {
+        send_input_packets();
+    }
+}
+
+[[nodiscard]] helper::expected<network::Address, std::string> network::GameServer::address() const {
+    return m_socket.local_address();
+}
+
+[[nodiscard]] bool network::GameServer::is_started() const {
+    return not m_players.empty();
+}
+
+[[nodiscard]] bool network::GameServer::is_finished() const {
+    return is_started() and std::ranges::all_of(m_clients, [](const Client& client) {
+               return client.tetrion->is_game_over();
+           });
+}
+
+[[nodiscard]] bool network::GameServer::has_timed_out_clients() const {
+    const auto now = std::chrono::steady_clock::now();
+
+    return is_started() and std::ranges::any_of(m_clients, [this, now](const Client& client) {
+               return now - client.last_received_time > m_options.client_timeout;
+           });
+}
+
+[[nodiscard]] usize network::GameServer::num_clients() const {
+    return m_clients.size();
+}
+
+[[nodiscard]] const SimulatedTetrion& network::GameServer::tetrion(const u8 tetrion_index) const {
+    if (not is_started()) {
+        throw std::logic_error("the game hasn't started yet");
+    }
+
+    return *m_clients.at(tetrion_index).tetrion;
+}
+
+[[nodiscard]] SimulationStep network::GameServer::simulation_step_index(const u8 tetrion_index) const {
+    return m_clients.at(tetrion_index).simulation_step_index;
+}
+
+[[nodiscard]] u64 network::GameServer::num_invalid_packets() const {
+    return m_num_invalid_packets;
+}
+
+[[nodiscard]] u64 network::GameServer::num_rejected_frames() const {
+    return m_num_rejected_frames;
+}
+
+void network::GameServer::handle_join(const Address& address, const JoinPacket& packet) {
+    const auto client = std::ranges::find_if(m_clients, [&address](const Client& value) {
+        return value.address == address;
+    });
+
+    if (client != m_clients.end()) {
+        // the welcome got lost
+        if (is_started()) {
+            send_packet(
+                    *client,
+                    WelcomePacket{ .tetrion_index = static_cast<u8>(client - m_clients.begin()), .players = m_players }
+            );
+        }
+        return;
+    }
+
+    if (m_clients.size() >= m_options.num_players) {
+        ++m_num_invalid_packets;
+        return;
+    }
+
+    spdlog::info("player {} joined from {}", m_clients.size(), address.to_string());
+
+    m_clients.push_back(Client{
+            .address = address,
+            .auto_shift_timings = packet.auto_shift_timings,
+            .connection = Connection{ m_options.max_frames_ahead },
+            .tetrion = nullptr,
+            .input = nullptr,
+            .simulation_step_index = 0,
+            .pending_frames = {},
+            .needs_packet = false,
+            .last_packet_time = {},
+            .last_received_time = std::chrono::steady_clock::now(),
+    });
+
+    if (m_clients.size() == m_options.num_players) {
+        start();
+    }
+}
+
+void network::GameServer::handle_input(Client& client, const InputPacket& packet) {
+    client.connection.handle(packet);
+    client.last_received_time = std::chrono::steady_clock::now();
+    // the acknowledgements have to reach the client, otherwise it sends the frames again and again
+    client.needs_packet = true;
+
+    while (const auto frame = client.connection.receive()) {
+        add_frame(client, frame.value());
+    }
+
+    simulate_frames(client);
+}
+
+void network::GameServer::add_frame(Client& client, const rollback::InputFrame& frame) {
+    static auto& rejected_counter = metrics::Registry::global().counter(
+            "oopetris_game_server_rejected_frames_total", "input frames, that the game server didn't accept"
+    );
+
+    const auto tetrion_index = static_cast<u8>(&client - m_clients.data());
+
+    // the connection already dropped the frames, that are too far ahead
+    if (frame.tetrion_index != tetrion_index) {
+        ++m_num_rejected_frames;
+        rejected_counter.add(1);
+        return;
+    }
+
+    if (frame.events.size() > m_options.max_events_per_frame) {
+        // the step still happened, without it the other players would wait for it forever
+        ++m_num_rejected_frames;
+        rejected_counter.add(1);
+        client.pending_frames.insert_or_assign(frame.simulation_step_index, std::vector<InputEvent>{});
+        return;
+    }
+
+    client.pending_frames.insert_or_assign(frame.simulation_step_index, frame.events);
+}
+
+void network::GameServer::simulate_frames(Client& client) {
+    const auto tetrion_index = static_cast<u8>(&client - m_clients.data());
+
+    for (auto frame = client.pending_frames.begin();
+         frame != client.pending_frames.end() and frame->first == client.simulation_step_index + 1;
+         frame = client.pending_frames.erase(frame)) {
+        const auto simulation_step_index = frame->first;
+
+        // after the game over the frames are only relayed, so that the other players can finish their simulation
+        if (not client.tetrion->is_game_over()) {
+            for (const auto event : frame->second) {
+                client.input->apply(event, simulation_step_index);
+            }
+
+            client.input->update(simulation_step_index);
+            client.tetrion->update_step(simulation_step_index);
+            client.input->late_update(simulation_step_index);
+        }
+
+        client.simulation_step_index = simulation_step_index;
+
+        // the simulated events are relayed, so every player simulates the same as the server
+        const auto relayed = rollback::InputFrame{ .tetrion_index = tetrion_index,
+                                                   .simulation_step_index = simulation_step_index,
+                                                   .events = std::move(frame->second) };
+        for (auto& other : m_clients) {
+            if (&other != &client) {
+                other.connection.queue(relayed);
+                other.needs_packet = true;
+            }
+        }
+    }
+}
+
+void network::GameServer::start() {
+    Random random{ m_options.seed };
+
+    m_players.reserve(m_clients.size());
+    for (auto& client : m_clients) {
+        m_players.push_back(rollback::PlayerParameters{
+                .seed = random.random<Random::Seed>(std::numeric_limits<Random::Seed>::max()),
+                .starting_level = m_options.starting_level,
+                .auto_shift_timings = client.auto_shift_timings,
+        });
+    }
+
+    for (u8 tetrion_index = 0; tetrion_index < static_cast<u8>(m_clients.size()); ++tetrion_index) {
+        auto& client = m_clients.at(tetrion_index);
+        const auto& parameters = m_players.at(tetrion_index);
+
+        // the same setup as in the rollback session of the clients
+        client.tetrion = std::make_unique<SimulatedTetrion>(
+                tetrion_index, parameters.seed, parameters.starting_level, nullptr, std::nullopt
+        );
+        client.tetrion->spawn_next_tetromino(0);
+
+        client.input = std::make_unique<rollback::FrameInput>();
+        client.input->set_auto_shift_timings(parameters.auto_shift_timings);
+        client.input->set_target_tetrion(client.tetrion.get());
+        // the clients, that joined first, waited for the others
+        client.last_received_time = std::chrono::steady_clock::now();
+
+        send_packet(client, WelcomePacket{ .tetrion_index = tetrion_index, .players = m_players });
+    }
+
+    spdlog::info("all {} players joined, the game started", m_clients.size());
+}
+
+void network::GameServer::send_packet(const Client& client, const Packet& packet) {
+    const auto bytes = encode(packet);
+    if (const auto result = m_socket.send_to(client.address, bytes); not result.has_value()) {
+        spdlog::warn("unable to send to {}: {}", client.address.to_string(), result.error());
+    }
+}
+
+void network::GameServer::send_input_packets() {
+    const auto now = std::chrono::steady_clock::now();
+
+    for (auto& client : m_clients) {
+        const auto resend =
+                client.connection.has_unacknowledged_frames() and now - client.last_packet_time >= resend_interval;
+        if (not client.needs_packet and not resend) {
+            continue;
+        }
+
+        send_packet(client, client.connection.create_input_packet());
+        client.needs_packet = false;
+        client.last_packet_time = now;
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/random.hpp>
+#include <core/helper/types.hpp>
+
+#include "connection.hpp"
+#include "game/rollback_session.hpp"
+#include "game/simulated_tetrion.hpp"
+#include "protocol.hpp"
+#include "udp_socket.hpp"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace network {
+
+    // relays the input frames between the players and simulates every tetrion itself, so the game has an authoritative result
+    // it has no graphics and no timing of its own, the frames are simulated, as soon as they arrive in order
+    struct GameServer final {
+    public:
+        static constexpr u32 default_max_events_per_frame = 32;
+        static constexpr u32 default_max_frames_ahead = Connection::default_max_frames_ahead;
+        static constexpr std::chrono::milliseconds default_client_timeout{ 10000 };
+
+        struct Options {
+            u8 num_players;
+            Random::Seed seed;
+            u32 starting_level;
+            // more events in one frame are not possible with a real input, the frame is replaced by one without events
+            u32 max_events_per_frame{ default_max_events_per_frame };
+            // frames further ahead of the simulation of their tetrion are dropped by the connection, so that a client can't make the server buffer arbitrary many frames
+            u32 max_frames_ahead{ default_max_frames_ahead };
+            // a client, that didn't send anything for this long, after the game started, is considered gone
+            std::chrono::milliseconds client_timeout{ default_client_timeout };
+        };
+
+        static constexpr std::chrono::milliseconds resend_interval = Connection::resend_interval;
+
+    private:
+        struct Client {
+            Address address;
+            input::AutoShiftTimings auto_shift_timings;
+            Connection connection;
+            std::unique_ptr<SimulatedTetrion> tetrion;
+            std::unique_ptr<rollback::FrameInput> input;
+            SimulationStep simulation_step_index;
+            // received, but not simulated, since an earlier frame is missing
+            std::map<SimulationStep, std::vector<InputEvent>> pending_frames;
+            bool needs_packet;
+            std::chrono::steady_clock::time_point last_packet_time;
+            std::chrono::steady_clock::time_point last_received_time;
+        };
+
+        UdpSocket m_socket;
+        Options m_options;
+        std::vector<rollback::PlayerParameters> m_players;
+        std::vector<Client> m_clients;
+        std::vector<char> m_buffer;
+        u64 m_num_invalid_packets{ 0 };
+        u64 m_num_rejected_frames{ 0 };
+
+        GameServer(UdpSocket&& socket, const Options& options);
+
+    public:
+        [[nodiscard]] static helper::expected<std::unique_ptr<GameServer>, std::string>
+        create(const Address& address, const Options& options);
+
+        // receives all packets, simulates the frames, that can be simulated and sends the frames to the clients
+        void poll();
+
+        [[nodiscard]] helper::expected<Address, std::string> address() const;
+
+        // all players joined and got their welcome
+        [[nodiscard]] bool is_started() const;
+        // every tetrion is game over
+        [[nodiscard]] bool is_finished() const;
+        // a client stopped sending packets, so the game can't continue
+        [[nodiscard]] bool has_timed_out_clients() const;
+
+        [[nodiscard]] usize num_clients() const;
+        [[nodiscard]] const SimulatedTetrion& tetrion(u8 tetrion_index) const;
+        // the last simulated step of the tetrion
+        [[nodiscard]] SimulationStep simulation_step_index(u8 tetrion_index) const;
+
+        [[nodiscard]] u64 num_invalid_packets() const;
+        [[nodiscard]] u64 num_rejected_frames() const;
+
+    private:
+        void handle_join(const Address& address, const JoinPacket& packet);
+        void handle_input(Client& client, const InputPacket& packet);
+        void add_frame(Client& client, const rollback::InputFrame& frame);
+        void simulate_frames(Client& client);
+        void start();
+        void send_packet(const Client& client, const Packet& packet);
+        void send_input_packets();
+    };
+
+} // namespace network
@@ -0,0 +1,335 @@
+#include <core/helper/utils.hpp>
+#include <recordings/utility/helper.hpp>
+#include <recordings/utility/recording.hpp>
+
+#include "protocol.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <optional>
+
+namespace {
+
+    constexpr usize range_size = sizeof(u8) + (2 * sizeof(SimulationStep));
+
+    struct Range {
+        u8 tetrion_index;
+        SimulationStep first_step;
+        SimulationStep last_step;
+        // the index of the first frame of the range in the frames of the packet
+        usize first_frame;
+    };
+
+    struct Reader {
+    private:
+        std::span<const char> m_bytes;
+
+    public:
+        explicit Reader(std::span<const char> bytes) : m_bytes{ bytes } { }
+
+        template<utils::integral Integral>
+        [[nodiscard]] std::optional<Integral> read() {
+            if (m_bytes.size() < sizeof(Integral)) {
+                return std::nullopt;
+            }
+
+            Integral value{};
+            std::memcpy(&value, m_bytes.data(), sizeof(Integral));
+            m_bytes = m_bytes.subspan(sizeof(Integral));
+            return utils::from_little_endian(value);
+        }
+
+        [[nodiscard]] std::optional<recorder::Record> read_record() {
+            auto record = recorder::Record::from_bytes(m_bytes);
+            if (record.has_value()) {
+                m_bytes = m_bytes.subspan(recorder::Record::encoded_size);
+            }
+            return record;
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_bytes.empty();
+        }
+    };
+
+    template<typename T>
+    using DecodeResult = helper::expected<T, std::string>;
+
+    [[nodiscard]] helper::unexpected<std::string> truncated(const char* name) {
+        return helper::unexpected<std::string>{ fmt::format("packet is truncated, missing {}", name) };
+    }
+
+    void append_auto_shift_timings(std::vector<char>& bytes, const input::AutoShiftTimings& timings) {
+        helper::writer::append_value(bytes, timings.delayed_auto_shift_frames);
+        helper::writer::append_value(bytes, timings.auto_repeat_rate_frames);
+    }
+
+    [[nodiscard]] DecodeResult<input::AutoShiftTimings> read_auto_shift_timings(Reader& reader) {
+        const auto delayed_auto_shift_frames = reader.read<u32>();
+        const auto auto_repeat_rate_frames = reader.read<u32>();
+        if (not delayed_auto_shift_frames.has_value() or not auto_repeat_rate_frames.has_value()) {
+            return truncated("auto shift timings");
+        }
+
+        return input::AutoShiftTimings{ .delayed_auto_shift_frames = delayed_auto_shift_frames.value(),
+                                        .auto_repeat_rate_frames = auto_repeat_rate_frames.value() };
+    }
+
+    void encode_packet(std::vector<char>& bytes, const network::JoinPacket& packet) {
+        append_auto_shift_timings(bytes, packet.auto_shift_timings);
+    }
+
+    void encode_packet(std::vector<char>& bytes, const network::WelcomePacket& packet) {
+        helper::writer::append_value(bytes, packet.tetrion_index);
+        helper::writer::append_value(bytes, static_cast<u8>(packet.players.size()));
+
+        for (const auto& player : packet.players) {
+            helper::writer::append_value(bytes, player.seed);
+            helper::writer::append_value(bytes, player.starting_level);
+            append_auto_shift_timings(bytes, player.auto_shift_timings);
+        }
+    }
+
+    [[nodiscard]] bool continues_range(const rollback::InputFrame& previous, const rollback::InputFrame& frame) {
+        return previous.tetrion_index == frame.tetrion_index
+               and previous.simulation_step_index + 1 == frame.simulation_step_index;
+    }
+
+    void encode_packet(std::vector<char>& bytes, const network::InputPacket& packet) {
+        helper::writer::append_value(bytes, packet.sequence);
+
+        helper::writer::append_value(bytes, static_cast<u8>(packet.acknowledgements.size()));
+        for (const auto& acknowledgement : packet.acknowledgements) {
+            helper::writer::append_value(bytes, acknowledgement.tetrion_index);
+            helper::writer::append_value(bytes, acknowledgement.simulation_step_index);
+        }
+
+        std::vector<std::pair<usize, usize>> ranges{};
+        usize num_records = 0;
+        for (usize index = 0; index < packet.frames.size(); ++index) {
+            if (index == 0 or not continues_range(packet.frames.at(index - 1), packet.frames.at(index))) {
+                ranges.emplace_back(index, index);
+            }
+            ranges.back().second = index;
+            num_records += packet.frames.at(index).events.size();
+        }
+
+        helper::writer::append_value(bytes, static_cast<u8>(ranges.size()));
+        for (const auto& [first, last] : ranges) {
+            helper::writer::append_value(bytes, packet.frames.at(first).tetrion_index);
+            helper::writer::append_value(bytes, packet.frames.at(first).simulation_step_index);
+            helper::writer::append_value(bytes, packet.frames.at(last).simulation_step_index);
+        }
+
+        helper::writer::append_value(bytes, static_cast<u16>(num_records));
+        for (const auto& frame : packet.frames) {
+            for (const auto event : frame.events) {
+                recorder::Record{ .tetrion_index = frame.tetrion_index,
+                                  .simulation_step_index = frame.simulation_step_index,
+                                  .event = event }
+                        .append_bytes(bytes);
+            }
+        }
+    }
+
+    [[nodiscard]] DecodeResult<network::Packet> decode_join(Reader& reader) {
+        const auto timings = read_auto_shift_timings(reader);
+        if (not timings.has_value()) {
+            return helper::unexpected<std::string>{ timings.error() };
+        }
+
+        return network::JoinPacket{ .auto_shift_timings = timings.value() };
+    }
+
+    [[nodiscard]] DecodeResult<network::Packet> decode_welcome(Reader& reader) {
+        const auto tetrion_index = reader.read<u8>();
+        const auto num_players = reader.read<u8>();
+        if (not tetrion_index.has_value() or not num_players.has_value()) {
+            return truncated("welcome header");
+        }
+
+        if (tetrion_index.value() >= num_players.value()) {
+            return helper::unexpected<std::string>{ fmt::format(
+                    "tetrion index out of bounds: {} >= {}", tetrion_index.value(), num_players.value()
+            ) };
+        }
+
+        network::WelcomePacket packet{ .tetrion_index = tetrion_index.value(), .players = {} };
+        for (u8 index = 0; index < num_players.value(); ++index) {
+            const auto seed = reader.read<Random::Seed>();
+            const auto starting_level = reader.read<u32>();
+            if (not seed.has_value() or not starting_level.has_value()) {
+                return truncated("player parameters");
+            }
+
+            const auto timings = read_auto_shift_timings(reader);
+            if (not timings.has_value()) {
+                return helper::unexpected<std::string>{ timings.error() };
+            }
+
+            packet.players.push_back(rollback::PlayerParameters{ .seed = seed.value(),
+                                                                 .starting_level = starting_level.value(),
+                                                                 .auto_shift_timings = timings.value() });
+        }
+
+        return packet;
+    }
+
+    [[nodiscard]] DecodeResult<network::Packet> decode_input(Reader& reader) {
+        const auto sequence = reader.read<u32>();
+        const auto num_acknowledgements = reader.read<u8>();
+        if (not sequence.has_value() or not num_acknowledgements.has_value()) {
+            return truncated("input header");
+        }
+
+        network::InputPacket packet{ .sequence = sequence.value(), .acknowledgements = {}, .frames = {} };
+
+        for (u8 index = 0; index < num_acknowledgements.value(); ++index) {
+            const auto tetrion_index = reader.read<u8>();
+            const auto simulation_step_index = reader.read<SimulationStep>();
+            if (not tetrion_index.has_value() or not simulation_step_index.has_value()) {
+                return truncated("acknowledgement");
+            }
+
+            packet.acknowledgements.push_back(network::Acknowledgement{
+                    .tetrion_index = tetrion_index.value(), .simulation_step_index = simulation_step_index.value() });
+        }
+
+        const auto num_ranges = reader.read<u8>();
+        if (not num_ranges.has_value()) {
+            return truncated("number of ranges");
+        }
+
+        std::vector<Range> ranges{};
+        for (u8 index = 0; index < num_ranges.value(); ++index) {
+            const auto tetrion_index = reader.read<u8>();
+            const auto first_step = reader.read<SimulationStep>();
+            const auto last_step = reader.read<SimulationStep>();
+            if (not tetrion_index.has_value() or not first_step.has_value() or not last_step.has_value()) {
+                return truncated("range");
+            }
+
+            if (last_step.value() < first_step.value()
+                or last_step.value() - first_step.value() >= network::max_frames_per_packet - packet.frames.size()) {
+                return helper::unexpected<std::string>{
+                    fmt::format("invalid range: {} - {}", first_step.value(), last_step.value())
+                };
+            }
+
+            ranges.push_back(Range{ .tetrion_index = tetrion_index.value(),
+                                    .first_step = first_step.value(),
+                                    .last_step = last_step.value(),
+                                    .first_frame = packet.frames.size() });
+            for (auto step = first_step.value(); step <= last_step.value(); ++step) {
+                packet.frames.push_back(rollback::InputFrame{
+                        .tetrion_index = tetrion_index.value(), .simulation_step_index = step, .events = {} });
+            }
+        }
+
+        const auto num_records = reader.read<u16>();
+        if (not num_records.has_value()) {
+            return truncated("number of records");
+        }
+
+        for (u16 index = 0; index < num_records.value(); ++index) {
+            const auto record = reader.read_record();
+            if (not record.has_value()) {
+                return helper::unexpected<std::string>{ "packet contains an invalid or truncated record" };
+            }
+
+            const auto range = std::ranges::find_if(ranges, [&record](const Range& range) {
+                return range.tetrion_index == record->tetrion_index
+                       and range.first_step <= record->simulation_step_index
+                       and record->simulation_step_index <= range.last_step;
+            });
+
+            if (range == ranges.end()) {
+                return helper::unexpected<std::string>{ fmt::format(
+                        "record of tetrion {} at step {} is outside of all ranges", record->tetrion_index,
+                        record->simulation_step_index
+                ) };
+            }
+
+            const auto offset = record->simulation_step_index - range->first_step;
+            packet.frames.at(range->first_frame + offset).events.push_back(record->event);
+        }
+
+        return packet;
+    }
+
+} // namespace
+
+
+[[nodiscard]] std::vector<char> network::encode(const Packet& packet) {
+    std::vector<char> bytes{};
+    bytes.reserve(max_packet_size);
+
+    helper::writer::append_value(bytes, protocol_magic);
+    helper::writer::append_value(bytes, protocol_version);
+
+    std::visit(
+            [&bytes](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, JoinPacket>) {
+                    helper::writer::append_value(bytes, utils::to_underlying(PacketType::Join));
+                } else if constexpr (std::is_same_v<T, WelcomePacket>) {
+                    helper::writer::append_value(bytes, utils::to_underlying(PacketType::Welcome));
+                } else {
+                    helper::writer::append_value(bytes, utils::to_underlying(PacketType::Input));
+                }
+
+                encode_packet(bytes, value);
+            },
+            packet
+    );
+
+    return bytes;
+}
+
+[[nodiscard]] helper::expected<network::Packet, std::string> network::decode(std::span<const char> bytes) {
+    Reader reader{ bytes };
+
+    const auto magic = reader.read<u32>();
+    const auto version = reader.read<u8>();
+    const auto type = reader.read<u8>();
+    if (not magic.has_value() or not version.has_value() or not type.has_value()) {
+        return truncated("header");
+    }
+
+    if (magic.value() != protocol_magic) {
+        return helper::unexpected<std::string>{ fmt::format("invalid magic: {:#x}", magic.value()) };
+    }
+
+    if (version.value() != protocol_version) {
+        return helper::unexpected<std::string>{ fmt::format(
+                "unsupported protocol version {}, expected {}", version.value(), protocol_version
+        ) };
+    }
+
+    DecodeResult<Packet> result = helper::unexpected<std::string>{ "" };
+
+    switch (type.value()) {
+        case utils::to_underlying(PacketType::Join):
+            result = decode_join(reader);
+            break;
+        case utils::to_underlying(PacketType::Welcome):
+            result = decode_welcome(reader);
+            break;
+        case utils::to_underlying(PacketType::Input):
+            result = decode_input(reader);
+            break;
+        default:
+            return helper::unexpected<std::string>{ fmt::format("unknown packet type: {}", type.value()) };
+    }
+
+    if (result.has_value() and not reader.is_empty()) {
+        return helper::unexpected<std::string>{ "packet has trailing bytes" };
+    }
+
+    return result;
+}
+
+[[nodiscard]] usize network::encoded_size(const rollback::InputFrame& frame, const bool starts_range) {
+    return (starts_range ? range_size : 0) + (frame.events.size() * recorder::Record::encoded_size);
+}
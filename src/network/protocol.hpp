@@ -0,0 +1,75 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/types.hpp>
+
+#include "game/rollback_session.hpp"
+#include "input/auto_shift.hpp"
+
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// the binary protocol of the game server, all integers are little endian and the input events are encoded like the records of a recording
+// every packet starts with the magic, the version and the packet type
+namespace network {
+
+    constexpr u32 protocol_magic = 0x54504F4F; // OOPT in ascii (in little endian)
+    constexpr u8 protocol_version = 1;
+
+    // stays below the usual MTU, so that packets aren't fragmented
+    constexpr usize max_packet_size = 1200;
+
+    // a packet can't contain more frames than this, so that a malicious range can't allocate arbitrary memory
+    // frames without events barely take space, so the sender has to stop at this limit as well
+    constexpr usize max_frames_per_packet = 4096;
+
+    enum class PacketType : u8 {
+        Join = 1,
+        Welcome = 2,
+        Input = 3,
+    };
+
+    // sent by a client until it receives a welcome
+    struct JoinPacket {
+        input::AutoShiftTimings auto_shift_timings;
+
+        [[nodiscard]] bool operator==(const JoinPacket& other) const = default;
+    };
+
+    // sent by the server, once all players joined, it contains everything that is needed to start the rollback session
+    struct WelcomePacket {
+        u8 tetrion_index;
+        std::vector<rollback::PlayerParameters> players;
+
+        [[nodiscard]] bool operator==(const WelcomePacket& other) const = default;
+    };
+
+    // all frames of the tetrion up to this step were received
+    struct Acknowledgement {
+        u8 tetrion_index;
+        SimulationStep simulation_step_index;
+
+        [[nodiscard]] bool operator==(const Acknowledgement& other) const = default;
+    };
+
+    struct InputPacket {
+        u32 sequence;
+        std::vector<Acknowledgement> acknowledgements;
+        // consecutive frames of a tetrion are encoded as one range, so frames without events only cost their step
+        std::vector<rollback::InputFrame> frames;
+
+        [[nodiscard]] bool operator==(const InputPacket& other) const = default;
+    };
+
+    using Packet = std::variant<JoinPacket, WelcomePacket, InputPacket>;
+
+    [[nodiscard]] std::vector<char> encode(const Packet& packet);
+
+    [[nodiscard]] helper::expected<Packet, std::string> decode(std::span<const char> bytes);
+
+    // the encoded size of the frames in an input packet, so that a packet can be filled up to max_packet_size
+    [[nodiscard]] usize encoded_size(const rollback::InputFrame& frame, bool starts_range);
+
+} // namespace network
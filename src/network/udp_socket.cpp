@@ -0,0 +1,284 @@
+#include <core/helper/metrics.hpp>
+
+#include "udp_socket.hpp"
+
+#include <array>
+#include <charconv>
+#include <fmt/format.h>
+#include <limits>
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    using SocketLength = int;
+    using BufferLength = int;
+    constexpr std::uintptr_t invalid_handle = INVALID_SOCKET;
+
+    [[nodiscard]] std::string last_error() {
+        return fmt::format("error {}", WSAGetLastError());
+    }
+
+    [[nodiscard]] bool would_block() {
+        const auto error = WSAGetLastError();
+        // windows reports ICMP port unreachable messages of earlier packets on the next receive
+        return error == WSAEWOULDBLOCK or error == WSAECONNRESET;
+    }
+
+    [[nodiscard]] helper::expected<void, std::string> initialize_sockets() {
+        static const int result = [] {
+            WSADATA data{};
+            return WSAStartup(MAKEWORD(2, 2), &data);
+        }();
+
+        if (result != 0) {
+            return helper::unexpected<std::string>{ fmt::format("unable to initialize winsock: error {}", result) };
+        }
+
+        return {};
+    }
+#else
+    using SocketLength = socklen_t;
+    using BufferLength = usize;
+    constexpr int invalid_handle = -1;
+
+    [[nodiscard]] std::string last_error() {
+        return std::strerror(errno);
+    }
+
+    [[nodiscard]] bool would_block() {
+        return errno == EAGAIN or errno == EWOULDBLOCK or errno == ECONNREFUSED;
+    }
+
+    [[nodiscard]] helper::expected<void, std::string> initialize_sockets() {
+        return {};
+    }
+#endif
+
+    [[nodiscard]] sockaddr_in to_socket_address(const network::Address& address) {
+        sockaddr_in result{};
+        result.sin_family = AF_INET;
+        result.sin_addr.s_addr = htonl(address.ip);
+        result.sin_port = htons(address.port);
+        return result;
+    }
+
+    [[nodiscard]] network::Address from_socket_address(const sockaddr_in& address) {
+        return network::Address{ .ip = ntohl(address.sin_addr.s_addr), .port = ntohs(address.sin_port) };
+    }
+
+    template<typename T>
+    [[nodiscard]] std::optional<T> parse_number(std::string_view value) {
+        T result{};
+        const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+        if (error != std::errc{} or end != value.data() + value.size()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+} // namespace
+
+
+[[nodiscard]] helper::expected<network::Address, std::string> network::Address::from_string(const std::string& value) {
+    const auto invalid = [&value]() {
+        return helper::unexpected<std::string>{ fmt::format("invalid IPv4 address: '{}'", value) };
+    };
+
+    std::string_view rest{ value };
+    u16 port = 0;
+
+    if (const auto colon = rest.find(':'); colon != std::string_view::npos) {
+        const auto parsed_port = parse_number<u16>(rest.substr(colon + 1));
+        if (not parsed_port.has_value()) {
+            return invalid();
+        }
+        port = parsed_port.value();
+        rest = rest.substr(0, colon);
+    }
+
+    u32 ip = 0;
+    for (usize index = 0; index < 4; ++index) {
+        const auto dot = rest.find('.');
+        if ((dot == std::string_view::npos) != (index == 3)) {
+            return invalid();
+        }
+
+        const auto part = parse_number<u8>(rest.substr(0, dot));
+        if (not part.has_value()) {
+            return invalid();
+        }
+
+        ip = (ip << 8) | part.value();
+        rest = dot == std::string_view::npos ? std::string_view{} : rest.substr(dot + 1);
+    }
+
+    return Address{ .ip = ip, .port = port };
+}
+
+[[nodiscard]] std::string network::Address::to_string() const {
+    return fmt::format("{}.{}.{}.{}:{}", (ip >> 24) & 0xFF, (ip >> 16) & 0xFF, (ip >> 8) & 0xFF, ip & 0xFF, port);
+}
+
+
+network::UdpSocket::UdpSocket(Handle handle) : m_handle{ handle } { }
+
+[[nodiscard]] helper::expected<network::UdpSocket, std::string> network::UdpSocket::bind(const Address& address) {
+    if (const auto initialized = initialize_sockets(); not initialized.has_value()) {
+        return helper::unexpected<std::string>{ initialized.error() };
+    }
+
+    const auto handle = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == invalid_handle) {
+        return helper::unexpected<std::string>{ fmt::format("unable to create a socket: {}", last_error()) };
+    }
+
+    // from here on the destructor closes the handle on errors
+    UdpSocket result{ handle };
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    u_long non_blocking = 1;
+    if (ioctlsocket(handle, FIONBIO, &non_blocking) != 0) {
+        return helper::unexpected<std::string>{
+            fmt::format("unable to make the socket non-blocking: {}", last_error())
+        };
+    }
+#else
+    const auto flags = ::fcntl(handle, F_GETFL, 0); //NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (flags < 0 or ::fcntl(handle, F_SETFL, flags | O_NONBLOCK) != 0 //NOLINT(cppcoreguidelines-pro-type-vararg)
+        or ::fcntl(handle, F_SETFD, FD_CLOEXEC) != 0) {                //NOLINT(cppcoreguidelines-pro-type-vararg)
+        return helper::unexpected<std::string>{
+            fmt::format("unable to make the socket non-blocking: {}", last_error())
+        };
+    }
+#endif
+
+    const auto socket_address = to_socket_address(address);
+    const auto* socket_address_pointer =
+            reinterpret_cast<const sockaddr*>(&socket_address); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (::bind(handle, socket_address_pointer, sizeof(socket_address)) != 0) {
+        return helper::unexpected<std::string>{
+            fmt::format("unable to bind the socket to {}: {}", address.to_string(), last_error())
+        };
+    }
+
+    return result;
+}
+
+network::UdpSocket::UdpSocket(UdpSocket&& other) noexcept : m_handle{ other.m_handle } {
+    other.m_handle = invalid_handle;
+}
+
+network::UdpSocket& network::UdpSocket::operator=(UdpSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_handle = other.m_handle;
+        other.m_handle = invalid_handle;
+    }
+    return *this;
+}
+
+network::UdpSocket::~UdpSocket() {
+    close();
+}
+
+[[nodiscard]] helper::expected<network::Address, std::string> network::UdpSocket::local_address() const {
+    sockaddr_in socket_address{};
+    SocketLength length = sizeof(socket_address);
+    if (::getsockname(
+                m_handle,
+                reinterpret_cast<sockaddr*>(&socket_address), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                &length
+        )
+        != 0) {
+        return helper::unexpected<std::string>{ fmt::format("unable to get the socket address: {}", last_error()) };
+    }
+
+    return from_socket_address(socket_address);
+}
+
+[[nodiscard]] helper::expected<void, std::string>
+network::UdpSocket::send_to(const Address& address, std::span<const char> bytes) {
+    static auto& packets_counter =
+            metrics::Registry::global().counter("oopetris_network_packets_sent_total", "sent UDP packets");
+    static auto& bytes_counter = metrics::Registry::global().counter(
+            "oopetris_network_sent_bytes_total", "payload bytes of sent UDP packets"
+    );
+
+    const auto socket_address = to_socket_address(address);
+    const auto sent = ::sendto(
+            m_handle, bytes.data(), static_cast<BufferLength>(bytes.size()), 0,
+            reinterpret_cast<const sockaddr*>(&socket_address), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            sizeof(socket_address)
+    );
+
+    if (sent < 0) {
+        // a full send buffer drops the packet, like the network would, the protocol repairs that
+        if (would_block()) {
+            return {};
+        }
+
+        return helper::unexpected<std::string>{
+            fmt::format("unable to send to {}: {}", address.to_string(), last_error())
+        };
+    }
+
+    packets_counter.add(1);
+    bytes_counter.add(bytes.size());
+    return {};
+}
+
+[[nodiscard]] helper::expected<std::optional<std::pair<network::Address, usize>>, std::string>
+network::UdpSocket::receive_from(std::span<char> buffer) {
+    static auto& packets_counter =
+            metrics::Registry::global().counter("oopetris_network_packets_received_total", "received UDP packets");
+    static auto& bytes_counter = metrics::Registry::global().counter(
+            "oopetris_network_received_bytes_total", "payload bytes of received UDP packets"
+    );
+
+    sockaddr_in socket_address{};
+    SocketLength length = sizeof(socket_address);
+    const auto received = ::recvfrom(
+            m_handle, buffer.data(), static_cast<BufferLength>(buffer.size()), 0,
+            reinterpret_cast<sockaddr*>(&socket_address), //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            &length
+    );
+
+    if (received < 0) {
+        if (would_block()) {
+            return std::nullopt;
+        }
+
+        return helper::unexpected<std::string>{ fmt::format("unable to receive: {}", last_error()) };
+    }
+
+    packets_counter.add(1);
+    bytes_counter.add(static_cast<u64>(received));
+    return std::pair{ from_socket_address(socket_address), static_cast<usize>(received) };
+}
+
+void network::UdpSocket::close() {
+    if (m_handle == invalid_handle) {
+        return;
+    }
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    ::closesocket(m_handle);
+#else
+    ::close(m_handle);
+#endif
+    m_handle = invalid_handle;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+#include <core/helper/types.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace network {
+
+    // an IPv4 address in host byte order
+    struct Address {
+        u32 ip;
+        u16 port;
+
+        static constexpr u32 localhost = 0x7F000001;
+        static constexpr u32 any = 0;
+
+        // accepts "a.b.c.d:port" and "a.b.c.d", in that case the port is 0
+        [[nodiscard]] static helper::expected<Address, std::string> from_string(const std::string& value);
+
+        [[nodiscard]] std::string to_string() const;
+
+        [[nodiscard]] bool operator==(const Address& other) const = default;
+    };
+
+    // a non-blocking UDP socket, so that it can be polled every frame from the game loop
+    struct UdpSocket final {
+    private:
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+        using Handle = std::uintptr_t;
+#else
+        using Handle = int;
+#endif
+
+        Handle m_handle;
+
+        explicit UdpSocket(Handle handle);
+
+    public:
+        // port 0 binds to any free port, local_address() returns the one, that was chosen
+        [[nodiscard]] static helper::expected<UdpSocket, std::string> bind(const Address& address);
+
+        UdpSocket(const UdpSocket&) = delete;
+        UdpSocket& operator=(const UdpSocket&) = delete;
+        UdpSocket(UdpSocket&& other) noexcept;
+        UdpSocket& operator=(UdpSocket&& other) noexcept;
+        ~UdpSocket();
+
+        [[nodiscard]] helper::expected<Address, std::string> local_address() const;
+
+        [[nodiscard]] helper::expected<void, std::string> send_to(const Address& address, std::span<const char> bytes);
+
+        // nullopt, if no packet is available, packets larger than the buffer are truncated
+        [[nodiscard]] helper::expected<std::optional<std::pair<Address, usize>>, std::string> receive_from(
+                std::span<char> buffer
+        );
+
+    private:
+        void close();
+    };
+
+} // namespace network
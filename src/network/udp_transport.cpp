@@ -0,0 +1,100 @@
+#include "udp_transport.hpp"
+
+#include <spdlog/spdlog.h>
+
+
+network::UdpTransport::UdpTransport(UdpSocket&& socket, const Address& server_address)
+    : m_socket{ std::move(socket) },
+      m_server_address{ server_address },
+      m_buffer(max_packet_size) { }
+
+[[nodiscard]] helper::expected<std::unique_ptr<network::UdpTransport>, std::string> network::UdpTransport::create(
+        const Address& server_address
+) {
+    auto socket = UdpSocket::bind(Address{ .ip = Address::any, .port = 0 });
+    if (not socket.has_value()) {
+        return helper::unexpected<std::string>{ socket.error() };
+    }
+
+    return std::unique_ptr<UdpTransport>{ new UdpTransport{ std::move(socket.value()), server_address } };
+}
+
+void network::UdpTransport::join(const input::AutoShiftTimings& auto_shift_timings) {
+    send_packet(JoinPacket{ .auto_shift_timings = auto_shift_timings });
+}
+
+void network::UdpTransport::poll() {
+    while (true) {
+        const auto received = m_socket.receive_from(m_buffer);
+        if (not received.has_value()) {
+            spdlog::warn("unable to receive from the game server: {}", received.error());
+            break;
+        }
+
+        if (not received->has_value()) {
+            break;
+        }
+
+        const auto& [address, size] = received->value();
+        if (address != m_server_address) {
+            ++m_num_invalid_packets;
+            continue;
+        }
+
+        auto packet = decode(std::span<const char>{ m_buffer.data(), size });
+        if (not packet.has_value()) {
+            ++m_num_invalid_packets;
+            spdlog::debug("received an invalid packet from the game server: {}", packet.error());
+            continue;
+        }
+
+        if (auto* welcome = std::get_if<WelcomePacket>(&packet.value())) {
+            m_welcome = std::move(*welcome);
+        } else if (const auto* input = std::get_if<InputPacket>(&packet.value())) {
+            m_connection.handle(*input);
+            m_needs_packet = true;
+        } else {
+            ++m_num_invalid_packets;
+        }
+    }
+
+    const auto needs_resend = m_needs_packet or m_connection.has_unacknowledged_frames();
+    if (needs_resend and std::chrono::steady_clock::now() - m_last_packet_time >= Connection::resend_interval) {
+        resend();
+    }
+}
+
+[[nodiscard]] const std::optional<network::WelcomePacket>& network::UdpTransport::welcome() const {
+    return m_welcome;
+}
+
+void network::UdpTransport::send(const rollback::InputFrame& frame) {
+    m_connection.queue(frame);
+    resend();
+}
+
+[[nodiscard]] std::optional<rollback::InputFrame> network::UdpTransport::receive() {
+    poll();
+    return m_connection.receive();
+}
+
+void network::UdpTransport::resend() {
+    send_packet(m_connection.create_input_packet());
+    m_needs_packet = false;
+    m_last_packet_time = std::chrono::steady_clock::now();
+}
+
+[[nodiscard]] const network::Connection::Statistics& network::UdpTransport::statistics() const {
+    return m_connection.statistics();
+}
+
+[[nodiscard]] u64 network::UdpTransport::num_invalid_packets() const {
+    return m_num_invalid_packets;
+}
+
+void network::UdpTransport::send_packet(const Packet& packet) {
+    const auto bytes = encode(packet);
+    if (const auto result = m_socket.send_to(m_server_address, bytes); not result.has_value()) {
+        spdlog::warn("unable to send to the game server: {}", result.error());
+    }
+}
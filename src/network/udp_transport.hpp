@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core/helper/expected.hpp>
+
+#include "connection.hpp"
+#include "game/rollback_transport.hpp"
+#include "input/auto_shift.hpp"
+#include "protocol.hpp"
+#include "udp_socket.hpp"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace network {
+
+    // the client side of the game server, it sends the local frames to the server, which relays them to the other players
+    struct UdpTransport final : public rollback::Transport {
+    private:
+        UdpSocket m_socket;
+        Address m_server_address;
+        Connection m_connection;
+        std::optional<WelcomePacket> m_welcome;
+        std::vector<char> m_buffer;
+        u64 m_num_invalid_packets{ 0 };
+        // the received frames have to be acknowledged, even if there are no new frames to send
+        bool m_needs_packet{ false };
+        std::chrono::steady_clock::time_point m_last_packet_time;
+
+        UdpTransport(UdpSocket&& socket, const Address& server_address);
+
+    public:
+        [[nodiscard]] static helper::expected<std::unique_ptr<UdpTransport>, std::string> create(
+                const Address& server_address
+        );
+
+        // the packet may be lost, so this has to be repeated, until welcome() returns a value
+        void join(const input::AutoShiftTimings& auto_shift_timings);
+
+        // receives all packets, that arrived, and sends the unacknowledged frames again, if they weren't sent for
+        // Connection::resend_interval, so a stalled session still repairs lost packets, as long as it receives
+        void poll();
+
+        // the server sends it, once all players joined
+        [[nodiscard]] const std::optional<WelcomePacket>& welcome() const;
+
+        void send(const rollback::InputFrame& frame) override;
+
+        [[nodiscard]] std::optional<rollback::InputFrame> receive() override;
+
+        // sends the unacknowledged frames again immediately, without a new frame
+        void resend();
+
+        [[nodiscard]] const Connection::Statistics& statistics() const;
+        [[nodiscard]] u64 num_invalid_packets() const;
+
+    private:
+        void send_packet(const Packet& packet);
+    };
+
+} // namespace network
@@ -14,6 +14,12 @@
 #include "ui/layout.hpp"
 #include "ui/layouts/scroll_layout.hpp"
 
+namespace {
+
+    constexpr auto lobby_poll_interval = std::chrono::seconds{ 2 };
+
+} // namespace
+
 namespace scenes {
 
     OnlineLobby::OnlineLobby(ServiceProvider* service_provider, const ui::Layout& layout)
@@ -29,14 +35,25 @@ namespace scenes {
           } {
 
         //TODO(Totto): after the settings have been reworked, make this url changeable!
-        auto maybe_client = lobby::Client::get_client("http://127.0.0.1:5000");
-        if (maybe_client.has_value()) {
-            m_client = std::make_unique<lobby::Client>(std::move(maybe_client.value()));
-        } else {
-            spdlog::error("Error in connecting to lobby client: {}", maybe_client.error());
-        }
+        m_client = std::make_unique<lobby::AsyncClient>("http://127.0.0.1:5000", [](lobby::Result<void>&& result) {
+            if (not result.has_value()) {
+                spdlog::error("Error in connecting to lobby client: {}", result.error());
+            }
+        });
+
+        m_client->start_polling_lobbies(lobby_poll_interval, [this](lobby::Result<lobby::LobbyListUpdate>&& result) {
+            if (not result.has_value()) {
+                spdlog::warn("Error in getting the lobbies: {}", result.error());
+                return;
+            }
+
+            spdlog::debug(
+                    "lobby list changed: {} added, {} changed, {} removed", result->added.size(),
+                    result->changed.size(), result->removed.size()
+            );
 
-        auto focus_helper = ui::FocusHelper{ 1 };
+            update_lobbies(result.value());
+        });
 
         m_main_layout.add<ui::Label>(
                 service_provider, "Select Lobby to play in", service_provider->font_manager().get(FontId::Default),
@@ -44,38 +61,11 @@ namespace scenes {
                 ui::Alignment{ ui::AlignmentHorizontal::Middle, ui::AlignmentVertical::Center }
         );
 
-        const auto scroll_layout_index = m_main_layout.add<ui::ScrollLayout>(
-                service_provider, focus_helper.focus_id(), ui::AbsolutMargin{ 10 },
+        m_scroll_layout_index = m_main_layout.add<ui::ScrollLayout>(
+                service_provider, m_focus_helper.focus_id(), ui::AbsolutMargin{ 10 },
                 std::pair<double, double>{ 0.05, 0.03 }
         );
 
-        auto* scroll_layout = m_main_layout.get<ui::ScrollLayout>(scroll_layout_index);
-
-        for (auto i = 0; i < 7; ++i) {
-            if (i == 2) {
-                scroll_layout->add<ui::TextInput>(
-                        ui::RelativeItemSize{ scroll_layout->layout(), 0.2 }, service_provider,
-                        service_provider->font_manager().get(FontId::Symbola), Color::white(), focus_helper.focus_id(),
-                        std::pair<double, double>{ 0.9, 0.9 },
-                        ui::Alignment{ ui::AlignmentHorizontal::Middle, ui::AlignmentVertical::Center },
-                        ui::TextInputMode::Scroll
-                );
-            } else {
-                scroll_layout->add<ui::TextButton>(
-                        ui::RelativeItemSize{ scroll_layout->layout(), 0.2 }, service_provider,
-                        fmt::format("Button Nr.: {}", i), service_provider->font_manager().get(FontId::Default),
-                        Color::white(), focus_helper.focus_id(),
-                        [i](const ui::TextButton&) -> bool {
-                            spdlog::info("Pressed button: {}", i);
-                            return false;
-                        },
-                        std::pair<double, double>{ 0.8, 1.0 },
-                        ui::Alignment{ ui::AlignmentHorizontal::Middle, ui::AlignmentVertical::Center },
-                        std::pair<double, double>{ 0.1, 0.2 }
-                );
-            }
-        }
-
         constexpr auto button_size = utils::get_orientation() == utils::Orientation::Landscape
                                              ? std::pair<double, double>{ 0.15, 0.85 }
                                              : std::pair<double, double>{ 0.5, 0.85 };
@@ -87,7 +77,7 @@ namespace scenes {
 
         m_main_layout.add<ui::TextButton>(
                 service_provider, "Return", service_provider->font_manager().get(FontId::Default), Color::white(),
-                focus_helper.focus_id(),
+                m_focus_helper.focus_id(),
                 [this](const ui::TextButton&) -> bool {
                     m_next_command = Command::Return;
                     return false;
@@ -97,6 +87,8 @@ namespace scenes {
     }
 
     [[nodiscard]] Scene::UpdateResult OnlineLobby::update() {
+        m_client->poll();
+
         m_main_layout.update();
 
         if (m_next_command.has_value()) {
@@ -163,4 +155,45 @@ namespace scenes {
         return false;
     }
 
+    void OnlineLobby::update_lobbies(const lobby::LobbyListUpdate& update) {
+        auto* scroll_layout = m_main_layout.get<ui::ScrollLayout>(m_scroll_layout_index);
+        const auto item_size = ui::RelativeItemSize{ scroll_layout->layout(), 0.2 };
+
+        for (const auto& change : m_lobbies.apply(update)) {
+            const auto index = static_cast<u32>(change.index);
+
+            switch (change.type) {
+                case lobby::LobbyListChange::Type::Insert:
+                    scroll_layout->insert(index, item_size, lobby_row(m_lobbies.lobbies().at(change.index)));
+                    break;
+                case lobby::LobbyListChange::Type::Update:
+                    scroll_layout->replace(index, item_size, lobby_row(m_lobbies.lobbies().at(change.index)));
+                    break;
+                case lobby::LobbyListChange::Type::Remove:
+                    scroll_layout->remove(index);
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+    }
+
+    [[nodiscard]] ui::ScrollLayout::WidgetFactory OnlineLobby::lobby_row(const lobby::LobbyInfo& lobby) {
+        // the row is created by the scroll layout, when it gets visible, so it gets its focus id only then
+        return [this, lobby](const ui::Layout& layout) -> std::unique_ptr<ui::Widget> {
+            return std::make_unique<ui::TextButton>(
+                    m_service_provider,
+                    fmt::format("{} ({}/{})", lobby.name, lobby.num_players_in_lobby, lobby.size),
+                    m_service_provider->font_manager().get(FontId::Default), Color::white(), m_focus_helper.focus_id(),
+                    [lobby_id = lobby.id](const ui::TextButton&) -> bool {
+                        spdlog::info("Selected lobby: {}", lobby_id);
+                        return false;
+                    },
+                    std::pair<double, double>{ 0.8, 1.0 },
+                    ui::Alignment{ ui::AlignmentHorizontal::Middle, ui::AlignmentVertical::Center },
+                    std::pair<double, double>{ 0.1, 0.2 }, layout, false
+            );
+        };
+    }
+
 } // namespace scenes
@@ -1,10 +1,12 @@
 #pragma once
 
-#include "lobby/api.hpp"
+#include "lobby/async_client.hpp"
+#include "lobby/cache.hpp"
 
 #include "scenes/scene.hpp"
 #include "ui/components/label.hpp"
 #include "ui/components/text_button.hpp"
+#include "ui/layouts/scroll_layout.hpp"
 #include "ui/layouts/tile_layout.hpp"
 
 #include <memory>
@@ -17,7 +19,10 @@ namespace scenes {
 
         ui::TileLayout m_main_layout;
         std::optional<Command> m_next_command;
-        std::unique_ptr<lobby::Client> m_client{ nullptr };
+        std::unique_ptr<lobby::AsyncClient> m_client;
+        lobby::LobbyCache m_lobbies;
+        ui::FocusHelper m_focus_helper{ 1 };
+        u32 m_scroll_layout_index;
 
     public:
         explicit OnlineLobby(ServiceProvider* service_provider, const ui::Layout& layout);
@@ -25,6 +30,12 @@ namespace scenes {
         [[nodiscard]] UpdateResult update() override;
         void render(const ServiceProvider& service_provider) override;
         bool handle_event(const std::shared_ptr<input::InputManager>& input_manager, const SDL_Event& event) override;
+
+    private:
+        // only the rows of lobbies, that changed, are touched
+        void update_lobbies(const lobby::LobbyListUpdate& update);
+
+        [[nodiscard]] ui::ScrollLayout::WidgetFactory lobby_row(const lobby::LobbyInfo& lobby);
     };
 
 } // namespace scenes
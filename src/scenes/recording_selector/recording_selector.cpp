@@ -39,8 +39,6 @@ namespace scenes {
                 layout
           } {
 
-        auto focus_helper = ui::FocusHelper{ 1 };
-
         m_main_layout.add<ui::Label>(
                 service_provider, "Select Recording to replay", service_provider->font_manager().get(FontId::Default),
                 Color::white(), std::pair<double, double>{ 0.5, 1.0 },
@@ -48,7 +46,7 @@ namespace scenes {
         );
 
         m_main_layout.add<ui::ScrollLayout>(
-                service_provider, focus_helper.focus_id(), ui::AbsolutMargin{ 10 },
+                service_provider, m_focus_helper.focus_id(), ui::AbsolutMargin{ 10 },
                 std::pair<double, double>{ 0.05, 0.03 }
         );
 
@@ -65,7 +63,7 @@ namespace scenes {
 
         m_main_layout.add<ui::TextButton>(
                 service_provider, "Return", service_provider->font_manager().get(FontId::Default), Color::white(),
-                focus_helper.focus_id(),
+                m_focus_helper.focus_id(),
                 [this](const ui::TextButton&) -> bool {
                     m_next_command = Command{ Return{} };
                     return false;
@@ -216,18 +214,21 @@ namespace scenes {
             scroll_layout->clear_widgets();
         }
 
-        auto focus_helper = ui::FocusHelper{ 3 };
-
-        for (const auto& metadata : metadata_vector) {
-            scroll_layout->add<custom_ui::RecordingComponent>(
-                    ui::RelativeItemSize{ scroll_layout->layout(), 0.2 }, m_service_provider, std::ref(focus_helper),
-                    metadata
+        // there can be thousands of recordings, so their widgets are only created, when they are near the viewport
+        for (auto& metadata : metadata_vector) {
+            scroll_layout->insert(
+                    scroll_layout->widget_count(), ui::RelativeItemSize{ scroll_layout->layout(), 0.2 },
+                    [this, metadata = std::move(metadata)](const ui::Layout& layout) {
+                        return std::make_unique<custom_ui::RecordingComponent>(
+                                m_service_provider, m_focus_helper, metadata, layout, false
+                        );
+                    }
             );
         }
 
 #if defined(_HAVE_FILE_DIALOGS)
         scroll_layout->add<custom_ui::RecordingFileChooser>(
-                ui::RelativeItemSize{ scroll_layout->layout(), 0.2 }, m_service_provider, std::ref(focus_helper)
+                ui::RelativeItemSize{ scroll_layout->layout(), 0.2 }, m_service_provider, std::ref(m_focus_helper)
         );
 #endif
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scenes/scene.hpp"
+#include "ui/focusable.hpp"
 #include "ui/layouts/tile_layout.hpp"
 #include "ui/widget.hpp"
 
@@ -35,6 +36,8 @@ namespace scenes {
         ui::TileLayout m_main_layout;
         std::optional<details::recording::selector::Command> m_next_command{ std::nullopt };
         std::vector<std::filesystem::path> m_chosen_paths;
+        // the recording widgets are recreated, when they get near the viewport again, so they need new focus ids
+        ui::FocusHelper m_focus_helper{ 1 };
 
     public:
         explicit RecordingSelector(ServiceProvider* service_provider, const ui::Layout& layout);
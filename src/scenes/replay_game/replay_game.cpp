@@ -7,6 +7,7 @@
 #include "manager/music_manager.hpp"
 #include "scenes/scene.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace scenes {
@@ -14,7 +15,8 @@ namespace scenes {
     ReplayGame::ReplayGame(
             ServiceProvider* service_provider,
             const ui::Layout& layout,
-            const std::filesystem::path& recording_path
+            const std::filesystem::path& recording_path,
+            const ClockFactory& clock_factory
     )
         : Scene{ service_provider, layout } {
 
@@ -44,11 +46,26 @@ namespace scenes {
         }
 
 
+        const auto replay_speed = service_provider->command_line_arguments().replay_speed;
+
+        const auto create_clock = [&clock_factory, replay_speed](u32 frequency) -> std::unique_ptr<ClockSource> {
+            if (clock_factory) {
+                return clock_factory(frequency);
+            }
+
+            if (replay_speed != CommandLineArguments::default_replay_speed) {
+                return std::make_unique<ScaledClock>(frequency, replay_speed);
+            }
+
+            return nullptr;
+        };
+
         for (decltype(parameters.size()) i = 0; i < parameters.size(); ++i) {
             auto [input, starting_parameters] = std::move(parameters.at(i));
 
             m_games.emplace_back(std::make_unique<Game>(
-                    service_provider, std::move(input), starting_parameters, simulation_frequency, layouts.at(i), false
+                    service_provider, std::move(input), starting_parameters, simulation_frequency, layouts.at(i), false,
+                    create_clock(simulation_frequency)
             ));
         }
 
@@ -74,6 +91,10 @@ namespace scenes {
     }
 
 
+    [[nodiscard]] bool ReplayGame::is_finished() const {
+        return std::ranges::all_of(m_games, [](const auto& game) { return game->is_game_finished(); });
+    }
+
     [[nodiscard]] Scene::UpdateResult ReplayGame::update() {
         bool all_games_finished = true;
         for (auto& game : m_games) {
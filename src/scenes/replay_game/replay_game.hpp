@@ -17,9 +17,13 @@ namespace scenes {
         explicit ReplayGame(
                 ServiceProvider* service_provider,
                 const ui::Layout& layout,
-                const std::filesystem::path& recording_path
+                const std::filesystem::path& recording_path,
+                const ClockFactory& clock_factory = {}
         );
 
+        // true, if all games reached the end of the recording or are game over
+        [[nodiscard]] bool is_finished() const;
+
         [[nodiscard]] UpdateResult update() override;
         void render(const ServiceProvider& service_provider) override;
         [[nodiscard]] bool
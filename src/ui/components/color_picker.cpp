@@ -33,25 +33,26 @@ detail::ColorSlider::ColorSlider(
 
     change_layout();
 
-    m_texture = std::make_unique<Texture>(
-            service_provider->renderer().get_texture_for_render_target(bar_rect().to_dimension_point())
-    );
-
-    service_provider->renderer().set_render_target(*m_texture);
-
     const auto w = bar_rect().width();
-    const auto h = bar_rect().height();
 
+    // every column has the same color, so a single row is enough, it gets stretched to the bar_rect when rendering
+    m_texture = std::make_unique<Texture>(service_provider->renderer().get_texture_for_pixels(shapes::UPoint{ w, 1 }));
+
+    std::vector<HSVColor> hsv_colors{};
+    hsv_colors.reserve(w);
     for (u32 x = 0; x < w; x++) {
-        const Color color =
-                HSVColor((static_cast<double>(x) / static_cast<double>(w)) * 360.0, 1.0, 1.0).to_rgb_color();
+        hsv_colors.emplace_back((static_cast<double>(x) / static_cast<double>(w)) * 360.0, 1.0, 1.0);
+    }
 
-        service_provider->renderer().draw_line(
-                shapes::UPoint{ x, 0 }, shapes::UPoint{ x, static_cast<u32>(h - 1) }, color
-        );
+    std::vector<Color> colors(w);
+    color::to_rgb_colors(hsv_colors, colors);
+
+    std::vector<u32> pixels(w);
+    for (u32 x = 0; x < w; x++) {
+        pixels[x] = Texture::to_pixel(colors[x]);
     }
 
-    service_provider->renderer().reset_render_target();
+    m_texture->update_pixels(pixels);
 }
 
 [[nodiscard]] std::pair<shapes::URect, shapes::URect> detail::ColorSlider::get_rectangles() const {
@@ -252,30 +253,41 @@ void detail::ColorCanvas::redraw_texture() {
 
     const auto fill_rect = layout().get_rect();
 
-    m_texture = std::make_unique<Texture>(
-            m_service_provider->renderer().get_texture_for_render_target(fill_rect.to_dimension_point())
-    );
-
-    m_service_provider->renderer().set_render_target(*m_texture);
-
     const auto width = fill_rect.width();
     const auto height = fill_rect.height();
 
-    const auto hue = m_current_color.h;
+    if (m_texture == nullptr) {
+        m_texture = std::make_unique<Texture>(
+                m_service_provider->renderer().get_texture_for_pixels(fill_rect.to_dimension_point())
+        );
+    }
+
+    // the saturation only depends on the column and the value only on the row, so a row of colors is reused and converted at once
+    std::vector<HSVColor> hsv_row{};
+    hsv_row.reserve(width);
+    for (u32 x = 0; x < width; x++) {
+        hsv_row.emplace_back(m_current_color.h, static_cast<double>(x) / static_cast<double>(width), 0.0);
+    }
+
+    std::vector<Color> rgb_row(width);
+
+    m_pixels.resize(static_cast<usize>(width) * static_cast<usize>(height));
 
-    //TODO(Totto): try to speed this up, since it is a performance bottle neck, if hovering like a madman (xD) over the color slider
-    // maybe use shaders?
     for (u32 y = 0; y < height; y++) {
         const auto value = 1.0 - (static_cast<double>(y) / static_cast<double>(height));
-        for (u32 x = 0; x < width; x++) {
-            const Color color =
-                    HSVColor(hue, static_cast<double>(x) / static_cast<double>(width), value).to_rgb_color();
+        for (auto& hsv_color : hsv_row) {
+            hsv_color.v = value;
+        }
 
-            m_service_provider->renderer().draw_pixel(shapes::UPoint{ x, y }, color);
+        color::to_rgb_colors(hsv_row, rgb_row);
+
+        u32* const row = m_pixels.data() + (static_cast<usize>(y) * width);
+        for (u32 x = 0; x < width; x++) {
+            row[x] = Texture::to_pixel(rgb_row[x]);
         }
     }
 
-    m_service_provider->renderer().reset_render_target();
+    m_texture->update_pixels(m_pixels);
 }
 
 
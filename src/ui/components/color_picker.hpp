@@ -11,6 +11,7 @@
 #include "ui/widget.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace detail {
 
@@ -46,6 +47,8 @@ namespace detail {
     private:
         ServiceProvider* m_service_provider;
         std::unique_ptr<Texture> m_texture{};
+        // reused between redraws, so that changing the hue doesn't allocate
+        std::vector<u32> m_pixels{};
         HSVColor m_current_color;
         Callback m_callback;
         bool m_is_dragging{ false };
@@ -0,0 +1,131 @@
+#include "hit_test_index.hpp"
+
+#include <algorithm>
+
+
+namespace {
+
+    constexpr u64 max_cells_per_axis = 1024;
+
+    // they can't contain any point, and their bottom right corner is before the top left one
+    [[nodiscard]] bool is_empty(const shapes::URect& rect) {
+        return rect.width() == 0 or rect.height() == 0;
+    }
+
+} // namespace
+
+
+void ui::HitTestIndex::rebuild(std::span<const shapes::URect> rects) {
+    clear();
+
+    const auto first = std::ranges::find_if_not(rects, is_empty);
+    if (first == rects.end()) {
+        return;
+    }
+
+    m_bounds = *first;
+    for (const auto& rect : rects) {
+        if (is_empty(rect)) {
+            continue;
+        }
+
+        m_bounds.top_left.x = std::min(m_bounds.top_left.x, rect.top_left.x);
+        m_bounds.top_left.y = std::min(m_bounds.top_left.y, rect.top_left.y);
+        m_bounds.bottom_right.x = std::max(m_bounds.bottom_right.x, rect.bottom_right.x);
+        m_bounds.bottom_right.y = std::max(m_bounds.bottom_right.y, rect.bottom_right.y);
+    }
+
+    // a cell has about the average size of a rect, so that a point is only in a few rects of its cell
+    u64 total_width = 0;
+    u64 total_height = 0;
+    for (const auto& rect : rects) {
+        total_width += rect.width();
+        total_height += rect.height();
+    }
+    const auto average_width = std::max<u64>(total_width / rects.size(), 1);
+    const auto average_height = std::max<u64>(total_height / rects.size(), 1);
+
+    m_columns = static_cast<u32>(std::clamp<u64>(m_bounds.width() / average_width, 1, max_cells_per_axis));
+    m_rows = static_cast<u32>(std::clamp<u64>(m_bounds.height() / average_height, 1, max_cells_per_axis));
+
+    // small rects, that are far apart, would need a lot of empty cells
+    const auto max_cells = 4 * rects.size() + 16;
+    while (static_cast<usize>(m_columns) * m_rows > max_cells) {
+        if (m_columns > m_rows) {
+            m_columns = (m_columns + 1) / 2;
+        } else {
+            m_rows = (m_rows + 1) / 2;
+        }
+    }
+
+    m_cell_width = std::max<u32>((m_bounds.width() + m_columns - 1) / m_columns, 1);
+    m_cell_height = std::max<u32>((m_bounds.height() + m_rows - 1) / m_rows, 1);
+
+    const auto for_each_cell = [this](const shapes::URect& rect, const auto& function) {
+        if (is_empty(rect)) {
+            return;
+        }
+
+        const auto first_column = (rect.top_left.x - m_bounds.top_left.x) / m_cell_width;
+        const auto last_column = (rect.bottom_right.x - m_bounds.top_left.x) / m_cell_width;
+        const auto first_row = (rect.top_left.y - m_bounds.top_left.y) / m_cell_height;
+        const auto last_row = (rect.bottom_right.y - m_bounds.top_left.y) / m_cell_height;
+
+        for (auto row = first_row; row <= last_row; ++row) {
+            for (auto column = first_column; column <= last_column; ++column) {
+                function(cell_index(column, row));
+            }
+        }
+    };
+
+    // counting sort, first the number of rects per cell, then the rects themselves
+    m_cell_starts.assign(static_cast<usize>(m_columns) * m_rows + 1, 0);
+    for (const auto& rect : rects) {
+        for_each_cell(rect, [this](u32 cell) { ++m_cell_starts.at(cell + 1); });
+    }
+
+    for (usize cell = 1; cell < m_cell_starts.size(); ++cell) {
+        m_cell_starts.at(cell) += m_cell_starts.at(cell - 1);
+    }
+
+    m_indices.resize(m_cell_starts.back());
+    auto next_positions = m_cell_starts;
+    for (u32 index = 0; index < rects.size(); ++index) {
+        for_each_cell(rects[index], [this, &next_positions, index](u32 cell) {
+            m_indices.at(next_positions.at(cell)++) = index;
+        });
+    }
+}
+
+void ui::HitTestIndex::clear() {
+    m_bounds = shapes::URect{ 0, 0, 0, 0 };
+    m_columns = 0;
+    m_rows = 0;
+    m_cell_starts.clear();
+    m_indices.clear();
+}
+
+[[nodiscard]] std::span<const u32> ui::HitTestIndex::candidates(const shapes::IPoint& point) const {
+    if (m_cell_starts.empty() or point.x < 0 or point.y < 0) {
+        return {};
+    }
+
+    const auto x = static_cast<u32>(point.x);
+    const auto y = static_cast<u32>(point.y);
+    if (x < m_bounds.top_left.x or x > m_bounds.bottom_right.x or y < m_bounds.top_left.y
+        or y > m_bounds.bottom_right.y) {
+        return {};
+    }
+
+    const auto column = (x - m_bounds.top_left.x) / m_cell_width;
+    const auto row = (y - m_bounds.top_left.y) / m_cell_height;
+    const auto cell = cell_index(column, row);
+
+    return std::span<const u32>{ m_indices }.subspan(
+            m_cell_starts.at(cell), m_cell_starts.at(cell + 1) - m_cell_starts.at(cell)
+    );
+}
+
+[[nodiscard]] u32 ui::HitTestIndex::cell_index(const u32 column, const u32 row) const {
+    return row * m_columns + column;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <core/helper/types.hpp>
+
+#include "graphics/rect.hpp"
+
+#include <span>
+#include <vector>
+
+namespace ui {
+
+    // a uniform grid over the rects of the widgets of a layout, a point only has to be tested against the rects, that overlap its cell
+    struct HitTestIndex {
+    private:
+        shapes::URect m_bounds{ 0, 0, 0, 0 };
+        u32 m_columns{ 0 };
+        u32 m_rows{ 0 };
+        u32 m_cell_width{ 1 };
+        u32 m_cell_height{ 1 };
+        // the rect indices of cell i are m_indices[m_cell_starts[i], m_cell_starts[i + 1]), in ascending order
+        std::vector<u32> m_cell_starts;
+        std::vector<u32> m_indices;
+
+    public:
+        void rebuild(std::span<const shapes::URect> rects);
+
+        void clear();
+
+        // the indices of the rects, that might contain the point, sorted like the rects
+        [[nodiscard]] std::span<const u32> candidates(const shapes::IPoint& point) const;
+
+    private:
+        [[nodiscard]] u32 cell_index(u32 column, u32 row) const;
+    };
+
+} // namespace ui
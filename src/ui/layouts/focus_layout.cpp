@@ -34,6 +34,12 @@ void ui::FocusLayout::update() {
 
 ui::Widget::EventHandleResult
 ui::FocusLayout::handle_event(const std::shared_ptr<input::InputManager>& input_manager, const SDL_Event& event) {
+    const auto pointer_event = input_manager->get_pointer_event(event);
+
+    if (pointer_event.has_value()) {
+        add_focused_pointer_target();
+    }
+
     Widget::EventHandleResult handled = handle_focus_change_events(input_manager, event);
 
     if (handled) {
@@ -41,22 +47,35 @@ ui::FocusLayout::handle_event(const std::shared_ptr<input::InputManager>& input_
     }
 
 
-    if (const auto pointer_event = input_manager->get_pointer_event(event); pointer_event.has_value()) {
+    if (pointer_event.has_value()) {
 
-        for (auto& widget : m_widgets) {
-            const auto layout = widget->layout();
-            if (not handled and pointer_event->is_in(layout.get_rect())) {
-                if (const auto event_result = widget->handle_event(input_manager, event); event_result) {
-                    handled = { true, handle_event_result(event_result.get_additional(), widget.get()) };
-                    continue;
-                }
-            } else {
-                const auto hoverable = as_hoverable(widget.get());
-                if (hoverable.has_value()) {
-                    hoverable.value()->on_unhover();
-                }
+        if (not m_is_hit_test_index_valid) {
+            std::vector<shapes::URect> rects{};
+            rects.reserve(m_widgets.size());
+            for (const auto& widget : m_widgets) {
+                rects.push_back(widget->layout().get_rect());
             }
+
+            m_hit_test_index.rebuild(rects);
+            m_is_hit_test_index_valid = true;
         }
+
+        // only the first widget, that handles the event, and the ones before it, that contain the pointer, get it
+        std::vector<Widget*> targets{};
+        for (const auto index : m_hit_test_index.candidates(pointer_event->position())) {
+            auto& widget = m_widgets.at(index);
+            if (not pointer_event->is_in(widget->layout().get_rect())) {
+                continue;
+            }
+
+            targets.push_back(widget.get());
+            if (const auto event_result = widget->handle_event(input_manager, event); event_result) {
+                handled = { true, handle_event_result(event_result.get_additional(), widget.get()) };
+                break;
+            }
+        }
+
+        set_pointer_targets(std::move(targets));
         return handled;
     }
 
@@ -290,6 +309,36 @@ ui::FocusLayout::handle_event_result(const std::optional<ui::Widget::InnerState>
     return true;
 }
 
+void ui::FocusLayout::add_focused_pointer_target() {
+    if (not has_focus() or not m_focus_id.has_value()) {
+        return;
+    }
+
+    auto* const focused = m_widgets.at(focusable_index_by_id(m_focus_id.value())).get();
+    if (std::ranges::find(m_pointer_targets, focused) == m_pointer_targets.end()) {
+        m_pointer_targets.push_back(focused);
+    }
+}
+
+void ui::FocusLayout::set_pointer_targets(std::vector<Widget*>&& targets) {
+    for (auto* const widget : m_pointer_targets) {
+        if (std::ranges::find(targets, widget) != targets.end()) {
+            continue;
+        }
+
+        const auto hoverable = as_hoverable(widget);
+        if (hoverable.has_value()) {
+            hoverable.value()->on_unhover();
+        }
+    }
+
+    m_pointer_targets = std::move(targets);
+}
+
+void ui::FocusLayout::forget_pointer_target(const Widget* widget) {
+    std::erase(m_pointer_targets, widget);
+}
+
 void ui::FocusLayout::give_focus(Focusable* focusable) {
     m_focus_id = focusable->focus_id();
     focusable->focus();
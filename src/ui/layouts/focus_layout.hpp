@@ -4,6 +4,7 @@
 #include <core/helper/utils.hpp>
 
 #include "ui/focusable.hpp"
+#include "ui/hit_test_index.hpp"
 #include "ui/widget.hpp"
 
 #include <fmt/format.h>
@@ -24,6 +25,10 @@ namespace ui {
 
     private:
         FocusOptions m_options;
+        HitTestIndex m_hit_test_index;
+        bool m_is_hit_test_index_valid{ false };
+        // the widgets, that got pointer events since the last one, only these can be hovered
+        std::vector<Widget*> m_pointer_targets;
 
     protected:
         std::optional<u32>
@@ -46,6 +51,7 @@ namespace ui {
             const Layout layout = get_layout_for_index(index);
 
             m_widgets.push_back(std::move(std::make_unique<T>(std::forward<Args>(args)..., layout, false)));
+            m_is_hit_test_index_valid = false;
             auto focusable = as_focusable(m_widgets.back().get());
             if (focusable.has_value() and not m_focus_id.has_value()) {
                 give_focus(focusable.value());
@@ -112,6 +118,15 @@ namespace ui {
 
         [[nodiscard]] virtual Layout get_layout_for_index(u32 index) = 0;
 
+        // the focused widget gets every event, so it might be hovered afterwards
+        void add_focused_pointer_target();
+
+        // unhovers the widgets, that got the previous pointer events, but not the current one
+        void set_pointer_targets(std::vector<Widget*>&& targets);
+
+        // has to be called, before a widget is destroyed
+        void forget_pointer_target(const Widget* widget);
+
         Widget::EventHandleResult virtual handle_focus_change_events(
                 const std::shared_ptr<input::InputManager>& input_manager,
                 const SDL_Event& event
@@ -122,7 +137,8 @@ namespace ui {
 
         [[nodiscard]] u32 focusable_index_by_id(u32 id) const;
 
-        [[nodiscard]] std::vector<u32> focusable_ids_sorted() const;
+        // the order, in which the focus moves through the widgets
+        [[nodiscard]] virtual std::vector<u32> focusable_ids_sorted() const;
 
         [[nodiscard]] static u32 index_of(const std::vector<u32>& ids, u32 needle);
 
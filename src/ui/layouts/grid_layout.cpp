@@ -25,7 +25,7 @@ ui::GridLayout::GridLayout(
 
 void ui::GridLayout::render(const ServiceProvider& service_provider) const {
     for (const auto& widget : m_widgets) {
-        widget->render(service_provider);
+        render_profiled(*widget, service_provider);
     }
 }
 
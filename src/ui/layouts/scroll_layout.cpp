@@ -3,6 +3,8 @@
 #include "input/input.hpp"
 #include "scroll_layout.hpp"
 
+#include <algorithm>
+
 ui::ItemSize::ItemSize(const u32 height, ItemSizeType type) : height{ height }, type{ type } { }
 
 
@@ -68,26 +70,34 @@ void ui::ScrollLayout::render(const ServiceProvider& service_provider) const {
 
     const auto& renderer = service_provider.renderer();
 
-    const auto total_widgets_height = m_widgets.empty() ? 0 : m_widgets.back()->layout().get_rect().bottom_right.y;
+    const auto total_widgets_height = this->total_widgets_height();
 
     if (m_texture.has_value()) {
 
         renderer.set_render_target(m_texture.value());
         renderer.clear();
-        for (const auto& widget : m_widgets) {
-            // smart rendering, only render, when viewport needs this widget
-            const auto layout_rect = widget->layout().get_rect();
-            if (layout_rect.top_left.y > m_viewport.bottom_right.y) {
-                continue;
-            }
 
-            if (layout_rect.bottom_right.y < m_viewport.top_left.y) {
+        // smart rendering, only render the widgets, that the viewport needs, the items are sorted by their offset
+        const auto first = std::ranges::partition_point(m_items, [this](const Item& item) {
+            return item.offset + item.height <= m_viewport.top_left.y;
+        });
+
+        for (auto index = static_cast<u32>(std::distance(m_items.begin(), first));
+             index < m_items.size() and m_items.at(index).offset <= m_viewport.bottom_right.y; ++index) {
+            const auto& widget = m_widgets.at(index);
+            if (widget == nullptr) {
                 continue;
             }
 
-            widget->render(service_provider);
+            // the texture only has the size of the viewport, so the item is moved up by the scroll position
+            const auto& item = m_items.at(index);
+            const auto item_top = static_cast<i32>(item.offset) - static_cast<i32>(m_viewport.top_left.y);
+            renderer.set_viewport(shapes::IRect{ 0, item_top, static_cast<i32>(main_rect.width()),
+                                                 static_cast<i32>(item.height) });
+            render_profiled(*widget, service_provider);
         }
 
+        renderer.reset_viewport();
         renderer.reset_render_target();
 
         auto to_rect = main_rect;
@@ -97,7 +107,9 @@ void ui::ScrollLayout::render(const ServiceProvider& service_provider) const {
                                      total_widgets_height };
         }
 
-        renderer.draw_texture(m_texture.value(), m_viewport, to_rect);
+        renderer.draw_texture(
+                m_texture.value(), shapes::URect{ 0, 0, m_viewport.width(), m_viewport.height() }, to_rect
+        );
     }
 
     // render the scrollbar when it makes sense
@@ -110,6 +122,11 @@ void ui::ScrollLayout::render(const ServiceProvider& service_provider) const {
 
 ui::Widget::EventHandleResult
 ui::ScrollLayout::handle_event(const std::shared_ptr<input::InputManager>& input_manager, const SDL_Event& event) {
+    const auto pointer_event = input_manager->get_pointer_event(event);
+
+    if (pointer_event.has_value()) {
+        add_focused_pointer_target();
+    }
 
     Widget::EventHandleResult handled = handle_focus_change_events(input_manager, event);
 
@@ -119,7 +136,7 @@ ui::ScrollLayout::handle_event(const std::shared_ptr<input::InputManager>& input
     }
 
 
-    const u32 total_widgets_height = m_widgets.empty() ? 0 : m_widgets.back()->layout().get_rect().bottom_right.y;
+    const u32 total_widgets_height = this->total_widgets_height();
 
     const auto change_value_on_scroll = [total_widgets_height, this](const input::PointerEventHelper& pointer_event) {
         const auto& [_, y] = pointer_event.position();
@@ -147,8 +164,6 @@ ui::ScrollLayout::handle_event(const std::shared_ptr<input::InputManager>& input
         recalculate_sizes(desired_scroll_height);
     };
 
-    const auto pointer_event = input_manager->get_pointer_event(event);
-
     if (pointer_event == input::PointerEvent::PointerDown) {
         // note: this behaviour is intentional, namely, clicking into the scroll slider doesn't move it, it just "grabs" it for dragging
         if (pointer_event->is_in(scrollbar_mover_rect)) {
@@ -202,25 +217,28 @@ ui::ScrollLayout::handle_event(const std::shared_ptr<input::InputManager>& input
 
     if (pointer_event.has_value()) {
 
-        const auto offset_distance = main_rect.top_left.cast<i32>() - m_viewport.top_left.cast<i32>();
-        for (auto& widget : m_widgets) {
-            const auto& layout_rect = widget->layout().get_rect();
-            const auto& offset_rect = (layout_rect.cast<i32>()) >> offset_distance;
+        std::vector<Widget*> targets{};
+
+        // the items are sorted by their offset and don't overlap, so at most one contains the pointer
+        const auto index = item_index_at(pointer_event->position());
+        if (not handled and index.has_value() and m_widgets.at(index.value()) != nullptr
+            and pointer_event->is_in(main_rect)) {
+            auto& widget = m_widgets.at(index.value());
+
+            const auto offset_distance = widget_offset(index.value());
+            const auto& offset_rect = (widget->layout().get_rect().cast<i32>()) >> offset_distance;
+
+            if (pointer_event->is_in(offset_rect)) {
+                targets.push_back(widget.get());
 
-            if (not handled and pointer_event->is_in(main_rect) and pointer_event->is_in(offset_rect)) {
                 const auto offset_event = input_manager->offset_pointer_event(event, -offset_distance);
                 if (const auto event_result = widget->handle_event(input_manager, offset_event); event_result) {
                     handled = { true, handle_event_result(event_result.get_additional(), widget.get()) };
-                    continue;
-                }
-            } else {
-                const auto hoverable = as_hoverable(widget.get());
-                if (hoverable.has_value()) {
-                    hoverable.value()->on_unhover();
                 }
             }
         }
 
+        set_pointer_targets(std::move(targets));
         return handled;
     }
 
@@ -243,7 +261,8 @@ ui::Widget::EventHandleResult ui::ScrollLayout::handle_focus_change_events(
 
 
     if (m_focus_id.has_value()) {
-        const auto& widget = m_widgets.at(focusable_index_by_id(m_focus_id.value()));
+        const auto index = focusable_index_by_id(m_focus_id.value());
+        const auto& widget = m_widgets.at(index);
 
 
         if (widget->type() != WidgetType::Container) {
@@ -259,9 +278,7 @@ ui::Widget::EventHandleResult ui::ScrollLayout::handle_focus_change_events(
         auto new_event = event;
 
         if (const auto pointer_event = input_manager->get_pointer_event(event); pointer_event.has_value()) {
-
-            const auto offset_distance = main_rect.top_left.cast<i32>() - m_viewport.top_left.cast<i32>();
-            new_event = input_manager->offset_pointer_event(event, -offset_distance);
+            new_event = input_manager->offset_pointer_event(event, -widget_offset(index));
         }
 
         if (const auto event_result = widget->handle_event(input_manager, new_event); event_result) {
@@ -280,39 +297,309 @@ ui::Widget::EventHandleResult ui::ScrollLayout::handle_focus_change_events(
 }
 
 
+void ui::ScrollLayout::update() {
+    for (auto& widget : m_widgets) {
+        if (widget != nullptr) {
+            widget->update();
+        }
+    }
+}
+
+void ui::ScrollLayout::insert(const u32 index, const ItemSize size, WidgetFactory factory) {
+    insert_item(index, size, std::move(factory));
+}
+
+void ui::ScrollLayout::replace(const u32 index, const ItemSize size, WidgetFactory factory) {
+    const auto had_focus = is_focused(index);
+
+    const auto old_height = m_items.at(index).height;
+    m_items.at(index).height = size.get_height();
+    m_items.at(index).create = std::move(factory);
+
+    forget_pointer_target(m_widgets.at(index).get());
+
+    if (not had_focus) {
+        m_widgets.at(index) = nullptr;
+    } else {
+        auto widget = m_items.at(index).create(get_layout_for_new(size));
+        const auto new_focusable = as_focusable(widget.get());
+
+        if (new_focusable.has_value()) {
+            m_widgets.at(index) = std::move(widget);
+            give_focus(new_focusable.value());
+        } else {
+            release_focus(index);
+            m_widgets.at(index) = std::move(widget);
+        }
+    }
+
+    if (old_height != size.get_height()) {
+        update_offsets(index);
+    }
+
+    recalculate_sizes(static_cast<i32>(m_viewport.top_left.y));
+}
+
+void ui::ScrollLayout::remove(const u32 index) {
+    release_focus(index);
+    forget_pointer_target(m_widgets.at(index).get());
+
+    m_widgets.erase(m_widgets.begin() + index);
+    m_items.erase(m_items.begin() + index);
+
+    if (index < m_alive_begin) {
+        --m_alive_begin;
+    }
+    if (index < m_alive_end) {
+        --m_alive_end;
+    }
+    if (m_kept_index == index) {
+        m_kept_index = std::nullopt;
+    } else if (m_kept_index.has_value() and m_kept_index.value() > index) {
+        m_kept_index = m_kept_index.value() - 1;
+    }
+
+    update_offsets(index);
+    recalculate_sizes(static_cast<i32>(m_viewport.top_left.y));
+}
+
 void ui::ScrollLayout::clear_widgets() {
 
+    set_pointer_targets({});
     m_widgets.clear();
+    m_items.clear();
     m_texture = std::nullopt;
     m_focus_id = std::nullopt;
+    m_alive_begin = 0;
+    m_alive_end = 0;
+    m_kept_index = std::nullopt;
 
     recalculate_sizes(0);
 }
 
+[[nodiscard]] std::vector<u32> ui::ScrollLayout::focusable_ids_sorted() const {
+    // the focus moves from top to bottom, independent of the focus ids, since items can be inserted everywhere
+    auto result = std::vector<u32>{};
+    for (const auto& widget : m_widgets) {
+        const auto focusable = as_focusable(widget.get());
+        if (focusable.has_value()) {
+            result.push_back(focusable.value()->focus_id());
+        }
+    }
+
+    return result;
+}
+
 [[nodiscard]] ui::Layout ui::ScrollLayout::get_layout_for_index(u32) {
     // see TODO comment over handle_event in header file
     throw std::runtime_error("NOT SUPPORTED");
 }
 
-[[nodiscard]] ui::Layout ui::ScrollLayout::get_layout_for_new(ItemSize size) {
-    u32 start_point_y = 0;
+[[nodiscard]] ui::Layout ui::ScrollLayout::get_layout_for_new(ItemSize size) const {
+    return AbsolutLayout{
+        0,
+        0,
+        main_rect.width(),
+        size.get_height(),
+    };
+}
 
-    for (const auto& widget : m_widgets) {
-        const auto& widget_rect = widget->layout().get_rect();
-        start_point_y += static_cast<u32>(widget_rect.height());
+[[nodiscard]] u32 ui::ScrollLayout::total_widgets_height() const {
+    if (m_items.empty()) {
+        return 0;
     }
 
-    start_point_y += gap.get_margin() * static_cast<u32>(m_widgets.size());
+    return m_items.back().offset + m_items.back().height;
+}
 
-    const auto width = static_cast<u32>(main_rect.width());
-    const auto height = size.get_height();
+[[nodiscard]] shapes::URect ui::ScrollLayout::item_rect(const u32 index) const {
+    const auto& item = m_items.at(index);
+    return shapes::URect{ 0, item.offset, main_rect.width(), item.height };
+}
 
-    return AbsolutLayout{
-        0,
-        start_point_y,
-        width,
-        height,
+[[nodiscard]] shapes::IPoint ui::ScrollLayout::widget_offset(const u32 index) const {
+    return main_rect.top_left.cast<i32>() - m_viewport.top_left.cast<i32>()
+           + shapes::IPoint{ 0, static_cast<i32>(m_items.at(index).offset) };
+}
+
+[[nodiscard]] std::optional<u32> ui::ScrollLayout::item_index_at(const shapes::IPoint& position) const {
+    const auto y = position.y - static_cast<i32>(main_rect.top_left.y) + static_cast<i32>(m_viewport.top_left.y);
+    if (y < 0) {
+        return std::nullopt;
+    }
+
+    const auto item = std::ranges::partition_point(m_items, [y](const Item& item) {
+        return item.offset + item.height <= static_cast<u32>(y);
+    });
+
+    if (item == m_items.end() or item->offset > static_cast<u32>(y)) {
+        return std::nullopt;
+    }
+
+    return static_cast<u32>(std::distance(m_items.begin(), item));
+}
+
+[[nodiscard]] std::pair<u32, u32> ui::ScrollLayout::items_between(const u32 top, const u32 bottom) const {
+    // the items are sorted by their offset
+    const auto first = std::ranges::partition_point(m_items, [top](const Item& item) {
+        return item.offset + item.height <= top;
+    });
+    const auto last = std::ranges::partition_point(first, m_items.end(), [bottom](const Item& item) {
+        return item.offset <= bottom;
+    });
+
+    return { static_cast<u32>(std::distance(m_items.begin(), first)),
+             static_cast<u32>(std::distance(m_items.begin(), last)) };
+}
+
+[[nodiscard]] bool ui::ScrollLayout::is_focused(const u32 index) const {
+    const auto focusable = as_focusable(m_widgets.at(index).get());
+    return focusable.has_value() and m_focus_id == focusable.value()->focus_id();
+}
+
+void ui::ScrollLayout::insert_item(const u32 index, const ItemSize size, WidgetFactory factory) {
+    if (index > m_items.size()) {
+        throw std::runtime_error{ fmt::format(
+                "Invalid insert into ScrollLayout: index out of bound: {} is not in range [{} - {}]", index, 0,
+                m_items.size()
+        ) };
+    }
+
+    m_items.insert(
+            m_items.begin() + index, Item{ .offset = 0, .height = size.get_height(), .create = std::move(factory) }
+    );
+    m_widgets.insert(m_widgets.begin() + index, nullptr);
+
+    // the new item is outside of the alive range, if it's inserted at its start, that's fine, since it has no widget yet
+    if (index <= m_alive_begin) {
+        ++m_alive_begin;
+        ++m_alive_end;
+    } else if (index < m_alive_end) {
+        ++m_alive_end;
+    }
+    if (m_kept_index.has_value() and m_kept_index.value() >= index) {
+        m_kept_index = m_kept_index.value() + 1;
+    }
+
+    update_offsets(index);
+    recalculate_sizes(static_cast<i32>(m_viewport.top_left.y));
+}
+
+void ui::ScrollLayout::place_widget(const u32 index, std::unique_ptr<Widget> widget) {
+    m_widgets.at(index) = std::move(widget);
+
+    auto focusable = as_focusable(m_widgets.at(index).get());
+    if (focusable.has_value() and not m_focus_id.has_value()) {
+        give_focus(focusable.value());
+    }
+}
+
+void ui::ScrollLayout::update_offsets(const u32 start_index) {
+    u32 offset = 0;
+    if (start_index > 0 and start_index <= m_items.size()) {
+        const auto& previous = m_items.at(start_index - 1);
+        offset = previous.offset + previous.height + gap.get_margin();
+    }
+
+    for (auto index = start_index; index < m_items.size(); ++index) {
+        m_items.at(index).offset = offset;
+        offset += m_items.at(index).height + gap.get_margin();
+    }
+}
+
+void ui::ScrollLayout::update_visible_widgets() {
+    // one viewport height above and below is created in advance, so that moving the focus always finds the next widget
+    const auto margin = main_rect.height();
+    const auto top = m_viewport.top_left.y > margin ? m_viewport.top_left.y - margin : 0;
+    const auto bottom = m_viewport.top_left.y + main_rect.height() + margin;
+
+    // widgets are only destroyed twice as far away, so that scrolling back and forth doesn't recreate them all the time
+    const auto keep_top = m_viewport.top_left.y > 2 * margin ? m_viewport.top_left.y - 2 * margin : 0;
+    const auto keep_bottom = m_viewport.top_left.y + main_rect.height() + 2 * margin;
+
+    const auto [create_begin, create_end] = items_between(top, bottom);
+    const auto [keep_begin, keep_end] = items_between(keep_top, keep_bottom);
+
+    // the new alive range covers the created widgets and the ones of the old range, that are near enough to be kept
+    auto alive_begin = create_begin;
+    auto alive_end = create_end;
+    const auto include = [&alive_begin, &alive_end](const u32 begin, const u32 end) {
+        if (begin >= end) {
+            return;
+        }
+
+        if (alive_begin >= alive_end) {
+            alive_begin = begin;
+            alive_end = end;
+            return;
+        }
+
+        alive_begin = std::min(alive_begin, begin);
+        alive_end = std::max(alive_end, end);
     };
+
+    include(std::max(m_alive_begin, keep_begin), std::min(m_alive_end, keep_end));
+
+    if (m_kept_index.has_value()) {
+        const auto index = m_kept_index.value();
+        if (index >= keep_begin and index < keep_end) {
+            include(index, index + 1);
+            m_kept_index = std::nullopt;
+        } else if (not is_focused(index)) {
+            forget_pointer_target(m_widgets.at(index).get());
+            m_widgets.at(index) = nullptr;
+            m_kept_index = std::nullopt;
+        }
+    }
+
+    // only the items, that left the alive range, have to be destroyed
+    for (auto index = m_alive_begin; index < std::min(m_alive_end, alive_begin); ++index) {
+        destroy_far_widget(index);
+    }
+    for (auto index = std::max(m_alive_begin, alive_end); index < m_alive_end; ++index) {
+        destroy_far_widget(index);
+    }
+
+    m_alive_begin = alive_begin;
+    m_alive_end = alive_end;
+
+    for (auto index = create_begin; index < create_end; ++index) {
+        const auto& item = m_items.at(index);
+        if (m_widgets.at(index) == nullptr and item.create) {
+            place_widget(index, item.create(get_layout_for_new(AbsolutItemSize{ item.height })));
+        }
+    }
+}
+
+void ui::ScrollLayout::destroy_far_widget(const u32 index) {
+    auto& widget = m_widgets.at(index);
+    if (widget == nullptr or not m_items.at(index).create) {
+        return;
+    }
+
+    // the focused widget is kept, so that the focus doesn't get lost while scrolling
+    if (is_focused(index)) {
+        m_kept_index = index;
+        return;
+    }
+
+    forget_pointer_target(widget.get());
+    widget = nullptr;
+}
+
+void ui::ScrollLayout::release_focus(const u32 index) {
+    const auto focusable = as_focusable(m_widgets.at(index).get());
+    if (not focusable.has_value() or m_focus_id != focusable.value()->focus_id()) {
+        return;
+    }
+
+    if (try_set_next_focus(FocusChangeDirection::Forward) or try_set_next_focus(FocusChangeDirection::Backward)) {
+        return;
+    }
+
+    // it was the only focusable widget
+    focusable.value()->unfocus();
+    m_focus_id = std::nullopt;
 }
 
 void ui::ScrollLayout::auto_move_after_focus_change() {
@@ -321,7 +608,7 @@ void ui::ScrollLayout::auto_move_after_focus_change() {
         return;
     }
 
-    const auto total_widgets_height = m_widgets.empty() ? 0 : m_widgets.back()->layout().get_rect().bottom_right.y;
+    const auto total_widgets_height = this->total_widgets_height();
 
     // if we don't need to fill-up the whole main_rect, we need a special viewport, but top position is always 0
     if (total_widgets_height < scrollbar_rect.height()) {
@@ -331,9 +618,7 @@ void ui::ScrollLayout::auto_move_after_focus_change() {
 
     // we center the in focus element (if possible -> not on top or bottom)
 
-    const auto& widget = m_widgets.at(focusable_index_by_id(m_focus_id.value()));
-
-    const auto widget_rect = widget->layout().get_rect();
+    const auto widget_rect = item_rect(focusable_index_by_id(m_focus_id.value()));
 
     // determine if the middle is +- (1 % px) in the viewport middle
     const auto middle_of_rect_y = widget_rect.top_left.y + (widget_rect.height() / 2);
@@ -354,7 +639,16 @@ void ui::ScrollLayout::auto_move_after_focus_change() {
 // it's called desired, since it might not be entirely valid
 void ui::ScrollLayout::recalculate_sizes(i32 desired_scroll_height) {
 
-    const auto total_widgets_height = m_widgets.empty() ? 0 : m_widgets.back()->layout().get_rect().bottom_right.y;
+    const auto total_widgets_height = this->total_widgets_height();
+
+    // the texture only has the size of the viewport, so that it doesn't depend on the number of items
+    if (total_widgets_height == 0) {
+        m_texture = std::nullopt;
+    } else if (not m_texture.has_value()) {
+        m_texture = m_service_provider->renderer().get_texture_for_render_target(
+                shapes::UPoint{ main_rect.width(), main_rect.height() }
+        );
+    }
 
     // if we don't need to fill-up the whole main_rect, we need a special viewport
     if (total_widgets_height < scrollbar_rect.height()) {
@@ -387,4 +681,6 @@ void ui::ScrollLayout::recalculate_sizes(i32 desired_scroll_height) {
 
     scrollbar_mover_rect = shapes::URect{ scrollbar_rect.top_left.x, scrollbar_rect.top_left.y + current_start_height,
                                           scrollbar_rect.width(), current_end_height - current_start_height };
+
+    update_visible_widgets();
 }
@@ -8,6 +8,8 @@
 #include "graphics/renderer.hpp"
 #include "graphics/texture.hpp"
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace ui {
@@ -42,8 +44,27 @@ namespace ui {
 
 
     struct ScrollLayout : public FocusLayout {
+    public:
+        // creates the widget of an item, the layout starts at the top left of the item
+        using WidgetFactory = std::function<std::unique_ptr<Widget>(const Layout& layout)>;
+
     private:
+        struct Item {
+            u32 offset;
+            u32 height;
+            // empty for widgets, that were created immediately, they are never destroyed
+            WidgetFactory create;
+        };
+
         Margin gap;
+        // one item per entry in m_widgets, the widget is nullptr, while the item is far away from the viewport
+        std::vector<Item> m_items;
+        // only the items in [m_alive_begin, m_alive_end) can have created widgets, so scrolling only has to look at the items,
+        // that enter or leave this range, the focused widget is the exception, it's kept alive outside of it at m_kept_index
+        u32 m_alive_begin{ 0 };
+        u32 m_alive_end{ 0 };
+        std::optional<u32> m_kept_index;
+        // only as large as the viewport
         std::optional<Texture> m_texture;
         ServiceProvider* m_service_provider;
         shapes::URect main_rect;
@@ -68,27 +89,29 @@ namespace ui {
         Widget::EventHandleResult
         handle_event(const std::shared_ptr<input::InputManager>& input_manager, const SDL_Event& event) override;
 
+        void update() override;
+
         //TODO(Totto):  with some template paramater and magic make this an option in the base class, so that only get_layout_for_new needs to be overwritten!
+        // the widget is created immediately and kept alive, so get() always works for it
         template<typename T, typename... Args>
         u32 add(ItemSize size, Args... args) {
 
-            const Layout layout = get_layout_for_new(size);
+            const auto index = widget_count();
+            insert_item(index, size, nullptr);
 
-            const auto index = static_cast<u32>(m_widgets.size());
+            place_widget(index, std::make_unique<T>(std::forward<Args>(args)..., get_layout_for_new(size), false));
 
-            m_widgets.push_back(std::move(std::make_unique<T>(std::forward<Args>(args)..., layout, false)));
-            auto focusable = as_focusable(m_widgets.back().get());
-            if (focusable.has_value() and not m_focus_id.has_value()) {
-                give_focus(focusable.value());
-            }
+            return index;
+        }
 
-            const auto total_size = layout.get_rect().bottom_right;
+        // the widget is only created, when the item gets near the viewport, and destroyed again, when it is far away from it
+        // and doesn't have the focus, so lists with thousands of items only need the widgets around the viewport
+        void insert(u32 index, ItemSize size, WidgetFactory factory);
 
-            m_texture = m_service_provider->renderer().get_texture_for_render_target(total_size);
-            recalculate_sizes(0);
+        // the new widget is created immediately, if the old one had the focus, so that it can keep it
+        void replace(u32 index, ItemSize size, WidgetFactory factory);
 
-            return index;
-        }
+        void remove(u32 index);
 
         void clear_widgets();
 
@@ -99,11 +122,33 @@ namespace ui {
         ) override;
 
 
+        [[nodiscard]] std::vector<u32> focusable_ids_sorted() const override;
+
     private:
         [[nodiscard]] Layout get_layout_for_index(u32) override;
 
 
-        [[nodiscard]] Layout get_layout_for_new(ItemSize size);
+        [[nodiscard]] Layout get_layout_for_new(ItemSize size) const;
+
+        [[nodiscard]] u32 total_widgets_height() const;
+        [[nodiscard]] shapes::URect item_rect(u32 index) const;
+        // the distance of the widget coordinates to the screen coordinates
+        [[nodiscard]] shapes::IPoint widget_offset(u32 index) const;
+        // the item at the position on the screen
+        [[nodiscard]] std::optional<u32> item_index_at(const shapes::IPoint& position) const;
+        // the range of items, that overlap the vertical range (in widget coordinates)
+        [[nodiscard]] std::pair<u32, u32> items_between(u32 top, u32 bottom) const;
+        [[nodiscard]] bool is_focused(u32 index) const;
+
+        void insert_item(u32 index, ItemSize size, WidgetFactory factory);
+        void place_widget(u32 index, std::unique_ptr<Widget> widget);
+        void update_offsets(u32 start_index);
+        // creates the widgets near the viewport and destroys the ones far away from it
+        void update_visible_widgets();
+        // destroys the widget of a lazy item, except if it has the focus, then it is kept
+        void destroy_far_widget(u32 index);
+        // moves the focus away from the widget, before it is destroyed
+        void release_focus(u32 index);
 
         void auto_move_after_focus_change();
 
@@ -4,7 +4,7 @@
 
 void ui::TileLayout::render(const ServiceProvider& service_provider) const {
     for (const auto& widget : m_widgets) {
-        widget->render(service_provider);
+        render_profiled(*widget, service_provider);
     }
 }
 
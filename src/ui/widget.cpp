@@ -1,6 +1,7 @@
 
 #include <core/helper/utils.hpp>
 
+#include "helper/profiler.hpp"
 #include "widget.hpp"
 
 
@@ -11,3 +12,8 @@
 [[nodiscard]] std::optional<ui::Hoverable*> ui::as_hoverable(ui::Widget* const widget) {
     return utils::is_child_class<ui::Hoverable>(widget);
 }
+
+void ui::render_profiled(const ui::Widget& widget, const ServiceProvider& service_provider) {
+    const helper::profiler::Zone zone{ typeid(widget), "::render" };
+    widget.render(service_provider);
+}
@@ -63,5 +63,8 @@ namespace ui {
 
     [[nodiscard]] std::optional<Hoverable*> as_hoverable(Widget* widget);
 
+    // containers render their children with this, so that every widget gets its own profiler zone
+    void render_profiled(const Widget& widget, const ServiceProvider& service_provider);
+
 
 } // namespace ui
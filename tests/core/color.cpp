@@ -304,3 +304,114 @@ TEST(ColorConversion, RGGtoHSVtoRGB) {
 #endif
 }
 }
+
+namespace {
+
+    // an odd size, so that the scalar tail of the batch conversion is also tested
+    constexpr usize batch_size = 1021;
+
+    // the batch conversion has to be bit-exact with the conversion of single colors
+    void check_batch_to_rgb(const std::vector<HSVColor>& colors) {
+        std::vector<Color> result(colors.size());
+        color::to_rgb_colors(colors, result);
+
+        for (usize i = 0; i < colors.size(); ++i) {
+            ASSERT_EQ(colors[i].to_rgb_color(), result[i]) << "Original color: " << colors[i].to_string();
+        }
+    }
+
+    void check_batch_to_hsv(const std::vector<Color>& colors) {
+        std::vector<HSVColor> result(colors.size());
+        color::to_hsv_colors(colors, result);
+
+        for (usize i = 0; i < colors.size(); ++i) {
+            const auto expected = colors[i].to_hsv_color();
+            ASSERT_EQ(expected.h, result[i].h) << "Original color: " << colors[i].to_string();
+            ASSERT_EQ(expected.s, result[i].s) << "Original color: " << colors[i].to_string();
+            ASSERT_EQ(expected.v, result[i].v) << "Original color: " << colors[i].to_string();
+            ASSERT_EQ(expected.a, result[i].a) << "Original color: " << colors[i].to_string();
+        }
+    }
+
+} // namespace
+
+
+TEST(ColorConversion, BatchHSVtoRGB) {
+
+#if COLOR_TEST_MODE == 0
+    const std::vector<HSVColor> colors{
+        HSVColor{     2,  0.3,  0.6 },
+        HSVColor{    82,  0.3,  0.6 },
+        HSVColor{   142,  0.3,  0.6 },
+        HSVColor{   192,  0.3,  0.6 },
+        HSVColor{   252,  0.3,  0.6 },
+        HSVColor{   312,  0.3,  0.6 },
+        HSVColor{     0,  0.0,  0.0 },
+        HSVColor{    60,  1.0,  1.0 },
+        HSVColor{ 359.9,  1.0,  0.5 },
+        HSVColor{   360,  1.0,  1.0 },
+        HSVColor{ 120.5, 0.25, 0.75, 0x12 },
+    };
+
+    ASSERT_NO_FATAL_FAILURE(check_batch_to_rgb(colors));
+#else
+#if COLOR_TEST_MODE == 1
+    constexpr const auto step_amount = 1000; // arbitrary number, to make it kinda exhaustive
+#else
+    constexpr const auto step_amount = COLOR_TEST_MODE;
+#endif
+
+    std::vector<HSVColor> colors{};
+    colors.reserve(batch_size);
+
+    for (double h = 0.0; h < 360.0; h += 360.0 / step_amount) {
+        for (double s = 0.0; s < 1.0; s += 1.0 / step_amount) {
+            for (double v = 0.0; v < 1.0; v += 1.0 / step_amount) {
+                colors.emplace_back(h, s, v);
+
+                if (colors.size() == batch_size) {
+                    ASSERT_NO_FATAL_FAILURE(check_batch_to_rgb(colors));
+                    colors.clear();
+                }
+            }
+        }
+    }
+
+    ASSERT_NO_FATAL_FAILURE(check_batch_to_rgb(colors));
+#endif
+}
+
+
+TEST(ColorConversion, BatchRGBtoHSV) {
+
+#if COLOR_TEST_MODE == 0
+    const std::vector<Color> colors{
+        Color{   0,   0,   0 },
+        Color{ 180, 135, 223 },
+        Color{  12,  34, 130 },
+        Color{  79,  85,  20 },
+        Color{ 155, 174,   2 },
+        Color{ 243,  32,  34 },
+        Color{ 255, 255, 255 },
+        Color{ 255,   0, 128 },
+        Color{ 128, 128, 128, 0x12 },
+    };
+
+    ASSERT_NO_FATAL_FAILURE(check_batch_to_hsv(colors));
+#else
+    std::vector<Color> colors{};
+    colors.reserve(batch_size);
+
+    // this is cheap enough, to always be exhaustive
+    foreach_loop([&colors](u8 red, u8 green, u8 blue) {
+        colors.emplace_back(red, green, blue);
+
+        if (colors.size() == batch_size and not ::testing::Test::HasFatalFailure()) {
+            check_batch_to_hsv(colors);
+            colors.clear();
+        }
+    });
+
+    ASSERT_NO_FATAL_FAILURE(check_batch_to_hsv(colors));
+#endif
+}
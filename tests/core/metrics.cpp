@@ -0,0 +1,81 @@
+#include <core/helper/metrics.hpp>
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+TEST(Metrics, CounterIsSharedByName) {
+    metrics::Registry registry{};
+
+    auto& counter = registry.counter("test_total", "help");
+    counter.add();
+    registry.counter("test_total", "help").add(2);
+
+    ASSERT_EQ(counter.value(), 3);
+}
+
+TEST(Metrics, DifferentTypeWithSameNameThrows) {
+    metrics::Registry registry{};
+
+    std::ignore = registry.counter("test", "help");
+
+    ASSERT_THROW(std::ignore = registry.histogram("test", "help", { 1.0 }), std::runtime_error);
+}
+
+TEST(Metrics, CounterFromMultipleThreads) {
+    metrics::Registry registry{};
+    auto& counter = registry.counter("test_total", "help");
+
+    constexpr u64 increments = 10000;
+
+    std::vector<std::thread> threads{};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter] {
+            for (u64 j = 0; j < increments; ++j) {
+                counter.add();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.value(), 4 * increments);
+}
+
+TEST(Metrics, HistogramBuckets) {
+    metrics::Registry registry{};
+    auto& histogram = registry.histogram("test", "help", { 1.0, 2.0 });
+
+    histogram.observe(0.5);
+    histogram.observe(1.0);
+    histogram.observe(1.5);
+    histogram.observe(10.0);
+
+    ASSERT_EQ(histogram.bucket_counts(), (std::vector<u64>{ 2, 1, 1 }));
+    ASSERT_DOUBLE_EQ(histogram.sum(), 13.0);
+}
+
+TEST(Metrics, PrometheusTextFormat) {
+    metrics::Registry registry{};
+    registry.counter("test_total", "a counter").add(5);
+    auto& histogram = registry.histogram("test_seconds", "a histogram", { 0.5, 1.0 });
+    histogram.observe(0.25);
+    histogram.observe(2.0);
+
+    const auto expected = "# HELP test_seconds a histogram\n"
+                          "# TYPE test_seconds histogram\n"
+                          "test_seconds_bucket{le=\"0.5\"} 1\n"
+                          "test_seconds_bucket{le=\"1\"} 1\n"
+                          "test_seconds_bucket{le=\"+Inf\"} 2\n"
+                          "test_seconds_sum 2.25\n"
+                          "test_seconds_count 2\n"
+                          "# HELP test_total a counter\n"
+                          "# TYPE test_total counter\n"
+                          "test_total 5\n";
+
+    ASSERT_EQ(registry.to_prometheus_text(), expected);
+}
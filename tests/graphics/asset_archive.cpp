@@ -0,0 +1,108 @@
+#include "helper/asset_archive_format.hpp"
+#include "helper/asset_archive_index.hpp"
+
+#include <gtest/gtest.h>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    // packs the entries like the asset packer, every file consists of its path, repeated to its size
+    std::vector<std::byte> pack(std::vector<asset_archive::IndexEntry>& entries) {
+        std::ostringstream stream{};
+        asset_archive::write_index(stream, entries);
+
+        for (const auto& entry : entries) {
+            stream << std::string(entry.offset - static_cast<u64>(stream.tellp()), '\0');
+            for (u64 i = 0; i < entry.size; ++i) {
+                stream << entry.path.at(i % entry.path.size());
+            }
+        }
+
+        const auto content = stream.str();
+        const auto* const data =
+                reinterpret_cast<const std::byte*>(content.data()); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return { data, data + content.size() };
+    }
+
+    std::vector<asset_archive::IndexEntry> example_entries() {
+        return {
+            { .path = "fonts/default.ttf", .size = 100, .offset = 0 },
+            { .path = "images/empty.png", .size = 0, .offset = 0 },
+            { .path = "mappings/keyboard.json", .size = 17, .offset = 0 },
+        };
+    }
+
+} // namespace
+
+
+TEST(AssetArchive, ParsesWhatThePackerWrites) {
+    auto entries = example_entries();
+    const auto bytes = pack(entries);
+
+    const auto index_size = asset_archive::parse_header(bytes);
+    ASSERT_TRUE(index_size.has_value());
+
+    const auto index = asset_archive::parse_index(
+            std::span{ bytes }.first(asset_archive::header_size + index_size.value()), bytes.size()
+    );
+    ASSERT_TRUE(index.has_value());
+    ASSERT_EQ(index->size(), entries.size());
+
+    for (const auto& entry : entries) {
+        ASSERT_EQ(entry.offset % asset_archive::data_alignment, 0U);
+
+        const auto parsed = index->find(entry.path);
+        ASSERT_NE(parsed, index->end());
+        EXPECT_EQ(parsed->second.offset, entry.offset);
+        EXPECT_EQ(parsed->second.size, entry.size);
+
+        for (u64 i = 0; i < entry.size; ++i) {
+            ASSERT_EQ(static_cast<char>(bytes.at(entry.offset + i)), entry.path.at(i % entry.path.size()));
+        }
+    }
+}
+
+TEST(AssetArchive, RejectsATruncatedIndex) {
+    auto entries = example_entries();
+    const auto bytes = pack(entries);
+
+    const auto index_size = asset_archive::parse_header(bytes);
+    ASSERT_TRUE(index_size.has_value());
+    const auto index_end = asset_archive::header_size + index_size.value();
+
+    // every cut, also the ones in the middle of the offset and size of an entry, is an error and never reads past the bytes
+    for (usize size = asset_archive::header_size; size < index_end; ++size) {
+        const auto index = asset_archive::parse_index(std::span{ bytes }.first(size), bytes.size());
+        ASSERT_FALSE(index.has_value()) << "size " << size;
+    }
+}
+
+TEST(AssetArchive, RejectsEntriesOutsideOfTheFile) {
+    auto entries = example_entries();
+    const auto bytes = pack(entries);
+
+    const auto index_size = asset_archive::parse_header(bytes);
+    ASSERT_TRUE(index_size.has_value());
+
+    const auto index = asset_archive::parse_index(
+            std::span{ bytes }.first(asset_archive::header_size + index_size.value()), bytes.size() - 1
+    );
+    ASSERT_FALSE(index.has_value());
+}
+
+TEST(AssetArchive, RejectsAnInvalidHeader) {
+    auto entries = example_entries();
+    auto bytes = pack(entries);
+
+    ASSERT_FALSE(asset_archive::parse_header(std::span{ bytes }.first(asset_archive::header_size - 1)).has_value());
+
+    bytes.at(asset_archive::magic.size()) = std::byte{ asset_archive::version + 1 };
+    ASSERT_FALSE(asset_archive::parse_header(bytes).has_value());
+
+    bytes.at(0) = std::byte{ 'X' };
+    ASSERT_FALSE(asset_archive::parse_header(bytes).has_value());
+}
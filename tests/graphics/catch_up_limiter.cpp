@@ -0,0 +1,56 @@
+#include "game/catch_up_limiter.hpp"
+
+#include <gtest/gtest.h>
+
+
+TEST(CatchUpLimiter, SimulatesEverythingWithinTheBudget) {
+    CatchUpLimiter limiter{ 8, CatchUpPolicy::Spread };
+
+    const auto result = limiter.limit(10, 18);
+    ASSERT_EQ(result.steps, 8);
+    ASSERT_EQ(result.late, 0);
+    ASSERT_EQ(result.dropped, 0);
+
+    ASSERT_EQ(limiter.limit(18, 18).steps, 0);
+}
+
+TEST(CatchUpLimiter, NoLimit) {
+    CatchUpLimiter limiter{ 0, CatchUpPolicy::Shift };
+
+    const auto result = limiter.limit(0, 1000);
+    ASSERT_EQ(result.steps, 1000);
+    ASSERT_EQ(result.dropped, 0);
+}
+
+TEST(CatchUpLimiter, SpreadCountsEveryLateStepOnce) {
+    CatchUpLimiter limiter{ 8, CatchUpPolicy::Spread };
+
+    auto result = limiter.limit(0, 20);
+    ASSERT_EQ(result.steps, 8);
+    ASSERT_EQ(result.late, 12);
+
+    // one new step arrived, the backlog was already counted
+    result = limiter.limit(8, 21);
+    ASSERT_EQ(result.steps, 8);
+    ASSERT_EQ(result.late, 1);
+
+    result = limiter.limit(16, 22);
+    ASSERT_EQ(result.steps, 6);
+    ASSERT_EQ(result.late, 0);
+    ASSERT_EQ(result.dropped, 0);
+}
+
+TEST(CatchUpLimiter, ShiftDropsTheBacklog) {
+    CatchUpLimiter limiter{ 8, CatchUpPolicy::Shift };
+
+    auto result = limiter.limit(0, 100);
+    ASSERT_EQ(result.steps, 8);
+    ASSERT_EQ(result.dropped, 92);
+    ASSERT_EQ(result.late, 0);
+
+    // the clock continues, where the game stalled
+    ASSERT_EQ(limiter.target_step_index(101), 9);
+    result = limiter.limit(8, 101);
+    ASSERT_EQ(result.steps, 1);
+    ASSERT_EQ(result.dropped, 0);
+}
@@ -0,0 +1,167 @@
+#include "helper/clock_source.hpp"
+
+#include <gtest/gtest.h>
+#include <tuple>
+
+
+namespace {
+
+    // the time of the clocks under test, it only passes, when the test advances it
+    struct FakeTime {
+        std::chrono::steady_clock::time_point now{};
+
+        void advance(std::chrono::nanoseconds duration) {
+            now += duration;
+        }
+
+        [[nodiscard]] TimeSource source() {
+            return [this] { return now; };
+        }
+    };
+
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+    using std::chrono::seconds;
+
+} // namespace
+
+
+TEST(ManualClock, OnlyAdvancesWhenStepped) {
+    ManualClock clock{};
+
+    ASSERT_EQ(clock.simulation_step_index(), 0);
+
+    clock.advance();
+    clock.advance(9);
+
+    ASSERT_EQ(clock.simulation_step_index(), 10);
+}
+
+TEST(ManualClock, DoesNotAdvanceWhilePaused) {
+    ManualClock clock{};
+    clock.advance(5);
+
+    clock.pause();
+    clock.advance(100);
+    ASSERT_EQ(clock.simulation_step_index(), 5);
+
+    ASSERT_EQ(clock.resume(), 0.0);
+    clock.advance(1);
+    ASSERT_EQ(clock.simulation_step_index(), 6);
+}
+
+TEST(ManualClock, PauseAndResumeHaveToAlternate) {
+    ManualClock clock{};
+
+    ASSERT_THROW(std::ignore = clock.resume(), std::runtime_error);
+
+    clock.pause();
+    ASSERT_THROW(clock.pause(), std::runtime_error);
+}
+
+TEST(HighResolutionClock, IsFrozenWhilePaused) {
+    FakeTime time{};
+    HighResolutionClock clock{ 1000, time.source() };
+
+    time.advance(milliseconds{ 5 });
+    clock.pause();
+    time.advance(milliseconds{ 20 });
+    ASSERT_EQ(clock.simulation_step_index(), 5);
+
+    // the pause is subtracted, so the clock continues where it was paused
+    ASSERT_DOUBLE_EQ(clock.resume(), 0.02);
+    ASSERT_EQ(clock.simulation_step_index(), 5);
+
+    time.advance(milliseconds{ 3 });
+    ASSERT_EQ(clock.simulation_step_index(), 8);
+}
+
+TEST(HighResolutionClock, Advances) {
+    FakeTime time{};
+    HighResolutionClock clock{ 1000, time.source() };
+
+    ASSERT_EQ(clock.simulation_step_index(), 0);
+
+    time.advance(milliseconds{ 20 });
+    ASSERT_EQ(clock.simulation_step_index(), 20);
+
+    // a step only begins, when its whole duration has passed
+    time.advance(milliseconds{ 1 } - nanoseconds{ 1 });
+    ASSERT_EQ(clock.simulation_step_index(), 20);
+    time.advance(nanoseconds{ 1 });
+    ASSERT_EQ(clock.simulation_step_index(), 21);
+}
+
+TEST(HighResolutionClock, DoesNotDriftInLongSessions) {
+    FakeTime time{};
+    HighResolutionClock clock{ 60, time.source() };
+
+    // a step at 60 Hz isn't a whole number of milliseconds or nanoseconds
+    time.advance(std::chrono::hours{ 24 * 100 });
+    ASSERT_EQ(clock.simulation_step_index(), 60ULL * 60 * 60 * 24 * 100);
+}
+
+TEST(HighResolutionClock, LooksBackInTime) {
+    FakeTime time{};
+    HighResolutionClock clock{ 1000, time.source() };
+
+    time.advance(milliseconds{ 20 });
+    ASSERT_EQ(clock.simulation_step_index_before(milliseconds{ 10 }), 10);
+
+    clock.pause();
+    time.advance(milliseconds{ 50 });
+    ASSERT_EQ(clock.simulation_step_index_before(milliseconds{ 10 }), 10);
+    ASSERT_EQ(clock.simulation_step_index_before(seconds{ 10 }), 0);
+}
+
+TEST(ManualClock, IgnoresTheAgeOfEvents) {
+    ManualClock clock{};
+    clock.advance(5);
+
+    ASSERT_EQ(clock.simulation_step_index_before(std::chrono::seconds{ 1 }), 5);
+}
+
+TEST(ScaledClock, RunsFasterThanRealTime) {
+    FakeTime time{};
+    ScaledClock clock{ 1000, 10.0, time.source() };
+
+    time.advance(milliseconds{ 20 });
+    ASSERT_EQ(clock.simulation_step_index(), 200);
+}
+
+TEST(ScaledClock, ChangingTheSpeedDoesNotJump) {
+    FakeTime time{};
+    ScaledClock clock{ 1000, 10.0, time.source() };
+
+    time.advance(milliseconds{ 20 });
+    clock.set_speed(0.1);
+    ASSERT_EQ(clock.simulation_step_index(), 200);
+    ASSERT_EQ(clock.speed(), 0.1);
+
+    time.advance(milliseconds{ 100 });
+    ASSERT_EQ(clock.simulation_step_index(), 210);
+
+    // looking back before the speed change returns the step of the change
+    ASSERT_EQ(clock.simulation_step_index_before(seconds{ 1 }), 200);
+}
+
+TEST(ScaledClock, IsFrozenWhilePaused) {
+    FakeTime time{};
+    ScaledClock clock{ 1000, 10.0, time.source() };
+
+    time.advance(milliseconds{ 10 });
+    clock.pause();
+    time.advance(milliseconds{ 100 });
+    ASSERT_EQ(clock.simulation_step_index(), 100);
+
+    ASSERT_DOUBLE_EQ(clock.resume(), 0.1);
+    time.advance(milliseconds{ 10 });
+    ASSERT_EQ(clock.simulation_step_index(), 200);
+}
+
+TEST(ScaledClock, RejectsInvalidSpeeds) {
+    ASSERT_THROW(ScaledClock(60, 0.0), std::invalid_argument);
+
+    ScaledClock clock{ 60, 1.0 };
+    ASSERT_THROW(clock.set_speed(-1.0), std::invalid_argument);
+}
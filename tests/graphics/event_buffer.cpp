@@ -0,0 +1,73 @@
+#include "input/event_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+    [[nodiscard]] SDL_Event key_event(u32 timestamp) {
+        SDL_Event event{};
+        event.type = SDL_KEYDOWN;
+        event.key.timestamp = timestamp;
+        return event;
+    }
+
+    // one step per 10 milliseconds, the current step is 100
+    [[nodiscard]] SimulationStep map_age(std::chrono::nanoseconds age) {
+        const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(age).count();
+        return 100 - static_cast<SimulationStep>(milliseconds / 10);
+    }
+
+} // namespace
+
+
+TEST(EventBuffer, WithoutMapperAllEventsAreTaken) {
+    input::EventBuffer buffer{};
+    buffer.push(key_event(10));
+    buffer.push(key_event(20));
+
+    ASSERT_EQ(buffer.take(1, nullptr).size(), 2);
+    ASSERT_TRUE(buffer.take(1, nullptr).empty());
+}
+
+TEST(EventBuffer, EventsAreTakenAtTheirStep) {
+    input::EventBuffer buffer{};
+
+    const auto now = SDL_GetTicks();
+    buffer.push(key_event(now - 25));
+    buffer.push(key_event(now - 15));
+    buffer.push(key_event(now - 5));
+
+    ASSERT_TRUE(buffer.take(97, map_age).empty());
+
+    auto events = buffer.take(98, map_age);
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events.at(0).common.timestamp, now - 25);
+
+    events = buffer.take(100, map_age);
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_EQ(events.at(0).common.timestamp, now - 15);
+    ASSERT_EQ(events.at(1).common.timestamp, now - 5);
+}
+
+TEST(EventBuffer, SubscribedBufferTakesEventsFromTheQueue) {
+    auto subscription = std::make_shared<input::InputSubscription>();
+    input::EventBuffer buffer{ subscription };
+
+    // events from the event dispatcher are ignored, since the same ones come from the input thread
+    buffer.push(key_event(10));
+    ASSERT_TRUE(buffer.take(100, map_age).empty());
+
+    const auto now = std::chrono::steady_clock::now();
+    ASSERT_TRUE(subscription->queue.try_push(
+            input::TimedEvent{ .event = key_event(20), .received_at = now - std::chrono::milliseconds{ 35 } }
+    ));
+    ASSERT_TRUE(subscription->queue.try_push(input::TimedEvent{ .event = key_event(30), .received_at = now }));
+
+    auto events = buffer.take(97, map_age);
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events.at(0).common.timestamp, 20);
+
+    events = buffer.take(100, map_age);
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events.at(0).common.timestamp, 30);
+}
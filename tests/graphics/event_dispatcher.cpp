@@ -0,0 +1,142 @@
+#include "manager/event_dispatcher.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+    struct RecordingListener final : public EventListener {
+        std::vector<u32> event_types;
+
+        void handle_event(const SDL_Event& event) override {
+            event_types.push_back(event.type);
+        }
+    };
+
+    void push_event(u32 type, SDL_KeyCode key = SDLK_a) {
+        SDL_Event event{};
+        event.type = type;
+        event.key.keysym.sym = key;
+        ASSERT_EQ(SDL_PushEvent(&event), 1) << SDL_GetError();
+    }
+
+    // the input thread is woken by the pushed events, this only waits, until it took them out of the SDL queue
+    void wait_for_input_thread() {
+        const auto pending_key_events = [] {
+            return SDL_PeepEvents(nullptr, 0, SDL_PEEKEVENT, SDL_KEYDOWN, SDL_KEYUP);
+        };
+
+        for (int i = 0; i < 1000 and pending_key_events() > 0; ++i) {
+            SDL_Delay(1);
+        }
+        ASSERT_EQ(pending_key_events(), 0);
+    }
+
+} // namespace
+
+
+TEST(EventDispatcher, ClassifiesEvents) {
+    SDL_Event event{};
+
+    event.type = SDL_FINGERDOWN;
+    EXPECT_EQ(get_event_category(event), EventCategory::Pointer);
+    event.type = SDL_KEYUP;
+    EXPECT_EQ(get_event_category(event), EventCategory::Key);
+    event.type = SDL_TEXTEDITING;
+    EXPECT_EQ(get_event_category(event), EventCategory::Text);
+    event.type = SDL_CONTROLLERBUTTONDOWN;
+    EXPECT_EQ(get_event_category(event), EventCategory::Controller);
+    event.type = SDL_QUIT;
+    EXPECT_EQ(get_event_category(event), EventCategory::Window);
+    event.type = SDL_USEREVENT;
+    EXPECT_EQ(get_event_category(event), EventCategory::Other);
+}
+
+TEST(EventDispatcher, RoutesEventsOnlyToTheSubscribedCategories) {
+    ASSERT_EQ(SDL_InitSubSystem(SDL_INIT_EVENTS), 0) << SDL_GetError();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    EventDispatcher dispatcher{};
+    RecordingListener all{};
+    RecordingListener keys{};
+    RecordingListener pointer_and_text{};
+
+    dispatcher.register_listener(&all);
+    dispatcher.register_listener(&keys, { EventCategory::Key });
+    dispatcher.register_listener(&pointer_and_text, { EventCategory::Pointer, EventCategory::Text });
+
+    push_event(SDL_KEYDOWN);
+    push_event(SDL_MOUSEMOTION);
+    push_event(SDL_TEXTINPUT);
+    push_event(SDL_JOYBUTTONDOWN);
+    dispatcher.dispatch_pending_events();
+
+    EXPECT_EQ(all.event_types, (std::vector<u32>{ SDL_KEYDOWN, SDL_MOUSEMOTION, SDL_TEXTINPUT, SDL_JOYBUTTONDOWN }));
+    EXPECT_EQ(keys.event_types, std::vector<u32>{ SDL_KEYDOWN });
+    EXPECT_EQ(pointer_and_text.event_types, (std::vector<u32>{ SDL_MOUSEMOTION, SDL_TEXTINPUT }));
+
+    dispatcher.unregister_listener(&keys);
+    push_event(SDL_KEYUP);
+    dispatcher.dispatch_pending_events();
+
+    EXPECT_EQ(keys.event_types.size(), 1);
+    EXPECT_EQ(all.event_types.size(), 5);
+
+    SDL_QuitSubSystem(SDL_INIT_EVENTS);
+}
+
+TEST(EventDispatcher, MergesTheEventsOfTheInputThreadByTimestamp) {
+    ASSERT_EQ(SDL_InitSubSystem(SDL_INIT_EVENTS), 0) << SDL_GetError();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    {
+        EventDispatcher dispatcher{};
+        dispatcher.start_input_thread();
+        RecordingListener all{};
+        dispatcher.register_listener(&all);
+
+        // SDL timestamps only have a resolution of milliseconds
+        push_event(SDL_KEYDOWN);
+        SDL_Delay(2);
+        push_event(SDL_MOUSEMOTION);
+        SDL_Delay(2);
+        push_event(SDL_KEYUP);
+        wait_for_input_thread();
+
+        dispatcher.dispatch_pending_events();
+        EXPECT_EQ(all.event_types, (std::vector<u32>{ SDL_KEYDOWN, SDL_MOUSEMOTION, SDL_KEYUP }));
+    }
+
+    SDL_QuitSubSystem(SDL_INIT_EVENTS);
+}
+
+TEST(EventDispatcher, InputThreadOnlyPushesEventsTheDispatcherWouldDispatch) {
+    ASSERT_EQ(SDL_InitSubSystem(SDL_INIT_EVENTS), 0) << SDL_GetError();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    {
+        EventDispatcher dispatcher{};
+        dispatcher.start_input_thread();
+        const auto subscription = dispatcher.subscribe_to_input_thread(EventCategory::Key);
+        ASSERT_NE(subscription, nullptr);
+
+        dispatcher.disable();
+        push_event(SDL_KEYDOWN, SDLK_LEFT);
+        wait_for_input_thread();
+        EXPECT_FALSE(subscription->queue.try_pop().has_value());
+        dispatcher.enable();
+
+        // while typing, only the keys for navigating and editing are passed on
+        dispatcher.start_text_input(std::nullopt);
+        push_event(SDL_KEYDOWN, SDLK_a);
+        push_event(SDL_KEYDOWN, SDLK_RETURN);
+        wait_for_input_thread();
+
+        const auto event = subscription->queue.try_pop();
+        ASSERT_TRUE(event.has_value());
+        EXPECT_EQ(event->event.key.keysym.sym, SDLK_RETURN);
+        EXPECT_FALSE(subscription->queue.try_pop().has_value());
+        dispatcher.stop_text_input();
+    }
+
+    SDL_QuitSubSystem(SDL_INIT_EVENTS);
+}
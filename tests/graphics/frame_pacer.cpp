@@ -0,0 +1,129 @@
+#include "helper/frame_pacer.hpp"
+
+#include <gtest/gtest.h>
+
+
+namespace {
+
+    using namespace std::chrono_literals;
+
+    // the time of the pacer, it only passes, when the pacer reads it or sleeps, or when a frame does some work
+    struct FakeTime {
+        std::chrono::steady_clock::time_point now{};
+        // every sleep takes this much longer than requested
+        std::chrono::nanoseconds oversleep;
+
+        explicit FakeTime(std::chrono::nanoseconds oversleep) : oversleep{ oversleep } { }
+
+        // reading the time takes a moment, like with the real clock, so that spinning until the deadline ends
+        [[nodiscard]] TimeSource source() {
+            return [this] {
+                now += 1us;
+                return now;
+            };
+        }
+
+        [[nodiscard]] helper::FramePacer::Sleep sleep() {
+            return [this](std::chrono::nanoseconds duration) {
+                now += duration + oversleep;
+                return true;
+            };
+        }
+    };
+
+    constexpr u32 framerate = 60;
+    constexpr auto frame_duration = std::chrono::nanoseconds{ 1s } / framerate;
+    constexpr auto work_per_frame = 5ms;
+    // the pacer may read the time a few times after the deadline
+    constexpr auto tolerance = 10us;
+
+} // namespace
+
+
+TEST(FramePacer, KeepsTheDeadlinesWithoutDrift) {
+    FakeTime time{ 200us };
+    helper::FramePacer pacer{ framerate, time.source(), time.sleep() };
+    const auto start = time.now;
+
+    for (i64 frame = 1; frame <= 600; ++frame) {
+        time.now += work_per_frame;
+        pacer.wait_for_next_frame();
+
+        // the deadlines are absolute, so that being a bit late doesn't delay all later frames
+        const auto deadline = start + (frame * frame_duration);
+        ASSERT_GE(time.now, deadline) << "frame " << frame;
+        ASSERT_LT(time.now, deadline + tolerance) << "frame " << frame;
+    }
+
+    const auto statistics = pacer.statistics();
+    ASSERT_EQ(statistics.frame_count, 600);
+    ASSERT_NEAR(statistics.average_frame_time.count(), frame_duration.count(), tolerance.count());
+}
+
+TEST(FramePacer, AdaptsToTheSleepOvershoot) {
+    FakeTime time{ 3ms };
+    helper::FramePacer pacer{ framerate, time.source(), time.sleep() };
+    const auto start = time.now;
+
+    // the initial guess is lower than the real overshoot, so the first frame is late
+    ASSERT_EQ(pacer.statistics().sleep_overshoot, 1ms);
+    time.now += work_per_frame;
+    pacer.wait_for_next_frame();
+    ASSERT_GT(time.now, start + frame_duration + 1ms);
+
+    for (i64 frame = 2; frame <= 100; ++frame) {
+        time.now += work_per_frame;
+        pacer.wait_for_next_frame();
+    }
+
+    // the estimate converges to the overshoot from above, it includes the reading of the time after the sleep
+    const auto overshoot = pacer.statistics().sleep_overshoot;
+    ASSERT_GE(overshoot, 3ms + 1us);
+    ASSERT_LT(overshoot, 3ms + 50us);
+
+    for (i64 frame = 101; frame <= 110; ++frame) {
+        time.now += work_per_frame;
+        pacer.wait_for_next_frame();
+
+        const auto deadline = start + (frame * frame_duration);
+        ASSERT_GE(time.now, deadline) << "frame " << frame;
+        ASSERT_LT(time.now, deadline + tolerance) << "frame " << frame;
+    }
+}
+
+TEST(FramePacer, StartsANewScheduleAfterAStall) {
+    FakeTime time{ 200us };
+    helper::FramePacer pacer{ framerate, time.source(), time.sleep() };
+
+    for (int frame = 0; frame < 10; ++frame) {
+        pacer.wait_for_next_frame();
+    }
+
+    // no burst of frames to catch up, the next frame is presented right away and the schedule starts from there
+    time.now += frame_duration * 10;
+    const auto stall_end = time.now;
+    pacer.wait_for_next_frame();
+    ASSERT_LT(time.now, stall_end + tolerance);
+
+    const auto new_start = time.now;
+    pacer.wait_for_next_frame();
+    ASSERT_GE(time.now, new_start + frame_duration - tolerance);
+    ASSERT_LT(time.now, new_start + frame_duration + tolerance);
+
+    ASSERT_GE(pacer.statistics().max_deviation, frame_duration * 9);
+}
+
+TEST(FramePacer, OnlyMeasuresWithoutATarget) {
+    FakeTime time{ 200us };
+    helper::FramePacer pacer{ std::nullopt, time.source(), time.sleep() };
+
+    for (int frame = 0; frame < 10; ++frame) {
+        time.now += work_per_frame;
+        pacer.wait_for_next_frame();
+    }
+
+    const auto statistics = pacer.statistics();
+    ASSERT_EQ(statistics.frame_count, 10);
+    ASSERT_NEAR(statistics.average_frame_time.count(), std::chrono::nanoseconds{ work_per_frame }.count(), 2'000);
+    ASSERT_LT(statistics.jitter, 1us);
+}
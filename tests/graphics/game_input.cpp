@@ -0,0 +1,158 @@
+#include "game/simulated_tetrion.hpp"
+#include "input/game_input.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+    constexpr input::AutoShiftTimings timings{ .delayed_auto_shift_frames = 10, .auto_repeat_rate_frames = 2 };
+
+    // the auto shift is handled by the base class, so this only passes the events on, like the real inputs do
+    struct ScriptedInput final : public input::GameInput {
+        ScriptedInput() : input::GameInput{ input::GameInputType::Keyboard } { }
+
+        void apply(InputEvent event, SimulationStep simulation_step_index) {
+            handle_event(event, simulation_step_index);
+        }
+
+        [[nodiscard]] std::optional<input::MenuEvent> get_menu_event(const SDL_Event& /*event*/) const override {
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::string describe_menu_event(input::MenuEvent /*event*/) const override {
+            return "";
+        }
+
+        [[nodiscard]] const input::Input* underlying_input() const override {
+            return nullptr;
+        }
+    };
+
+    // the x position of the leftmost mino of the active tetromino
+    int leftmost_x(const SimulatedTetrion& tetrion) {
+        SimulatedTetrion::RenderSnapshot snapshot{};
+        tetrion.write_render_snapshot(snapshot);
+        const auto& minos = snapshot.active_tetromino->minos();
+        return static_cast<int>(
+                std::ranges::min_element(minos, {}, [](const Mino& mino) { return mino.position().x; })->position().x
+        );
+    }
+
+    // an I tetromino, lying flat with its minos at x 3 to 6, so that it can move 3 to the left and to the right
+    struct GameInputTest : public ::testing::Test {
+        SimulatedTetrion tetrion{ 0, 42, 0, nullptr, std::nullopt };
+        ScriptedInput input{};
+
+        void SetUp() override {
+            tetrion.spawn_next_tetromino(helper::TetrominoType::I, 0);
+            input.set_target_tetrion(&tetrion);
+            input.set_auto_shift_timings(timings);
+            ASSERT_EQ(leftmost_x(tetrion), 3);
+        }
+
+        // applies the events of the step and updates the input, like the game loop does
+        void step(SimulationStep simulation_step_index, const std::vector<InputEvent>& events = {}) {
+            for (const auto event : events) {
+                input.apply(event, simulation_step_index);
+            }
+            input.update(simulation_step_index);
+        }
+
+        // the steps in the given range, in which the tetromino moved
+        std::vector<SimulationStep> moves_until(SimulationStep first, SimulationStep last) {
+            std::vector<SimulationStep> result{};
+            for (auto simulation_step_index = first; simulation_step_index <= last; ++simulation_step_index) {
+                const auto before = leftmost_x(tetrion);
+                step(simulation_step_index);
+                if (leftmost_x(tetrion) != before) {
+                    result.push_back(simulation_step_index);
+                }
+            }
+            return result;
+        }
+    };
+
+} // namespace
+
+
+TEST_F(GameInputTest, RepeatsAfterTheDelayedAutoShift) {
+    step(1, { InputEvent::MoveRightPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 4);
+
+    // the wall is reached after two repeats, after that nothing moves anymore
+    ASSERT_EQ(moves_until(2, 40), (std::vector<SimulationStep>{ 11, 13 }));
+    ASSERT_EQ(leftmost_x(tetrion), 6);
+}
+
+TEST_F(GameInputTest, CatchesUpOnMissedRepeatsWithASingleMove) {
+    step(1, { InputEvent::MoveLeftPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 2);
+
+    // the repeats at 11 and 13 were missed, they are skipped and not made up for at once
+    step(14);
+    ASSERT_EQ(leftmost_x(tetrion), 1);
+
+    // the next repeat stays on the grid of the auto repeat rate
+    ASSERT_EQ(moves_until(15, 20), (std::vector<SimulationStep>{ 15 }));
+    ASSERT_EQ(leftmost_x(tetrion), 0);
+}
+
+TEST_F(GameInputTest, OppositeKeysCancelEachOtherOut) {
+    step(1, { InputEvent::MoveRightPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 4);
+
+    // pressing the opposite key doesn't move, and while both are held, nothing repeats
+    step(3, { InputEvent::MoveLeftPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 4);
+    ASSERT_TRUE(moves_until(4, 19).empty());
+
+    // releasing one key lets the other one repeat, it was held longer than the delay, so it repeats right away
+    step(20, { InputEvent::MoveRightReleased });
+    ASSERT_EQ(leftmost_x(tetrion), 3);
+    ASSERT_EQ(moves_until(21, 29), (std::vector<SimulationStep>{ 21, 23, 25 }));
+    ASSERT_EQ(leftmost_x(tetrion), 0);
+
+    // pressing the other direction again moves at once and starts a new delay
+    step(30, { InputEvent::MoveLeftReleased, InputEvent::MoveRightPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 1);
+    ASSERT_EQ(moves_until(31, 42), (std::vector<SimulationStep>{ 40, 42 }));
+}
+
+TEST_F(GameInputTest, ReleasingStopsTheRepeats) {
+    step(1, { InputEvent::MoveLeftPressed });
+    ASSERT_EQ(moves_until(2, 11), (std::vector<SimulationStep>{ 11 }));
+
+    step(12, { InputEvent::MoveLeftReleased });
+    ASSERT_EQ(leftmost_x(tetrion), 1);
+    ASSERT_TRUE(moves_until(13, 30).empty());
+}
+
+TEST_F(GameInputTest, MovesToTheWallWithoutAutoRepeatRate) {
+    input.set_auto_shift_timings({ .delayed_auto_shift_frames = 10, .auto_repeat_rate_frames = 0 });
+
+    step(1, { InputEvent::MoveRightPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 4);
+    ASSERT_EQ(moves_until(2, 14), (std::vector<SimulationStep>{ 11 }));
+    ASSERT_EQ(leftmost_x(tetrion), 6);
+
+    // the rotation frees the way by one column, the held key moves there in the same step, not only after another delay
+    step(15, { InputEvent::RotateRightPressed });
+    ASSERT_EQ(leftmost_x(tetrion), 9);
+}
+
+TEST_F(GameInputTest, MoveToWallStopsAtTheWall) {
+    ASSERT_TRUE(tetrion.handle_input_command(input::GameInputCommand::MoveLeftToWall, 1));
+    ASSERT_EQ(leftmost_x(tetrion), 0);
+    ASSERT_FALSE(tetrion.handle_input_command(input::GameInputCommand::MoveLeftToWall, 2));
+    ASSERT_EQ(leftmost_x(tetrion), 0);
+
+    ASSERT_TRUE(tetrion.handle_input_command(input::GameInputCommand::MoveRightToWall, 3));
+    ASSERT_EQ(leftmost_x(tetrion), 6);
+    ASSERT_FALSE(tetrion.handle_input_command(input::GameInputCommand::MoveRightToWall, 4));
+    ASSERT_EQ(leftmost_x(tetrion), 6);
+}
@@ -0,0 +1,94 @@
+#include "ui/hit_test_index.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+
+
+namespace {
+
+    std::vector<u32> brute_force(const std::vector<shapes::URect>& rects, const shapes::IPoint& point) {
+        std::vector<u32> result{};
+        for (u32 index = 0; index < rects.size(); ++index) {
+            const auto rect = rects.at(index).cast<i32>();
+            if (point.x >= rect.top_left.x and point.x <= rect.bottom_right.x and point.y >= rect.top_left.y
+                and point.y <= rect.bottom_right.y) {
+                result.push_back(index);
+            }
+        }
+        return result;
+    }
+
+    std::vector<u32> hits(
+            const ui::HitTestIndex& index,
+            const std::vector<shapes::URect>& rects,
+            const shapes::IPoint& point
+    ) {
+        std::vector<u32> result{};
+        for (const auto candidate : index.candidates(point)) {
+            if (not brute_force({ rects.at(candidate) }, point).empty()) {
+                result.push_back(candidate);
+            }
+        }
+        return result;
+    }
+
+} // namespace
+
+
+TEST(HitTestIndex, FindsTheSameRectsAsTestingAll) {
+    std::vector<shapes::URect> rects{};
+
+    // rows of a settings menu, each with a few buttons, and some overlapping rects
+    for (u32 row = 0; row < 50; ++row) {
+        for (u32 column = 0; column < 4; ++column) {
+            rects.emplace_back(100 + column * 150, 20 + row * 40, 140, 35);
+        }
+    }
+    rects.emplace_back(90, 10, 620, 300);
+    rects.emplace_back(400, 500, 1, 1);
+
+    ui::HitTestIndex index{};
+    index.rebuild(rects);
+
+    std::mt19937 generator{ 42 }; // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<i32> x_distribution{ -10, 800 };
+    std::uniform_int_distribution<i32> y_distribution{ -10, 2100 };
+
+    for (u32 i = 0; i < 10000; ++i) {
+        const auto point = shapes::IPoint{ x_distribution(generator), y_distribution(generator) };
+        ASSERT_EQ(hits(index, rects, point), brute_force(rects, point)) << point;
+    }
+
+    EXPECT_EQ(hits(index, rects, { 400, 500 }), (std::vector<u32>{ 50, 201 }));
+    EXPECT_EQ(hits(index, rects, { 100, 20 }), (std::vector<u32>{ 0, 200 }));
+}
+
+TEST(HitTestIndex, OnlyTestsTheRectsNearThePoint) {
+    std::vector<shapes::URect> rects{};
+    for (u32 row = 0; row < 1000; ++row) {
+        rects.emplace_back(0, row * 10, 500, 10);
+    }
+
+    ui::HitTestIndex index{};
+    index.rebuild(rects);
+
+    for (i32 y = 0; y < 10000; y += 7) {
+        EXPECT_LE(index.candidates({ 250, y }).size(), 2) << y;
+    }
+}
+
+TEST(HitTestIndex, IsEmptyWithoutRects) {
+    ui::HitTestIndex index{};
+    EXPECT_TRUE(index.candidates({ 0, 0 }).empty());
+
+    index.rebuild(std::vector<shapes::URect>{ shapes::URect{ 0, 0, 0, 0 } });
+    EXPECT_TRUE(index.candidates({ 0, 0 }).empty());
+
+    index.rebuild(std::vector<shapes::URect>{ shapes::URect{ 10, 10, 10, 10 }, shapes::URect{ 0, 0, 0, 0 } });
+    EXPECT_EQ(index.candidates({ 15, 15 }).size(), 1);
+    EXPECT_TRUE(index.candidates({ 9, 15 }).empty());
+    EXPECT_TRUE(index.candidates({ 15, 20 }).empty());
+
+    index.clear();
+    EXPECT_TRUE(index.candidates({ 15, 15 }).empty());
+}
@@ -0,0 +1,125 @@
+#include "lobby/async_client.hpp"
+#include "lobby/cache.hpp"
+
+#include <gtest/gtest.h>
+
+
+namespace {
+
+    lobby::LobbyInfo lobby_info(const std::string& id, const std::string& name, int num_players) {
+        return lobby::LobbyInfo{ .id = id,
+                                 .name = name,
+                                 .size = 4,
+                                 .num_players_in_lobby = num_players,
+                                 .host_info = lobby::PlayerInfo{ .id = "host", .name = "host" } };
+    }
+
+    // diffs the polled lists like the AsyncClient does it
+    struct Poller {
+        std::vector<lobby::LobbyInfo> previous;
+
+        lobby::LobbyListUpdate poll(const std::vector<lobby::LobbyInfo>& lobbies) {
+            auto update = lobby::diff_lobby_lists(previous, lobbies);
+            previous = lobbies;
+            return update;
+        }
+    };
+
+    // applies the changes to rows, like a ui would do it
+    void apply_changes(
+            std::vector<lobby::LobbyInfo>& rows,
+            const lobby::LobbyCache& cache,
+            const std::vector<lobby::LobbyListChange>& changes
+    ) {
+        for (const auto& change : changes) {
+            const auto position = rows.begin() + static_cast<std::ptrdiff_t>(change.index);
+            switch (change.type) {
+                case lobby::LobbyListChange::Type::Insert:
+                    rows.insert(position, cache.lobbies().at(change.index));
+                    break;
+                case lobby::LobbyListChange::Type::Update:
+                    *position = cache.lobbies().at(change.index);
+                    break;
+                case lobby::LobbyListChange::Type::Remove:
+                    rows.erase(position);
+                    break;
+            }
+        }
+    }
+
+} // namespace
+
+
+TEST(LobbyCache, SortsTheLobbiesByName) {
+    lobby::LobbyCache cache{};
+    Poller poller{};
+    const auto changes =
+            cache.apply(poller.poll({ lobby_info("1", "b", 1), lobby_info("2", "a", 1), lobby_info("3", "c", 1) }));
+
+    EXPECT_EQ(changes.size(), 3);
+    EXPECT_EQ(
+            cache.lobbies(),
+            (std::vector<lobby::LobbyInfo>{ lobby_info("2", "a", 1), lobby_info("1", "b", 1), lobby_info("3", "c", 1) })
+    );
+}
+
+TEST(LobbyCache, OnlyReportsTheChangedRows) {
+    lobby::LobbyCache cache{};
+    Poller poller{};
+    std::vector<lobby::LobbyInfo> rows{};
+
+    apply_changes(
+            rows, cache,
+            cache.apply(poller.poll({ lobby_info("1", "a", 1), lobby_info("2", "b", 1), lobby_info("3", "c", 1) }))
+    );
+    EXPECT_TRUE(cache.apply(poller.poll(poller.previous)).empty());
+
+    const auto changes =
+            cache.apply(poller.poll({ lobby_info("1", "a", 1), lobby_info("3", "c", 2), lobby_info("4", "d", 1) }));
+    EXPECT_EQ(
+            changes,
+            (std::vector<lobby::LobbyListChange>{
+                    { .type = lobby::LobbyListChange::Type::Remove, .index = 1 },
+                    { .type = lobby::LobbyListChange::Type::Update, .index = 1 },
+                    { .type = lobby::LobbyListChange::Type::Insert, .index = 2 },
+            })
+    );
+
+    apply_changes(rows, cache, changes);
+    EXPECT_EQ(rows, cache.lobbies());
+}
+
+TEST(LobbyCache, MovesRenamedLobbies) {
+    lobby::LobbyCache cache{};
+    Poller poller{};
+    std::vector<lobby::LobbyInfo> rows{};
+
+    apply_changes(
+            rows, cache,
+            cache.apply(poller.poll({ lobby_info("1", "a", 1), lobby_info("2", "b", 1), lobby_info("3", "c", 1) }))
+    );
+    apply_changes(
+            rows, cache,
+            cache.apply(poller.poll({ lobby_info("1", "z", 1), lobby_info("2", "b", 1), lobby_info("3", "c", 1) }))
+    );
+
+    EXPECT_EQ(cache.index_of("1"), 2);
+    EXPECT_EQ(rows, cache.lobbies());
+}
+
+TEST(LobbyCache, TreatsAddedLobbiesThatAreCachedAsChanged) {
+    lobby::LobbyCache cache{};
+    std::vector<lobby::LobbyInfo> rows{};
+
+    apply_changes(rows, cache, cache.apply(Poller{}.poll({ lobby_info("1", "a", 1), lobby_info("2", "b", 1) })));
+
+    // e.g. the first update of a restarted polling
+    const auto changes = cache.apply(Poller{}.poll({ lobby_info("1", "a", 1), lobby_info("2", "b", 2) }));
+    EXPECT_EQ(
+            changes,
+            (std::vector<lobby::LobbyListChange>{ { .type = lobby::LobbyListChange::Type::Update, .index = 1 } })
+    );
+
+    apply_changes(rows, cache, changes);
+    EXPECT_EQ(rows, cache.lobbies());
+}
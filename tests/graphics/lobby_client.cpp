@@ -0,0 +1,259 @@
+#include "lobby/async_client.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <thread>
+
+
+namespace {
+
+    lobby::LobbyInfo lobby_info(const std::string& id, int num_players) {
+        return lobby::LobbyInfo{ .id = id,
+                                 .name = fmt::format("lobby {}", id),
+                                 .size = 4,
+                                 .num_players_in_lobby = num_players,
+                                 .host_info = lobby::PlayerInfo{ .id = "host", .name = "host" } };
+    }
+
+    // a stand-in for the lobby server, it supports etags for the lobby list and can block the user list
+    struct StandInServer {
+        httplib::Server server;
+        int port;
+        std::thread thread;
+
+        std::mutex mutex;
+        std::vector<lobby::LobbyInfo> lobbies{ lobby_info("1", 1), lobby_info("2", 3) };
+        u32 lobbies_version{ 0 };
+        u32 num_lobby_requests{ 0 };
+        u32 num_not_modified{ 0 };
+        std::set<int> remote_ports;
+
+        std::atomic<bool> is_users_blocked{ false };
+        std::atomic<u32> num_reachability_checks{ 0 };
+
+        // binds to any free port by default
+        explicit StandInServer(int requested_port = 0) {
+            server.Get("/", [this](const httplib::Request&, httplib::Response& response) {
+                ++num_reachability_checks;
+                response.set_content("lobby stand-in", "text/plain");
+            });
+
+            server.Get("/lobbies", [this](const httplib::Request& request, httplib::Response& response) {
+                std::unique_lock lock{ mutex };
+                ++num_lobby_requests;
+                remote_ports.insert(request.remote_port);
+
+                const auto etag = fmt::format("\"{}\"", lobbies_version);
+                if (request.get_header_value("If-None-Match") == etag) {
+                    ++num_not_modified;
+                    response.status = 304;
+                    return;
+                }
+
+                response.set_header("ETag", etag);
+                response.set_content(json::try_json_to_string(lobbies).value(), constants::json_content_type);
+            });
+
+            server.Get("/users", [this](const httplib::Request&, httplib::Response& response) {
+                while (is_users_blocked.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+                }
+                response.set_content("[]", constants::json_content_type);
+            });
+
+            if (requested_port == 0) {
+                port = server.bind_to_any_port("127.0.0.1");
+            } else {
+                port = server.bind_to_port("127.0.0.1", requested_port) ? requested_port : -1;
+            }
+            thread = std::thread{ [this] { server.listen_after_bind(); } };
+            server.wait_until_ready();
+        }
+
+        StandInServer(const StandInServer&) = delete;
+        StandInServer& operator=(const StandInServer&) = delete;
+        StandInServer(StandInServer&&) = delete;
+        StandInServer& operator=(StandInServer&&) = delete;
+
+        ~StandInServer() {
+            is_users_blocked = false;
+            server.stop();
+            thread.join();
+        }
+
+        [[nodiscard]] std::string url() const {
+            return fmt::format("http://127.0.0.1:{}", port);
+        }
+
+        void set_lobbies(std::vector<lobby::LobbyInfo> new_lobbies) {
+            std::unique_lock lock{ mutex };
+            lobbies = std::move(new_lobbies);
+            ++lobbies_version;
+        }
+    };
+
+    // the main thread keeps running, while the client waits for the network
+    template<typename Predicate>
+    [[nodiscard]] bool poll_until(lobby::AsyncClient& client, const Predicate& predicate) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+
+        while (not predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            client.poll();
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+
+        return true;
+    }
+
+    // a port, that was just free, so nothing listens on it
+    [[nodiscard]] int unused_port() {
+        httplib::Server server{};
+        return server.bind_to_any_port("127.0.0.1");
+    }
+
+} // namespace
+
+
+TEST(LobbyClient, CallsTheCallbacksInPoll) {
+    StandInServer server{};
+
+    std::optional<lobby::Result<void>> connected{};
+    std::optional<lobby::Result<std::vector<lobby::LobbyInfo>>> lobbies{};
+
+    lobby::AsyncClient client{ server.url(), [&connected](lobby::Result<void>&& result) { connected = result; } };
+    // sent before the client is connected
+    client.get_lobbies([&lobbies](auto&& result) { lobbies = std::move(result); });
+
+    ASSERT_TRUE(poll_until(client, [&lobbies] { return lobbies.has_value(); }));
+
+    ASSERT_TRUE(connected.has_value());
+    EXPECT_TRUE(connected->has_value()) << connected->error();
+    ASSERT_TRUE(lobbies->has_value()) << lobbies->error();
+    EXPECT_EQ(lobbies->value(), server.lobbies);
+}
+
+TEST(LobbyClient, NeverCallsTheCallbacksOfCancelledRequests) {
+    StandInServer server{};
+    server.is_users_blocked = true;
+
+    lobby::AsyncClient client{ server.url(), nullptr };
+
+    bool running_called = false;
+    bool queued_called = false;
+    std::optional<lobby::Result<std::vector<lobby::LobbyInfo>>> lobbies{};
+
+    const auto running = client.get_users([&running_called](auto&&) { running_called = true; });
+    const auto queued = client.get_lobbies([&queued_called](auto&&) { queued_called = true; });
+
+    // give the worker time to start the blocked request
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+
+    client.cancel(queued);
+    client.cancel(running);
+    EXPECT_TRUE(running.is_cancelled());
+    EXPECT_TRUE(queued.is_cancelled());
+
+    server.is_users_blocked = false;
+
+    // the connection of the cancelled request was closed, the next request opens a new one
+    client.get_lobbies([&lobbies](auto&& result) { lobbies = std::move(result); });
+    ASSERT_TRUE(poll_until(client, [&lobbies] { return lobbies.has_value(); }));
+    EXPECT_TRUE(lobbies->has_value()) << lobbies->error();
+
+    client.poll();
+    EXPECT_FALSE(running_called);
+    EXPECT_FALSE(queued_called);
+}
+
+TEST(LobbyClient, PollsTheLobbiesAndReportsOnlyChanges) {
+    StandInServer server{};
+
+    std::vector<lobby::LobbyListUpdate> updates{};
+    lobby::AsyncClient client{ server.url(), nullptr };
+    client.start_polling_lobbies(std::chrono::milliseconds{ 5 }, [&updates](auto&& result) {
+        ASSERT_TRUE(result.has_value()) << result.error();
+        updates.push_back(std::move(result.value()));
+    });
+
+    ASSERT_TRUE(poll_until(client, [&updates] { return updates.size() == 1; }));
+    EXPECT_EQ(updates.at(0).added, server.lobbies);
+
+    ASSERT_TRUE(poll_until(client, [&server] {
+        std::unique_lock lock{ server.mutex };
+        return server.num_not_modified >= 3;
+    }));
+    EXPECT_EQ(updates.size(), 1);
+
+    server.set_lobbies({ lobby_info("2", 4), lobby_info("3", 1) });
+
+    ASSERT_TRUE(poll_until(client, [&updates] { return updates.size() == 2; }));
+    const auto& update = updates.at(1);
+    EXPECT_EQ(update.added, std::vector<lobby::LobbyInfo>{ lobby_info("3", 1) });
+    EXPECT_EQ(update.changed, std::vector<lobby::LobbyInfo>{ lobby_info("2", 4) });
+    EXPECT_EQ(update.removed, std::vector<std::string>{ "1" });
+
+    client.stop_polling_lobbies();
+
+    std::unique_lock lock{ server.mutex };
+    // the connection is kept alive between the polls
+    EXPECT_EQ(server.remote_ports.size(), 1);
+}
+
+TEST(LobbyClient, ReportsUnreachableServers) {
+    const auto port = unused_port();
+
+    std::optional<lobby::Result<void>> connected{};
+    std::optional<lobby::Result<std::vector<lobby::LobbyInfo>>> lobbies{};
+
+    lobby::AsyncClient client{ fmt::format("http://127.0.0.1:{}", port),
+                               [&connected](lobby::Result<void>&& result) { connected = result; } };
+    client.get_lobbies([&lobbies](auto&& result) { lobbies = std::move(result); });
+
+    ASSERT_TRUE(poll_until(client, [&lobbies] { return lobbies.has_value(); }));
+    ASSERT_TRUE(connected.has_value());
+    EXPECT_FALSE(connected->has_value());
+    EXPECT_FALSE(lobbies->has_value());
+}
+
+TEST(LobbyClient, RetriesAFailedConnect) {
+    const auto port = unused_port();
+
+    std::optional<lobby::Result<void>> connected{};
+    lobby::AsyncClient client{ fmt::format("http://127.0.0.1:{}", port),
+                               [&connected](lobby::Result<void>&& result) { connected = result; } };
+
+    std::optional<lobby::Result<std::vector<lobby::LobbyInfo>>> lobbies{};
+    client.get_lobbies([&lobbies](auto&& result) { lobbies = std::move(result); });
+    ASSERT_TRUE(poll_until(client, [&lobbies] { return lobbies.has_value(); }));
+    ASSERT_TRUE(connected.has_value());
+    EXPECT_FALSE(connected->has_value());
+    EXPECT_FALSE(lobbies->has_value());
+
+    // the server comes up later, e.g. after a restart
+    StandInServer server{ port };
+    ASSERT_EQ(server.port, port);
+
+    // the requests fail, until the delay before the next connect attempt is over
+    ASSERT_TRUE(poll_until(client, [&client, &lobbies] {
+        if (lobbies.has_value() and lobbies->has_value()) {
+            return true;
+        }
+
+        if (lobbies.has_value()) {
+            lobbies = std::nullopt;
+            client.get_lobbies([&lobbies](auto&& result) { lobbies = std::move(result); });
+        }
+        return false;
+    }));
+    EXPECT_EQ(lobbies->value(), server.lobbies);
+
+    // once connected, the reachability isn't checked again
+    EXPECT_EQ(server.num_reachability_checks, 1);
+}
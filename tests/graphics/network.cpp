@@ -0,0 +1,354 @@
+#include "game/rollback_session.hpp"
+#include "network/connection.hpp"
+#include "network/game_server.hpp"
+#include "network/protocol.hpp"
+#include "network/udp_transport.hpp"
+
+#include <array>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <recordings/utility/recording.hpp>
+#include <recordings/utility/tetrion_snapshot.hpp>
+#include <thread>
+
+
+namespace {
+
+    rollback::InputFrame frame(u8 tetrion_index, SimulationStep simulation_step_index, std::vector<InputEvent> events) {
+        return rollback::InputFrame{ .tetrion_index = tetrion_index,
+                                     .simulation_step_index = simulation_step_index,
+                                     .events = std::move(events) };
+    }
+
+    network::InputPacket input_packet() {
+        return network::InputPacket{
+            .sequence = 17,
+            .acknowledgements = { network::Acknowledgement{ .tetrion_index = 1, .simulation_step_index = 99 } },
+            .frames = {
+                    frame(0, 5, {}),
+                    frame(0, 6, { InputEvent::MoveLeftPressed, InputEvent::RotateRightPressed }),
+                    frame(0, 7, {}),
+                    frame(0, 9, { InputEvent::HoldReleased }),
+                    frame(1, 9, { InputEvent::DropPressed }),
+            },
+        };
+    }
+
+    network::InputPacket decode_input(const std::vector<char>& bytes) {
+        auto packet = network::decode(bytes);
+        EXPECT_TRUE(packet.has_value()) << packet.error();
+        EXPECT_TRUE(std::holds_alternative<network::InputPacket>(packet.value()));
+        return std::get<network::InputPacket>(packet.value());
+    }
+
+} // namespace
+
+
+TEST(NetworkProtocol, RoundTripsAllPackets) {
+    const std::array<network::Packet, 3> packets{
+        network::JoinPacket{ .auto_shift_timings = { .delayed_auto_shift_frames = 8, .auto_repeat_rate_frames = 0 } },
+        network::WelcomePacket{
+                .tetrion_index = 1,
+                .players = {
+                        rollback::PlayerParameters{ .seed = 42, .starting_level = 0, .auto_shift_timings = {} },
+                        rollback::PlayerParameters{ .seed = 1337, .starting_level = 5, .auto_shift_timings = {} },
+                },
+        },
+        input_packet(),
+    };
+
+    for (const auto& packet : packets) {
+        const auto bytes = network::encode(packet);
+        ASSERT_LE(bytes.size(), network::max_packet_size);
+
+        const auto decoded = network::decode(bytes);
+        ASSERT_TRUE(decoded.has_value()) << decoded.error();
+        EXPECT_EQ(decoded.value(), packet);
+    }
+}
+
+TEST(NetworkProtocol, FramesWithoutEventsOnlyCostTheirRange) {
+    network::InputPacket packet{ .sequence = 0, .acknowledgements = {}, .frames = {} };
+    for (SimulationStep step = 1; step <= 100; ++step) {
+        packet.frames.push_back(frame(0, step, {}));
+    }
+
+    const auto empty_size = network::encode(network::InputPacket{ .sequence = 0, .acknowledgements = {}, .frames = {} })
+                                    .size();
+    EXPECT_EQ(network::encode(packet).size(), empty_size + network::encoded_size(packet.frames.front(), true));
+    EXPECT_EQ(decode_input(network::encode(packet)), packet);
+}
+
+TEST(NetworkProtocol, RejectsInvalidPackets) {
+    const auto bytes = network::encode(input_packet());
+
+    // every truncated packet is invalid, since the counts in the packet don't match anymore
+    for (usize size = 0; size < bytes.size(); ++size) {
+        EXPECT_FALSE(network::decode(std::span<const char>{ bytes.data(), size }).has_value()) << size;
+    }
+
+    auto trailing = bytes;
+    trailing.push_back(0);
+    EXPECT_FALSE(network::decode(trailing).has_value());
+
+    auto invalid_magic = bytes;
+    invalid_magic.at(0) = 'X';
+    EXPECT_FALSE(network::decode(invalid_magic).has_value());
+
+    auto invalid_version = bytes;
+    invalid_version.at(sizeof(u32)) = static_cast<char>(network::protocol_version + 1);
+    EXPECT_FALSE(network::decode(invalid_version).has_value());
+
+    auto invalid_event = bytes;
+    invalid_event.back() = static_cast<char>(utils::to_underlying(InputEvent::HoldReleased) + 1);
+    EXPECT_FALSE(network::decode(invalid_event).has_value());
+
+    // the last record belongs to tetrion 1, at tetrion 2 it is outside of all ranges
+    auto outside_of_ranges = bytes;
+    outside_of_ranges.at(outside_of_ranges.size() - recorder::Record::encoded_size) = 2;
+    EXPECT_FALSE(network::decode(outside_of_ranges).has_value());
+}
+
+TEST(NetworkConnection, RepairsLostPacketsWithTheNextOne) {
+    network::Connection sender{};
+    network::Connection receiver{};
+
+    sender.queue(frame(0, 1, { InputEvent::MoveLeftPressed }));
+    const auto lost = sender.create_input_packet();
+
+    sender.queue(frame(0, 2, {}));
+    sender.queue(frame(0, 3, { InputEvent::MoveLeftReleased }));
+    const auto packet = decode_input(network::encode(sender.create_input_packet()));
+    EXPECT_EQ(packet.frames.size(), 3);
+
+    receiver.handle(packet);
+    // a late duplicate doesn't deliver frames twice
+    receiver.handle(lost);
+
+    for (SimulationStep step = 1; step <= 3; ++step) {
+        const auto received = receiver.receive();
+        ASSERT_TRUE(received.has_value());
+        EXPECT_EQ(received->simulation_step_index, step);
+    }
+    EXPECT_FALSE(receiver.receive().has_value());
+    EXPECT_EQ(receiver.statistics().packets_lost, 0);
+    EXPECT_EQ(receiver.statistics().packets_reordered, 1);
+
+    sender.handle(receiver.create_input_packet());
+    EXPECT_FALSE(sender.has_unacknowledged_frames());
+    EXPECT_TRUE(sender.create_input_packet().frames.empty());
+}
+
+TEST(NetworkConnection, FillsPacketsUpToTheMaximumSize) {
+    network::Connection sender{};
+
+    for (SimulationStep step = 1; step <= 1000; ++step) {
+        sender.queue(frame(0, step, { InputEvent::MoveLeftPressed, InputEvent::MoveLeftReleased }));
+    }
+
+    const auto first = sender.create_input_packet();
+    EXPECT_FALSE(first.frames.empty());
+    EXPECT_LT(first.frames.size(), 1000);
+    EXPECT_EQ(first.frames.front().simulation_step_index, 1);
+    EXPECT_LE(network::encode(first).size(), network::max_packet_size);
+}
+
+TEST(NetworkConnection, SplitsLongStretchesWithoutEventsIntoSeveralPackets) {
+    constexpr SimulationStep num_steps = (2 * network::max_frames_per_packet) + 100;
+
+    network::Connection sender{};
+    network::Connection receiver{};
+
+    // e.g. a peer, that didn't acknowledge anything for a while, the frames barely take space in the packet
+    for (SimulationStep step = 1; step <= num_steps; ++step) {
+        sender.queue(frame(0, step, {}));
+    }
+
+    usize num_packets = 0;
+    while (sender.has_unacknowledged_frames()) {
+        ASSERT_LT(num_packets, 10);
+        ++num_packets;
+
+        const auto decoded = network::decode(network::encode(sender.create_input_packet()));
+        ASSERT_TRUE(decoded.has_value()) << decoded.error();
+        const auto& packet = std::get<network::InputPacket>(decoded.value());
+        EXPECT_LE(packet.frames.size(), network::max_frames_per_packet);
+
+        receiver.handle(packet);
+        sender.handle(receiver.create_input_packet());
+    }
+
+    EXPECT_EQ(num_packets, 3);
+
+    SimulationStep last_step = 0;
+    while (const auto received = receiver.receive()) {
+        ASSERT_EQ(received->simulation_step_index, last_step + 1);
+        last_step = received->simulation_step_index;
+    }
+    EXPECT_EQ(last_step, num_steps);
+}
+
+TEST(NetworkConnection, DropsFramesOutsideOfTheWindowWithoutAcknowledgingThem) {
+    network::Connection receiver{ 10 };
+
+    receiver.handle(network::InputPacket{
+            .sequence = 0,
+            .acknowledgements = {},
+            .frames = { frame(0, 5, {}), frame(0, 11, { InputEvent::DropPressed }), frame(0, 10, {}) },
+    });
+
+    EXPECT_EQ(receiver.receive()->simulation_step_index, 5);
+    EXPECT_EQ(receiver.receive()->simulation_step_index, 10);
+    EXPECT_FALSE(receiver.receive().has_value());
+    EXPECT_EQ(receiver.statistics().frames_dropped, 1);
+
+    // once the earlier frames arrived, the window moved and the frame is accepted
+    network::InputPacket packet{ .sequence = 1, .acknowledgements = {}, .frames = {} };
+    for (SimulationStep step = 1; step <= 9; ++step) {
+        if (step != 5) {
+            packet.frames.push_back(frame(0, step, {}));
+        }
+    }
+    packet.frames.push_back(frame(0, 11, { InputEvent::DropPressed }));
+    receiver.handle(packet);
+
+    SimulationStep last_step = 0;
+    while (const auto received = receiver.receive()) {
+        last_step = received->simulation_step_index;
+    }
+    EXPECT_EQ(last_step, 11);
+
+    const auto acknowledgements = receiver.create_input_packet().acknowledgements;
+    ASSERT_EQ(acknowledgements.size(), 1);
+    EXPECT_EQ(acknowledgements.front(), (network::Acknowledgement{ .tetrion_index = 0, .simulation_step_index = 11 }));
+}
+
+TEST(NetworkConnection, SharesPacketsBetweenTetrions) {
+    network::Connection sender{};
+
+    for (SimulationStep step = 1; step <= 1000; ++step) {
+        sender.queue(frame(0, step, { InputEvent::MoveLeftPressed, InputEvent::MoveLeftReleased }));
+    }
+    for (SimulationStep step = 1; step <= 5; ++step) {
+        sender.queue(frame(1, step, { InputEvent::DropPressed }));
+    }
+
+    const auto packet = sender.create_input_packet();
+    EXPECT_LE(network::encode(packet).size(), network::max_packet_size);
+
+    const auto num_frames = [&packet](u8 tetrion_index) {
+        return std::ranges::count_if(packet.frames, [tetrion_index](const auto& value) {
+            return value.tetrion_index == tetrion_index;
+        });
+    };
+    EXPECT_GT(num_frames(0), 5);
+    EXPECT_EQ(num_frames(1), 5);
+    EXPECT_EQ(decode_input(network::encode(packet)), packet);
+}
+
+TEST(NetworkAddress, ParsesIpv4Addresses) {
+    const auto address = network::Address::from_string("127.0.0.1:7777");
+    ASSERT_TRUE(address.has_value()) << address.error();
+    EXPECT_EQ(address.value(), (network::Address{ .ip = network::Address::localhost, .port = 7777 }));
+    EXPECT_EQ(address->to_string(), "127.0.0.1:7777");
+
+    EXPECT_FALSE(network::Address::from_string("127.0.0.1:70000").has_value());
+    EXPECT_FALSE(network::Address::from_string("256.0.0.1").has_value());
+    EXPECT_FALSE(network::Address::from_string("127.0.0").has_value());
+    EXPECT_FALSE(network::Address::from_string("127.0.0.1.1").has_value());
+}
+
+TEST(GameServer, SimulatesTheSameGameAsTheClients) {
+    constexpr u8 num_players = 2;
+    constexpr SimulationStep num_steps = 300;
+
+    auto server = network::GameServer::create(
+            network::Address{ .ip = network::Address::localhost, .port = 0 },
+            network::GameServer::Options{ .num_players = num_players, .seed = 42, .starting_level = 3 }
+    );
+    ASSERT_TRUE(server.has_value()) << server.error();
+
+    const auto server_address = server.value()->address();
+    ASSERT_TRUE(server_address.has_value()) << server_address.error();
+
+    std::vector<std::unique_ptr<network::UdpTransport>> transports{};
+    for (u8 index = 0; index < num_players; ++index) {
+        auto transport = network::UdpTransport::create(server_address.value());
+        ASSERT_TRUE(transport.has_value()) << transport.error();
+        transports.push_back(std::move(transport.value()));
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+    const auto wait = [&]() {
+        std::this_thread::sleep_for(std::chrono::microseconds{ 100 });
+        server.value()->poll();
+        return std::chrono::steady_clock::now() < deadline;
+    };
+
+    // the clients join one after the other, so the tetrion indices are known
+    for (const auto& transport : transports) {
+        const auto joined = server.value()->num_clients();
+        while (server.value()->num_clients() == joined) {
+            transport->join({});
+            ASSERT_TRUE(wait());
+        }
+    }
+
+    std::vector<std::unique_ptr<rollback::RollbackSession>> sessions{};
+    for (u8 index = 0; index < num_players; ++index) {
+        while (not transports.at(index)->welcome().has_value()) {
+            transports.at(index)->poll();
+            ASSERT_TRUE(wait());
+        }
+
+        const auto& welcome = transports.at(index)->welcome().value();
+        EXPECT_EQ(welcome.tetrion_index, index);
+        sessions.push_back(std::make_unique<rollback::RollbackSession>(welcome.players, welcome.tetrion_index));
+    }
+
+    const auto receive_all = [&](u8 index) {
+        while (const auto received = transports.at(index)->receive()) {
+            ASSERT_TRUE(sessions.at(index)->add_remote_frame(received.value()).has_value());
+        }
+    };
+
+    while (std::ranges::any_of(sessions, [](const auto& session) {
+        return session->confirmed_simulation_step_index() < num_steps;
+    })) {
+        for (u8 index = 0; index < num_players; ++index) {
+            auto& session = *sessions.at(index);
+            receive_all(index);
+
+            if (session.simulation_step_index() < num_steps and session.can_advance()) {
+                const auto step = session.simulation_step_index() + 1;
+                if (step % (20 + index) == 0) {
+                    session.add_local_event(InputEvent::DropPressed);
+                } else if (step % (20 + index) == 1) {
+                    session.add_local_event(InputEvent::DropReleased);
+                }
+
+                const auto local_frame = session.advance();
+                ASSERT_TRUE(local_frame.has_value());
+                transports.at(index)->send(local_frame.value());
+            } else {
+                // the transport sends the unacknowledged frames again on its own, while the session waits
+                session.apply_pending_rollback();
+            }
+        }
+
+        ASSERT_TRUE(wait());
+    }
+
+    EXPECT_EQ(server.value()->num_rejected_frames(), 0);
+
+    for (u8 tetrion_index = 0; tetrion_index < num_players; ++tetrion_index) {
+        ASSERT_EQ(server.value()->simulation_step_index(tetrion_index), num_steps);
+        const auto expected = TetrionSnapshot{ server.value()->tetrion(tetrion_index).core_information(), num_steps };
+
+        for (const auto& session : sessions) {
+            const auto actual = TetrionSnapshot{ session->tetrion(tetrion_index).core_information(), num_steps };
+            const auto result = actual.compare_to(expected);
+            EXPECT_TRUE(result.has_value()) << result.error();
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <recordings/utility/recording_reader.hpp>
+#include <recordings/utility/recording_writer.hpp>
+
+#include <array>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+TEST(RecordingWriter, KeepsTheRecordsOfConcurrentTetrionsIntact) {
+    constexpr u8 num_tetrions = 4;
+    constexpr u64 num_records = 2000;
+
+    const auto path = std::filesystem::temp_directory_path() / "oopetris_concurrent_recording.rec";
+
+    {
+        std::vector<recorder::TetrionHeader> headers{};
+        for (u8 tetrion_index = 0; tetrion_index < num_tetrions; ++tetrion_index) {
+            headers.emplace_back(tetrion_index, 0);
+        }
+
+        auto writer_result = recorder::RecordingWriter::get_writer(
+                path, std::move(headers), recorder::AdditionalInformation{}, false
+        );
+        ASSERT_TRUE(writer_result.has_value()) << writer_result.error();
+        const auto writer = std::make_shared<recorder::RecordingWriter>(std::move(writer_result.value()));
+
+        // every tetrion records from its own thread, like the threaded simulation does
+        std::vector<std::thread> threads{};
+        for (u8 tetrion_index = 0; tetrion_index < num_tetrions; ++tetrion_index) {
+            threads.emplace_back([&writer, tetrion_index] {
+                for (u64 step = 0; step < num_records; ++step) {
+                    EXPECT_TRUE(writer->add_record(tetrion_index, step, InputEvent::MoveLeftPressed).has_value());
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const auto reader = recorder::RecordingReader::from_path(path);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    ASSERT_EQ(reader->num_records(), num_tetrions * num_records);
+
+    // the records of different tetrions may be interleaved, but the ones of every tetrion are in order
+    std::array<u64, num_tetrions> next_steps{};
+    for (const auto& record : reader->records()) {
+        ASSERT_LT(record.tetrion_index, num_tetrions);
+        ASSERT_EQ(record.simulation_step_index, next_steps.at(record.tetrion_index));
+        ASSERT_EQ(record.event, InputEvent::MoveLeftPressed);
+        ++next_steps.at(record.tetrion_index);
+    }
+
+    std::filesystem::remove(path);
+}
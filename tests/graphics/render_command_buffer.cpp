@@ -0,0 +1,184 @@
+#include <core/helper/utils.hpp>
+
+#include "graphics/render_command_buffer.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+
+namespace {
+
+    // spans more than one cell of the overlap grid in both directions
+    constexpr int canvas_width = 160;
+    constexpr int canvas_height = 140;
+
+    struct Command {
+        enum class Type : u8 { Fill, Outline, Line, Point };
+
+        Type type;
+        // a line goes from (x, y) to (w, h)
+        SDL_Rect rect;
+        Color color;
+    };
+
+    [[nodiscard]] Command fill(const SDL_Rect& rect, const Color& color) {
+        return { .type = Command::Type::Fill, .rect = rect, .color = color };
+    }
+
+    [[nodiscard]] Command outline(const SDL_Rect& rect, const Color& color) {
+        return { .type = Command::Type::Outline, .rect = rect, .color = color };
+    }
+
+    [[nodiscard]] Command line(const SDL_Point& start, const SDL_Point& end, const Color& color) {
+        return { .type = Command::Type::Line, .rect = { start.x, start.y, end.x, end.y }, .color = color };
+    }
+
+    [[nodiscard]] Command point(const SDL_Point& position, const Color& color) {
+        return { .type = Command::Type::Point, .rect = { position.x, position.y, 1, 1 }, .color = color };
+    }
+
+    // a software renderer, that draws into a surface, so that the pixels can be compared
+    struct Canvas {
+        SDL_Surface* surface;
+        SDL_Renderer* renderer;
+
+        Canvas()
+            : surface{ SDL_CreateRGBSurfaceWithFormat(0, canvas_width, canvas_height, 32, SDL_PIXELFORMAT_RGBA8888) },
+              renderer{ SDL_CreateSoftwareRenderer(surface) } {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+        }
+
+        Canvas(const Canvas&) = delete;
+        Canvas& operator=(const Canvas&) = delete;
+        Canvas(Canvas&&) = delete;
+        Canvas& operator=(Canvas&&) = delete;
+
+        ~Canvas() {
+            SDL_DestroyRenderer(renderer);
+            SDL_FreeSurface(surface);
+        }
+
+        [[nodiscard]] std::vector<u32> pixels() const {
+            SDL_RenderFlush(renderer);
+
+            std::vector<u32> result{};
+            result.reserve(static_cast<usize>(canvas_width) * canvas_height);
+            for (int y = 0; y < canvas_height; ++y) {
+                const auto* const row = static_cast<const u32*>(surface->pixels)
+                                        + (static_cast<usize>(y) * static_cast<usize>(surface->pitch) / sizeof(u32));
+                result.insert(result.end(), row, row + canvas_width);
+            }
+            return result;
+        }
+    };
+
+    void draw_directly(SDL_Renderer* renderer, const std::vector<Command>& commands) {
+        for (const auto& [type, rect, color] : commands) {
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            switch (type) {
+                case Command::Type::Fill:
+                    SDL_RenderFillRect(renderer, &rect);
+                    break;
+                case Command::Type::Outline:
+                    SDL_RenderDrawRect(renderer, &rect);
+                    break;
+                case Command::Type::Line:
+                    SDL_RenderDrawLine(renderer, rect.x, rect.y, rect.w, rect.h);
+                    break;
+                case Command::Type::Point:
+                    SDL_RenderDrawPoint(renderer, rect.x, rect.y);
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+    }
+
+    void draw_buffered(SDL_Renderer* renderer, const std::vector<Command>& commands) {
+        RenderCommandBuffer buffer{ renderer };
+
+        for (const auto& [type, rect, color] : commands) {
+            switch (type) {
+                case Command::Type::Fill:
+                    buffer.fill_rect(rect, color);
+                    break;
+                case Command::Type::Outline:
+                    ASSERT_TRUE(buffer.draw_rect_outline(rect, color));
+                    break;
+                case Command::Type::Line:
+                    buffer.draw_line(SDL_Point{ rect.x, rect.y }, SDL_Point{ rect.w, rect.h }, color);
+                    break;
+                case Command::Type::Point:
+                    buffer.draw_point(SDL_Point{ rect.x, rect.y }, color);
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        buffer.flush();
+    }
+
+    // the batched result has to be exactly the same as drawing every command in order, also with blending
+    void expect_same_pixels(const std::vector<Command>& commands) {
+        const Canvas direct{};
+        const Canvas buffered{};
+
+        draw_directly(direct.renderer, commands);
+        draw_buffered(buffered.renderer, commands);
+
+        ASSERT_EQ(direct.pixels(), buffered.pixels());
+    }
+
+    constexpr Color red{ 255, 0, 0, 255 };
+    constexpr Color translucent_blue{ 0, 0, 255, 128 };
+    constexpr Color green{ 0, 255, 0, 200 };
+
+} // namespace
+
+
+TEST(RenderCommandBuffer, KeepsOverlappingFillsInOrder) {
+    expect_same_pixels({
+            fill({ 10, 10, 50, 50 }, red),
+            fill({ 30, 30, 50, 50 }, translucent_blue),
+            // overlaps the blue rect, so it mustn't be merged into the batch of the first red rect
+            fill({ 50, 50, 60, 60 }, red),
+            // doesn't overlap anything blue, so it can be merged
+            fill({ 120, 5, 20, 20 }, red),
+            // the bounds of rects with a negative size are normalized for the overlap test
+            fill({ 100, 100, -40, -30 }, green),
+            fill({ 62, 62, 4, 4 }, translucent_blue),
+    });
+}
+
+TEST(RenderCommandBuffer, KeepsOutlinesAndPointsInOrder) {
+    // SDL draws some pixels of degenerate outlines twice, so they are opaque
+    expect_same_pixels({
+            outline({ 5, 5, 100, 80 }, red),
+            fill({ 0, 40, 150, 10 }, translucent_blue),
+            outline({ 20, 30, 1, 40 }, red),
+            outline({ 70, 2, 3, 2 }, red),
+            point({ 5, 45 }, green),
+            point({ 5, 45 }, translucent_blue),
+    });
+}
+
+TEST(RenderCommandBuffer, DrawsTheSamePixelsForLinesAsSDL) {
+    std::vector<Command> commands{};
+
+    // lines in every direction, steep and shallow ones, starting and ending around the same point
+    constexpr SDL_Point center{ 70, 65 };
+    for (int offset = -60; offset <= 60; offset += 13) {
+        commands.push_back(line(center, { center.x + offset, center.y + 60 }, translucent_blue));
+        commands.push_back(line({ center.x + 60, center.y + offset }, center, green));
+    }
+
+    // the lines overlap each other and the fill, so blending only gives the same result, if every pixel is drawn once and in order
+    commands.push_back(fill({ 60, 55, 30, 30 }, red));
+    commands.push_back(line({ 0, 139 }, { 159, 0 }, translucent_blue));
+    commands.push_back(line({ 3, 3 }, { 3, 3 }, red));
+
+    expect_same_pixels(commands);
+}
@@ -0,0 +1,168 @@
+#include "game/rollback_session.hpp"
+#include "game/rollback_transport.hpp"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <recordings/utility/tetrion_snapshot.hpp>
+#include <utility>
+
+
+namespace {
+
+    constexpr SimulationStep num_steps = 600;
+
+    std::vector<rollback::PlayerParameters> players() {
+        return {
+            rollback::PlayerParameters{ .seed = 42, .starting_level = 0, .auto_shift_timings = {} },
+            rollback::PlayerParameters{ .seed = 1337, .starting_level = 5, .auto_shift_timings = {} },
+        };
+    }
+
+    // the events of a player, pressed in the given step
+    std::vector<std::pair<SimulationStep, InputEvent>> script(u8 tetrion_index) {
+        std::vector<std::pair<SimulationStep, InputEvent>> result{};
+
+        for (SimulationStep step = 10 + tetrion_index * 7; step < num_steps; step += 45) {
+            result.emplace_back(step, InputEvent::MoveLeftPressed);
+            result.emplace_back(step + 15, InputEvent::MoveLeftReleased);
+            result.emplace_back(step + 20, InputEvent::RotateRightPressed);
+            result.emplace_back(step + 21, InputEvent::RotateRightReleased);
+            result.emplace_back(step + 30, InputEvent::DropPressed);
+            result.emplace_back(step + 31, InputEvent::DropReleased);
+        }
+
+        return result;
+    }
+
+    void add_local_events(rollback::RollbackSession& session) {
+        for (const auto& [step, event] : script(session.local_index())) {
+            if (step == session.simulation_step_index() + 1) {
+                session.add_local_event(event);
+            }
+        }
+    }
+
+    void receive_all(rollback::RollbackSession& session, rollback::Transport& transport) {
+        while (auto frame = transport.receive()) {
+            ASSERT_TRUE(session.add_remote_frame(frame.value()).has_value());
+        }
+    }
+
+    void expect_same_state(const SimulatedTetrion& first, const SimulatedTetrion& second, SimulationStep step) {
+        const auto first_snapshot = TetrionSnapshot{ first.core_information(), step };
+        const auto second_snapshot = TetrionSnapshot{ second.core_information(), step };
+
+        const auto result = first_snapshot.compare_to(second_snapshot);
+        EXPECT_TRUE(result.has_value()) << result.error();
+    }
+
+} // namespace
+
+
+TEST(RollbackSession, MatchesTheSimulationWithoutLatency) {
+    // every remote frame arrives before its step is simulated, so there is nothing to roll back
+    rollback::RollbackSession reference{ players(), 0 };
+    const auto remote_script = script(1);
+
+    for (SimulationStep step = 1; step <= num_steps; ++step) {
+        rollback::InputFrame remote_frame{ .tetrion_index = 1, .simulation_step_index = step, .events = {} };
+        for (const auto& [event_step, event] : remote_script) {
+            if (event_step == step) {
+                remote_frame.events.push_back(event);
+            }
+        }
+
+        ASSERT_TRUE(reference.add_remote_frame(remote_frame).has_value());
+        add_local_events(reference);
+        ASSERT_TRUE(reference.advance().has_value());
+    }
+
+    ASSERT_EQ(reference.num_rollbacks(), 0);
+
+    rollback::LoopbackLink link{ { .latency_ticks = 4, .jitter_ticks = 3, .seed = 7 } };
+    std::array<rollback::RollbackSession, 2> sessions{
+        rollback::RollbackSession{ players(), 0 },
+        rollback::RollbackSession{ players(), 1 },
+    };
+    std::array<rollback::Transport*, 2> transports{ &link.first(), &link.second() };
+
+    while (sessions.at(0).confirmed_simulation_step_index() < num_steps
+           or sessions.at(1).confirmed_simulation_step_index() < num_steps) {
+        link.tick();
+
+        for (usize index = 0; index < sessions.size(); ++index) {
+            auto& session = sessions.at(index);
+            receive_all(session, *transports.at(index));
+
+            if (session.simulation_step_index() >= num_steps or not session.can_advance()) {
+                continue;
+            }
+
+            add_local_events(session);
+            if (const auto frame = session.advance(); frame.has_value()) {
+                transports.at(index)->send(frame.value());
+            }
+        }
+    }
+
+    for (auto& session : sessions) {
+        session.apply_pending_rollback();
+        EXPECT_GT(session.num_rollbacks(), 0);
+
+        for (u8 tetrion_index = 0; tetrion_index < 2; ++tetrion_index) {
+            expect_same_state(session.tetrion(tetrion_index), reference.tetrion(tetrion_index), num_steps);
+        }
+    }
+}
+
+TEST(RollbackSession, WaitsForFramesOutsideOfTheHistory) {
+    rollback::RollbackSession session{ players(), 0, 8 };
+
+    for (SimulationStep step = 1; step <= 8; ++step) {
+        ASSERT_TRUE(session.advance().has_value());
+    }
+
+    ASSERT_FALSE(session.can_advance());
+    ASSERT_FALSE(session.advance().has_value());
+
+    ASSERT_TRUE(session
+                        .add_remote_frame(rollback::InputFrame{
+                                .tetrion_index = 1, .simulation_step_index = 1, .events = { InputEvent::HoldPressed } })
+                        .has_value());
+
+    ASSERT_EQ(session.confirmed_simulation_step_index(), 1);
+    ASSERT_TRUE(session.advance().has_value());
+    ASSERT_EQ(session.num_rollbacks(), 1);
+}
+
+TEST(RollbackSession, RejectsInvalidFrames) {
+    rollback::RollbackSession session{ players(), 0, 8 };
+
+    const auto frame = [](u8 tetrion_index, SimulationStep simulation_step_index) {
+        return rollback::InputFrame{ .tetrion_index = tetrion_index,
+                                     .simulation_step_index = simulation_step_index,
+                                     .events = {} };
+    };
+
+    // the local tetrion
+    ASSERT_FALSE(session.add_remote_frame(frame(0, 1)).has_value());
+    ASSERT_FALSE(session.add_remote_frame(frame(2, 1)).has_value());
+    // too far ahead
+    ASSERT_FALSE(session.add_remote_frame(frame(1, 9)).has_value());
+}
+
+TEST(LoopbackLink, DeliversAfterTheLatency) {
+    rollback::LoopbackLink link{ { .latency_ticks = 2, .jitter_ticks = 0, .seed = 0 } };
+
+    const auto frame = rollback::InputFrame{ .tetrion_index = 0, .simulation_step_index = 1, .events = {} };
+    link.first().send(frame);
+
+    ASSERT_FALSE(link.second().receive().has_value());
+    link.tick();
+    ASSERT_FALSE(link.second().receive().has_value());
+    link.tick();
+
+    ASSERT_EQ(link.second().receive(), frame);
+    ASSERT_FALSE(link.second().receive().has_value());
+    ASSERT_FALSE(link.first().receive().has_value());
+}
@@ -0,0 +1,343 @@
+#include "graphics/renderer.hpp"
+#include "graphics/window.hpp"
+#include "input/input.hpp"
+#include "manager/service_provider.hpp"
+#include "ui/layouts/scroll_layout.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+
+namespace {
+
+    // every row registers itself, so that the tests can see, which widgets the layout created and destroyed
+    struct Rows {
+        u32 created{ 0 };
+        u32 destroyed{ 0 };
+        std::unordered_map<u32, const ui::Focusable*> alive;
+
+        [[nodiscard]] bool is_alive(u32 id) const {
+            return alive.contains(id);
+        }
+
+        [[nodiscard]] std::vector<u32> focused_ids() const {
+            std::vector<u32> result{};
+            for (const auto& [id, focusable] : alive) {
+                if (focusable->has_focus()) {
+                    result.push_back(id);
+                }
+            }
+            return result;
+        }
+    };
+
+    struct Row final : public ui::Widget, public ui::Focusable {
+    private:
+        Rows* m_rows;
+
+    public:
+        Row(Rows* rows, u32 id, const ui::Layout& layout)
+            : ui::Widget{ layout, ui::WidgetType::Component, false },
+              ui::Focusable{ id },
+              m_rows{ rows } {
+            ++m_rows->created;
+            m_rows->alive.insert_or_assign(id, this);
+        }
+
+        Row(const Row&) = delete;
+        Row(Row&&) = delete;
+        Row& operator=(const Row&) = delete;
+        Row& operator=(Row&&) = delete;
+
+        ~Row() override {
+            ++m_rows->destroyed;
+            m_rows->alive.erase(focus_id());
+        }
+
+        void render(const ServiceProvider& /* service_provider */) const override { }
+
+        Widget::EventHandleResult handle_event(
+                const std::shared_ptr<input::InputManager>& /* input_manager */,
+                const SDL_Event& /* event */
+        ) override {
+            return false;
+        }
+    };
+
+    // a widget, that can't get the focus
+    struct Spacer final : public ui::Widget {
+        explicit Spacer(const ui::Layout& layout) : ui::Widget{ layout, ui::WidgetType::Component, false } { }
+
+        void render(const ServiceProvider& /* service_provider */) const override { }
+
+        Widget::EventHandleResult handle_event(
+                const std::shared_ptr<input::InputManager>& /* input_manager */,
+                const SDL_Event& /* event */
+        ) override {
+            return false;
+        }
+    };
+
+    [[noreturn]] void unavailable() {
+        throw std::runtime_error{ "not available in the scroll layout tests" };
+    }
+
+    // the layout only needs the window and the renderer
+    struct TestServiceProvider final : public ServiceProvider {
+    private:
+        std::shared_ptr<Window> m_window;
+        std::unique_ptr<Renderer> m_renderer;
+        std::shared_ptr<input::InputManager> m_input_manager;
+
+    public:
+        explicit TestServiceProvider(std::shared_ptr<Window> window)
+            : m_window{ std::move(window) },
+              m_renderer{ std::make_unique<Renderer>(*m_window, Renderer::VSync::Disabled) },
+              m_input_manager{ std::make_shared<input::InputManager>(m_window) } { }
+
+        [[nodiscard]] const std::shared_ptr<input::InputManager>& shared_input_manager() const {
+            return m_input_manager;
+        }
+
+        [[nodiscard]] CommandLineArguments& command_line_arguments() override {
+            unavailable();
+        }
+        [[nodiscard]] const CommandLineArguments& command_line_arguments() const override {
+            unavailable();
+        }
+        [[nodiscard]] SettingsManager& settings_manager() override {
+            unavailable();
+        }
+        [[nodiscard]] const SettingsManager& settings_manager() const override {
+            unavailable();
+        }
+        [[nodiscard]] MusicManager& music_manager() override {
+            unavailable();
+        }
+        [[nodiscard]] const MusicManager& music_manager() const override {
+            unavailable();
+        }
+        [[nodiscard]] const Renderer& renderer() const override {
+            return *m_renderer;
+        }
+        [[nodiscard]] FontManager& font_manager() override {
+            unavailable();
+        }
+        [[nodiscard]] const FontManager& font_manager() const override {
+            unavailable();
+        }
+        [[nodiscard]] EventDispatcher& event_dispatcher() override {
+            unavailable();
+        }
+        [[nodiscard]] const EventDispatcher& event_dispatcher() const override {
+            unavailable();
+        }
+        [[nodiscard]] const Window& window() const override {
+            return *m_window;
+        }
+        [[nodiscard]] Window& window() override {
+            return *m_window;
+        }
+        [[nodiscard]] input::InputManager& input_manager() override {
+            return *m_input_manager;
+        }
+        [[nodiscard]] const input::InputManager& input_manager() const override {
+            return *m_input_manager;
+        }
+
+#if defined(_HAVE_DISCORD_SDK) && !defined(_OOPETRIS_RECORDING_UTILITY)
+        [[nodiscard]] std::optional<DiscordInstance>& discord_instance() override {
+            unavailable();
+        }
+        [[nodiscard]] const std::optional<DiscordInstance>& discord_instance() const override {
+            unavailable();
+        }
+#endif
+    };
+
+    // the layout is as large as the window, without margins, so 10 rows (210 px with the gap) are created around the viewport
+    // and 15 are kept, since the widgets one viewport height below are created and two viewport heights below are kept
+    constexpr u32 window_size = 1000;
+    constexpr u32 row_height = 200;
+    constexpr u32 created_rows = 10;
+    constexpr u32 kept_rows = 15;
+
+    class ScrollLayoutTest : public ::testing::Test {
+    protected:
+        Rows m_rows;
+        std::unique_ptr<TestServiceProvider> m_service_provider;
+        std::unique_ptr<ui::ScrollLayout> m_layout;
+
+        void SetUp() override {
+            SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+            SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+            ASSERT_EQ(SDL_InitSubSystem(SDL_INIT_VIDEO), 0) << SDL_GetError();
+
+            auto window =
+                    std::make_shared<Window>("scroll layout test", WindowPosition::Centered, window_size, window_size);
+            m_service_provider = std::make_unique<TestServiceProvider>(std::move(window));
+            m_layout = std::make_unique<ui::ScrollLayout>(
+                    m_service_provider.get(), 0, ui::AbsolutMargin{ 10 }, std::pair<double, double>{ 0.0, 0.0 },
+                    ui::FullScreenLayout{ m_service_provider->window() }
+            );
+        }
+
+        void TearDown() override {
+            m_layout = nullptr;
+            m_service_provider = nullptr;
+            SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        }
+
+        [[nodiscard]] ui::ScrollLayout::WidgetFactory row(u32 id) {
+            return [this, id](const ui::Layout& layout) { return std::make_unique<Row>(&m_rows, id, layout); };
+        }
+
+        void insert_rows(u32 count) {
+            for (u32 id = 0; id < count; ++id) {
+                m_layout->insert(id, ui::AbsolutItemSize{ row_height }, row(id));
+            }
+        }
+
+        void press(SDL_Keycode key) {
+            SDL_Event event{};
+            event.type = SDL_KEYDOWN;
+            event.key.keysym.sym = key;
+            std::ignore = m_layout->handle_event(m_service_provider->shared_input_manager(), event);
+        }
+    };
+
+} // namespace
+
+
+TEST_F(ScrollLayoutTest, OnlyCreatesTheWidgetsNearTheViewport) {
+    insert_rows(1000);
+
+    EXPECT_EQ(m_layout->widget_count(), 1000U);
+    EXPECT_EQ(m_rows.created, created_rows);
+    EXPECT_EQ(m_rows.destroyed, 0U);
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 0 });
+
+    // the new first row is visible, the last created one is moved down, but still kept
+    m_layout->insert(0, ui::AbsolutItemSize{ row_height }, row(1000));
+
+    EXPECT_EQ(m_rows.created, created_rows + 1);
+    EXPECT_EQ(m_rows.destroyed, 0U);
+    EXPECT_TRUE(m_rows.is_alive(1000));
+    EXPECT_TRUE(m_rows.is_alive(created_rows - 1));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 0 });
+}
+
+TEST_F(ScrollLayoutTest, DestroysAndRecreatesWidgetsWhileScrolling) {
+    insert_rows(1000);
+
+    for (u32 step = 0; step < 100; ++step) {
+        press(SDLK_DOWN);
+        ASSERT_EQ(m_rows.focused_ids(), std::vector<u32>{ step + 1 });
+        ASSERT_LE(m_rows.alive.size(), kept_rows + created_rows);
+    }
+
+    EXPECT_FALSE(m_rows.is_alive(0));
+    EXPECT_GT(m_rows.destroyed, 0U);
+    EXPECT_EQ(m_rows.created - m_rows.destroyed, m_rows.alive.size());
+
+    const auto created_before = m_rows.created;
+
+    for (u32 step = 100; step > 0; --step) {
+        press(SDLK_UP);
+        ASSERT_EQ(m_rows.focused_ids(), std::vector<u32>{ step - 1 });
+        ASSERT_LE(m_rows.alive.size(), kept_rows + created_rows);
+    }
+
+    EXPECT_TRUE(m_rows.is_alive(0));
+    EXPECT_FALSE(m_rows.is_alive(100));
+    EXPECT_GT(m_rows.created, created_before);
+    EXPECT_EQ(m_rows.created - m_rows.destroyed, m_rows.alive.size());
+}
+
+TEST_F(ScrollLayoutTest, KeepsTheFocusedWidgetAliveOffScreen) {
+    insert_rows(100);
+
+    // the focused first row is pushed far below the viewport
+    for (u32 id = 1000; id < 1020; ++id) {
+        m_layout->insert(0, ui::AbsolutItemSize{ row_height }, row(id));
+    }
+
+    EXPECT_TRUE(m_rows.is_alive(0));
+    EXPECT_FALSE(m_rows.is_alive(1));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 0 });
+
+    // removing rows before it keeps track of it, the rows around it are created again, when it gets near the viewport
+    for (u32 index = 0; index < 20; ++index) {
+        m_layout->remove(0);
+    }
+
+    EXPECT_TRUE(m_rows.is_alive(0));
+    EXPECT_TRUE(m_rows.is_alive(1));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 0 });
+
+    // when it loses the focus and the viewport is far away from it, it's destroyed
+    for (u32 id = 1000; id < 1020; ++id) {
+        m_layout->insert(0, ui::AbsolutItemSize{ row_height }, row(id));
+    }
+    ASSERT_TRUE(m_rows.is_alive(0));
+
+    // the focus moves up through the rows, that exist, the view follows it to the first row
+    for (u32 step = 0; step < 20 and m_rows.focused_ids() != std::vector<u32>{ 1019 }; ++step) {
+        press(SDLK_UP);
+        ASSERT_EQ(m_rows.focused_ids().size(), 1U);
+    }
+
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 1019 });
+    EXPECT_FALSE(m_rows.is_alive(0));
+    EXPECT_EQ(m_rows.created - m_rows.destroyed, m_rows.alive.size());
+}
+
+TEST_F(ScrollLayoutTest, HandsTheFocusOverOnRemove) {
+    insert_rows(3);
+
+    m_layout->remove(0);
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 1 });
+    EXPECT_FALSE(m_rows.is_alive(0));
+
+    // removing the focused last row moves the focus to the remaining one
+    press(SDLK_DOWN);
+    ASSERT_EQ(m_rows.focused_ids(), std::vector<u32>{ 2 });
+    m_layout->remove(1);
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 1 });
+
+    m_layout->remove(0);
+    EXPECT_TRUE(m_rows.focused_ids().empty());
+    EXPECT_EQ(m_layout->widget_count(), 0U);
+
+    // a new row gets the focus again
+    m_layout->insert(0, ui::AbsolutItemSize{ row_height }, row(10));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 10 });
+}
+
+TEST_F(ScrollLayoutTest, HandsTheFocusOverOnReplace) {
+    insert_rows(3);
+
+    // an unfocused row is recreated, the focus stays
+    m_layout->replace(1, ui::AbsolutItemSize{ row_height }, row(11));
+    EXPECT_FALSE(m_rows.is_alive(1));
+    EXPECT_TRUE(m_rows.is_alive(11));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 0 });
+
+    // the new widget of the focused row takes the focus over
+    m_layout->replace(0, ui::AbsolutItemSize{ row_height }, row(10));
+    EXPECT_FALSE(m_rows.is_alive(0));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 10 });
+
+    // a widget, that can't be focused, gives it to the next row
+    m_layout->replace(0, ui::AbsolutItemSize{ row_height }, [](const ui::Layout& layout) {
+        return std::make_unique<Spacer>(layout);
+    });
+    EXPECT_FALSE(m_rows.is_alive(10));
+    EXPECT_EQ(m_rows.focused_ids(), std::vector<u32>{ 11 });
+
+    EXPECT_EQ(m_rows.created - m_rows.destroyed, m_rows.alive.size());
+}
@@ -0,0 +1,57 @@
+#include "helper/spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+
+TEST(SpscQueue, PopFromEmptyQueue) {
+    helper::SpscQueue<int, 4> queue{};
+
+    ASSERT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(SpscQueue, KeepsTheOrderAndRejectsWhenFull) {
+    helper::SpscQueue<int, 4> queue{};
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+    ASSERT_FALSE(queue.try_push(4));
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(queue.try_pop(), i);
+    }
+    ASSERT_FALSE(queue.try_pop().has_value());
+
+    // the indices wrapped around the slots
+    ASSERT_TRUE(queue.try_push(5));
+    ASSERT_EQ(queue.try_pop(), 5);
+}
+
+TEST(SpscQueue, TransfersAllValuesAcrossThreads) {
+    helper::SpscQueue<int, 16> queue{};
+
+    constexpr int value_count = 100000;
+
+    std::thread producer{ [&queue] {
+        for (int i = 0; i < value_count;) {
+            if (queue.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    int expected = 0;
+    while (expected < value_count) {
+        if (const auto value = queue.try_pop(); value.has_value()) {
+            ASSERT_EQ(value.value(), expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+}
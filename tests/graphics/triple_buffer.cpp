@@ -0,0 +1,48 @@
+#include "helper/triple_buffer.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+
+TEST(TripleBuffer, ConsumeWithoutPublish) {
+    helper::TripleBuffer<int> buffer{};
+
+    ASSERT_FALSE(buffer.consume());
+}
+
+TEST(TripleBuffer, ConsumeGetsLatestValue) {
+    helper::TripleBuffer<int> buffer{};
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+
+    ASSERT_TRUE(buffer.consume());
+    ASSERT_EQ(buffer.front(), 2);
+    ASSERT_FALSE(buffer.consume());
+    ASSERT_EQ(buffer.front(), 2);
+}
+
+TEST(TripleBuffer, ValuesAreMonotonicAcrossThreads) {
+    helper::TripleBuffer<int> buffer{};
+
+    constexpr int last_value = 100000;
+
+    std::thread producer{ [&buffer] {
+        for (int i = 1; i <= last_value; ++i) {
+            buffer.back() = i;
+            buffer.publish();
+        }
+    } };
+
+    int previous = 0;
+    while (previous != last_value) {
+        if (buffer.consume()) {
+            EXPECT_GE(buffer.front(), previous);
+            previous = buffer.front();
+        }
+    }
+
+    producer.join();
+}
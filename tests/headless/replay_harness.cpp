@@ -0,0 +1,253 @@
+// drives the real Application scene stack without a display or audio device, by replaying recordings through ReplayGame
+// the games use manual clocks, that are advanced every frame, so the replay runs as fast as possible and is deterministic
+// the per frame update and render costs are printed and optionally written as JSON, so that regressions can be compared between builds
+
+#include <core/helper/types.hpp>
+
+#include "application.hpp"
+#include "helper/clock_source.hpp"
+#include "scenes/replay_game/replay_game.hpp"
+#include "ui/layout.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <argparse/argparse.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // the key is pressed in the given frame and released in the next one
+    struct ScriptedKey {
+        u64 frame;
+        SDL_Keycode key;
+    };
+
+    struct Options {
+        std::vector<std::filesystem::path> recordings;
+        u64 steps_per_frame;
+        u64 max_frames;
+        std::vector<ScriptedKey> script;
+        std::optional<std::filesystem::path> report_path;
+    };
+
+    struct FrameCost {
+        std::chrono::nanoseconds update;
+        std::chrono::nanoseconds render;
+    };
+
+    [[nodiscard]] Options parse_options(int argc, char** argv) {
+        argparse::ArgumentParser parser{ "oopetris_headless_replay" };
+        parser.add_argument("recordings").help("the recordings to replay").nargs(argparse::nargs_pattern::at_least_one);
+        parser.add_argument("--steps-per-frame")
+                .help("the number of simulation steps per rendered frame")
+                .scan<'i', u64>()
+                .default_value(u64{ 4 });
+        parser.add_argument("--max-frames")
+                .help("fail, if a replay didn't finish after this many frames")
+                .scan<'i', u64>()
+                .default_value(u64{ 1'000'000 });
+        parser.add_argument("--press")
+                .help("press a key in a frame, e.g. '100:Escape', the key names are the ones of SDL_GetKeyFromName")
+                .append();
+        parser.add_argument("--report").help("write the per frame costs of every replay as JSON to this file");
+
+        parser.parse_args(argc, argv);
+
+        Options options{ .recordings = {},
+                         .steps_per_frame = std::max<u64>(parser.get<u64>("--steps-per-frame"), 1),
+                         .max_frames = parser.get<u64>("--max-frames"),
+                         .script = {},
+                         .report_path = std::nullopt };
+
+        for (const auto& recording : parser.get<std::vector<std::string>>("recordings")) {
+            options.recordings.emplace_back(recording);
+        }
+
+        const auto presses = parser.present<std::vector<std::string>>("--press").value_or(std::vector<std::string>{});
+        for (const auto& press : presses) {
+            const auto separator = press.find(':');
+            if (separator == std::string::npos) {
+                throw std::runtime_error("invalid value for --press, expected <frame>:<key>: " + press);
+            }
+
+            const auto key = SDL_GetKeyFromName(press.substr(separator + 1).c_str());
+            if (key == SDLK_UNKNOWN) {
+                throw std::runtime_error("unknown key in --press: " + press);
+            }
+
+            options.script.push_back(ScriptedKey{ .frame = std::stoull(press.substr(0, separator)), .key = key });
+        }
+
+        if (auto path = parser.present("--report")) {
+            options.report_path = *path;
+        }
+
+        return options;
+    }
+
+    // the events go through the SDL event queue, so that they are dispatched like real input
+    void push_scripted_events(const std::vector<ScriptedKey>& script, u64 frame) {
+        for (const auto& [key_frame, key] : script) {
+            if (key_frame != frame and key_frame + 1 != frame) {
+                continue;
+            }
+
+            const auto is_press = key_frame == frame;
+
+            SDL_Event event{};
+            event.type = is_press ? SDL_KEYDOWN : SDL_KEYUP;
+            event.key.state = is_press ? SDL_PRESSED : SDL_RELEASED;
+            event.key.keysym.sym = key;
+            event.key.keysym.scancode = SDL_GetScancodeFromKey(key);
+            event.key.timestamp = SDL_GetTicks();
+
+            if (SDL_PushEvent(&event) < 0) {
+                throw std::runtime_error(std::string{ "unable to push scripted event: " } + SDL_GetError());
+            }
+        }
+    }
+
+    [[nodiscard]] double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+
+        std::ranges::sort(values);
+        const auto index = static_cast<usize>(fraction * static_cast<double>(values.size() - 1));
+        return values.at(index);
+    }
+
+    [[nodiscard]] nlohmann::json
+    statistics(const std::vector<FrameCost>& costs, std::chrono::nanoseconds FrameCost::*member) {
+        std::vector<double> values{};
+        values.reserve(costs.size());
+        for (const auto& cost : costs) {
+            values.push_back(std::chrono::duration<double, std::milli>(cost.*member).count());
+        }
+
+        const auto sum = std::accumulate(values.begin(), values.end(), 0.0);
+
+        return nlohmann::json{
+            { "mean_ms", values.empty() ? 0.0 : sum / static_cast<double>(values.size()) },
+            {  "p50_ms",                                          percentile(values, 0.5) },
+            {  "p99_ms",                                         percentile(values, 0.99) },
+            {  "max_ms",                                          percentile(values, 1.0) },
+        };
+    }
+
+    // every recording gets its own application, so that the scenes of earlier replays aren't rendered
+    [[nodiscard]] nlohmann::json replay(const std::filesystem::path& recording, const Options& options) {
+        constexpr int width = 1280;
+        constexpr int height = 720;
+        auto window = std::make_shared<Window>("oopetris headless", WindowPosition::Centered, width, height);
+
+        // silent, so that no audio device is needed
+        CommandLineArguments arguments{ std::nullopt, std::nullopt, 0, true };
+        // the clocks are advanced by exactly the given steps per frame, so all of them have to be simulated in that frame
+        arguments.max_catch_up_steps = 0;
+
+        Application application{ std::move(window), std::move(arguments) };
+        application.event_dispatcher().register_listener(&application);
+
+        std::vector<ManualClock*> clocks{};
+
+        // the clocks are owned by the games, which live as long as the scene, so the raw pointers stay valid
+        const ClockFactory clock_factory = [&clocks](u32 /* simulation_frequency */) {
+            auto clock = std::make_unique<ManualClock>();
+            clocks.push_back(clock.get());
+            return clock;
+        };
+
+        auto scene = std::make_unique<scenes::ReplayGame>(
+                &application, ui::FullScreenLayout{ application.window() }, recording, clock_factory
+        );
+        const auto* const replay_game = scene.get();
+        application.push_scene(std::move(scene));
+
+        std::vector<FrameCost> costs{};
+        u64 frame = 0;
+
+        for (; frame < options.max_frames and not replay_game->is_finished(); ++frame) {
+            push_scripted_events(options.script, frame);
+            application.event_dispatcher().dispatch_pending_events();
+
+            for (auto* clock : clocks) {
+                clock->advance(options.steps_per_frame);
+            }
+
+            const auto update_start = Clock::now();
+            application.update();
+            const auto render_start = Clock::now();
+            application.render();
+            application.renderer().present();
+            const auto render_end = Clock::now();
+
+            costs.push_back(FrameCost{ .update = render_start - update_start, .render = render_end - render_start });
+        }
+
+        const auto finished = replay_game->is_finished();
+
+        auto result = nlohmann::json{
+            { "recording",                       recording.string() },
+            {  "finished",                                 finished },
+            {    "frames",                                    frame },
+            {     "steps",        frame * options.steps_per_frame },
+            {    "update",   statistics(costs, &FrameCost::update) },
+            {    "render",   statistics(costs, &FrameCost::render) },
+        };
+
+        std::cerr << fmt::format(
+                "{}: {} frames, update p50 {:.3f} ms p99 {:.3f} ms, render p50 {:.3f} ms p99 {:.3f} ms{}\n",
+                recording.string(), frame, result["update"]["p50_ms"].get<double>(),
+                result["update"]["p99_ms"].get<double>(), result["render"]["p50_ms"].get<double>(),
+                result["render"]["p99_ms"].get<double>(), finished ? "" : " (NOT FINISHED)"
+        );
+
+        return result;
+    }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    try {
+        const auto options = parse_options(argc, argv);
+
+        // this has to be set before SDL is initialized, hints with normal priority don't override environment variables, so e.g. SDL_VIDEODRIVER can still be set to watch the replay
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+
+        bool all_finished = true;
+        auto results = nlohmann::json::array();
+
+        for (const auto& recording : options.recordings) {
+            auto result = replay(recording, options);
+            all_finished = all_finished and result["finished"].get<bool>();
+            results.push_back(std::move(result));
+        }
+
+        if (options.report_path.has_value()) {
+            std::ofstream report{ options.report_path.value() };
+            report << nlohmann::json{ { "replays", results } }.dump(4) << "\n";
+        }
+
+        return all_finished ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception& error) {
+        std::cerr << "error: " << error.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,135 @@
+// packs the assets folder into a single archive, that the game memory maps at startup (see src/helper/asset_archive.hpp)
+// this is a native build tool, so it only uses the standard library and header only core files
+//
+// usage: pack_assets <assets folder> <output file> <depfile> [excluded relative path]...
+
+#include <core/helper/utils.hpp>
+
+#include "helper/asset_archive_format.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct File {
+        std::filesystem::path path;
+        asset_archive::IndexEntry entry;
+    };
+
+    [[nodiscard]] bool is_excluded(const std::string& relative_path, const std::vector<std::string>& excluded) {
+        return std::ranges::any_of(excluded, [&relative_path](const std::string& exclude) {
+            return relative_path == exclude or relative_path.starts_with(exclude + "/");
+        });
+    }
+
+    // make style, spaces have to be escaped
+    [[nodiscard]] std::string escape_for_depfile(const std::string& path) {
+        std::string result{};
+        for (const auto character : path) {
+            if (character == ' ' or character == '#') {
+                result += '\\';
+            }
+            result += character;
+        }
+        return result;
+    }
+
+    void write_archive(const std::filesystem::path& output, const std::vector<File>& files) {
+        std::vector<asset_archive::IndexEntry> entries{};
+        entries.reserve(files.size());
+        for (const auto& file : files) {
+            entries.push_back(file.entry);
+        }
+
+        std::ofstream stream{ output, std::ios::out | std::ios::binary | std::ios::trunc };
+        if (not stream) {
+            throw std::runtime_error("unable to open output file: " + output.string());
+        }
+
+        asset_archive::write_index(stream, entries);
+
+        std::vector<char> buffer{};
+        for (usize i = 0; i < files.size(); ++i) {
+            const auto& file = files.at(i);
+            const auto& entry = entries.at(i);
+            const auto padding = entry.offset - static_cast<u64>(stream.tellp());
+            buffer.assign(padding, '\0');
+            stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+            std::ifstream input{ file.path, std::ios::in | std::ios::binary };
+            buffer.resize(entry.size);
+            input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (not input) {
+                throw std::runtime_error("unable to read file: " + file.path.string());
+            }
+            stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        if (not stream) {
+            throw std::runtime_error("unable to write output file: " + output.string());
+        }
+    }
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    const std::vector<std::string> arguments{ argv, argv + argc };
+
+    if (arguments.size() < 4) {
+        std::cerr << "usage: " << arguments.at(0) << " <assets folder> <output file> <depfile> [excluded path]...\n";
+        return 1;
+    }
+
+    try {
+        const std::filesystem::path assets_folder{ arguments.at(1) };
+        const std::filesystem::path output{ arguments.at(2) };
+        const std::filesystem::path depfile{ arguments.at(3) };
+        const std::vector<std::string> excluded{ arguments.begin() + 4, arguments.end() };
+
+        std::vector<File> files{};
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{ assets_folder }) {
+            if (not entry.is_regular_file()) {
+                continue;
+            }
+
+            auto relative_path = entry.path().lexically_relative(assets_folder).generic_string();
+            if (is_excluded(relative_path, excluded)) {
+                continue;
+            }
+
+            files.push_back(File{
+                    .path = entry.path(),
+                    .entry = { .path = std::move(relative_path), .size = entry.file_size(), .offset = 0 },
+            });
+        }
+
+        // sorted, so that the output is reproducible
+        std::ranges::sort(files, [](const File& first, const File& second) {
+            return first.entry.path < second.entry.path;
+        });
+
+        write_archive(output, files);
+
+        std::ofstream depfile_stream{ depfile, std::ios::out | std::ios::trunc };
+        depfile_stream << escape_for_depfile(output.string()) << ":";
+        for (const auto& file : files) {
+            depfile_stream << " \\\n  " << escape_for_depfile(file.path.string());
+        }
+        depfile_stream << "\n";
+
+        std::cout << "packed " << files.size() << " files into " << output.string() << "\n";
+    } catch (const std::exception& error) {
+        std::cerr << "error: " << error.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}